@@ -2470,14 +2470,8 @@ static void codegenPartTwo() {
         const char* filename = NULL;
         filename = generateFileName(fileNameHashMap, filename, currentModule->name);
         if(currentModule->modTag == MOD_USER) {
-          fileinfo modulefile;
-          openCFile(&modulefile, filename, "c");
-          int modulePathLen = strlen(astr(modulefile.pathname));
-          char path[FILENAME_MAX];
-          strncpy(path, astr(modulefile.pathname), modulePathLen-2);
-          path[modulePathLen-2]='\0';
-          userFileName.push_back(astr(path));
-          closeCFile(&modulefile);
+          // Only the path is needed here; the file is written below.
+          userFileName.push_back(genIntermediateFilename(filename));
         }
       }
     }
@@ -2593,6 +2587,10 @@ void codegen() {
 
   if (localeUsesGPU()) {
 
+    if (llvmCodegenThreads > 1)
+      USR_WARN("--llvm-codegen-threads does not apply to GPU kernels, "
+               "which are generated on a single thread");
+
     pid_t pid = fork();
 
     if (pid == 0) {
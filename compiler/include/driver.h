@@ -55,6 +55,7 @@ extern bool fNoDivZeroChecks;
 extern bool fMungeUserIdents;
 extern bool fEnableTaskTracking;
 extern bool fLLVMWideOpt;
+extern int llvmCodegenThreads;
 
 extern bool fAutoLocalAccess;
 extern bool fDynamicAutoLocalAccess;
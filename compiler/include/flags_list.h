@@ -37,6 +37,8 @@
 symbolFlag ( FLAG_AGG_MARKER, npr, "aggregation marker", ncm)
 symbolFlag ( FLAG_AGG_IN_STATIC_ONLY_CLONE, npr, "static only aggregation marker", " this aggreagation is happening in a static only forall clone")
 symbolFlag ( FLAG_AGG_IN_STATIC_AND_DYNAMIC_CLONE, npr, "static and dynamic aggregation marker", " this aggreagation is happening in a static and dynamic forall clone")
+symbolFlag ( FLAG_AGG_INDEPENDENT_STMT, npr, "independent aggregation marker", " this aggregation is not the last statement in the loop body or is an op= update, and has been shown to be independent of the statements that follow it")
+symbolFlag ( FLAG_AGG_COMBINED_READ, npr, "combined read aggregation marker", " the RHS of this aggregation candidate was moved from the initializer of a variable")
 symbolFlag ( FLAG_AGG_GENERATOR, ypr, "aggregator generator", " this function generates and returns an aggregator")
 
 // Indicates an array implementation class can alias other array implementations
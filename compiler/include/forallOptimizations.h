@@ -51,6 +51,19 @@ class AggregationCandidateInfo {
     Symbol *srcAggregator;   // remote rhs
     Symbol *dstAggregator;   // remote lhs
 
+    // name of the compound assignment (e.g. "+=") if the candidate is an
+    // update rather than a plain assignment, NULL otherwise
+    const char *updateOp;
+
+    // true if the candidate is not the last statement in the loop body, or is
+    // an update. Such candidates have been checked against the statements
+    // that follow them
+    bool independent;
+
+    // true if the RHS of the candidate was moved from the initializer of a
+    // variable that the candidate was the only use of
+    bool combinedRead;
+
     AggregationCandidateInfo(CallExpr *candidate, ForallStmt *forall);
 
     void addAggregators();
@@ -57,6 +57,7 @@
 #include "llvm/Analysis/TargetLibraryInfo.h"
 #include "llvm/Analysis/TargetTransformInfo.h"
 #include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/CodeGen/ParallelCG.h"
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/Verifier.h"
 #include "llvm/MC/SubtargetFeature.h"
@@ -69,6 +70,7 @@
 #include "llvm/Target/TargetMachine.h"
 #include "llvm/Transforms/IPO.h"
 #include "llvm/Transforms/IPO/PassManagerBuilder.h"
+#include "llvm/Transforms/Utils/Cloning.h"
 
 #if HAVE_LLVM_VER >= 90
 #include "llvm/Support/CodeGen.h"
@@ -2350,7 +2352,7 @@ void readExternC(void) {
   }
 
   // Close extern_c_file.
-  if( gAllExternCode.fptr ) closefile(&gAllExternCode);
+  if( gAllExternCode.fptr ) closeCFile(&gAllExternCode, false);
   // Close any extern files for any modules we had generated code for.
   module_set_iterator_t it;
   for( it = gModulesWithExternBlocks.begin();
@@ -2359,7 +2361,7 @@ void readExternC(void) {
     ModuleSymbol* module = *it;
     INT_ASSERT(module->extern_info);
     // Could put #ifndef/define/endif wrapper end here.
-    closefile(&module->extern_info->file);
+    closeCFile(&module->extern_info->file, false);
     // Now parse the extern C code for that module.
     runClang(module->extern_info->file.filename);
     // Now swap what went into the global layered value table
@@ -3381,6 +3383,69 @@ static std::string getLibraryOutputPath();
 static void moveGeneratedLibraryFile(const char* tmpbinname);
 static void moveResultFromTmp(const char* resultName, const char* tmpbinname);
 
+//
+// Emit the optimized module as --llvm-codegen-threads object files, the
+// first of which is moduleFilename.  As with LTO's parallel code
+// generation, the module is split into partitions that are each compiled
+// in their own LLVMContext by their own TargetMachine on a separate thread.
+// The names of the additional object files are added to partFilenames.
+//
+static void emitObjectFilesInParallel(const std::string& moduleFilename,
+                                      std::vector<std::string>& partFilenames)
+{
+  GenInfo* info = gGenInfo;
+  llvm::TargetMachine* tm = info->targetMachine;
+
+  std::vector<std::unique_ptr<llvm::raw_fd_ostream> > outputs;
+  std::vector<llvm::raw_pwrite_stream*> outputPtrs;
+
+  for (int i = 0; i < llvmCodegenThreads; i++) {
+    std::string filename = moduleFilename;
+    std::error_code error;
+
+    if (i > 0) {
+      filename = genIntermediateFilename(astr("chpl__module-", istr(i), ".o"));
+      partFilenames.push_back(filename);
+    }
+
+    outputs.emplace_back(new llvm::raw_fd_ostream(filename, error,
+                                                  llvm::sys::fs::F_None));
+    if (error || outputs.back()->has_error())
+      USR_FATAL("Could not open output file %s", filename.c_str());
+
+    outputPtrs.push_back(outputs.back().get());
+  }
+
+  auto tmFactory = [tm]() {
+    return std::unique_ptr<llvm::TargetMachine>(
+             tm->getTarget().createTargetMachine(tm->getTargetTriple().str(),
+                                                 tm->getTargetCPU(),
+                                                 tm->getTargetFeatureString(),
+                                                 tm->Options,
+                                                 tm->getRelocationModel(),
+                                                 tm->getCodeModel(),
+                                                 tm->getOptLevel()));
+  };
+
+  // info->module is owned by clang's code generator, but splitting
+  // consumes the module it is given, so split a copy of it.
+  std::unique_ptr<llvm::Module> copy = llvm::CloneModule(*info->module);
+
+#if HAVE_LLVM_VER >= 120
+  llvm::splitCodeGen(*copy, outputPtrs, {}, tmFactory,
+                     llvm::CGFT_ObjectFile);
+#elif HAVE_LLVM_VER >= 100
+  llvm::splitCodeGen(std::move(copy), outputPtrs, {}, tmFactory,
+                     llvm::CGFT_ObjectFile);
+#else
+  llvm::splitCodeGen(std::move(copy), outputPtrs, {}, tmFactory,
+                     llvm::TargetMachine::CGFT_ObjectFile);
+#endif
+
+  for (size_t i = 0; i < outputs.size(); i++)
+    outputs[i]->close();
+}
+
 void makeBinaryLLVM(void) {
 
   GenInfo* info = gGenInfo;
@@ -3389,6 +3454,7 @@ void makeBinaryLLVM(void) {
   INT_ASSERT(clangInfo);
 
   std::string moduleFilename;
+  std::vector<std::string> partFilenames;
   std::string preOptFilename;
   std::string opt1Filename;
   std::string opt2Filename;
@@ -3602,7 +3668,10 @@ void makeBinaryLLVM(void) {
 
     bool disableVerify = !developer;
 
-    if (gCodegenGPU == false) {
+    if (gCodegenGPU == false && llvmCodegenThreads > 1) {
+      emitObjectFilesInParallel(moduleFilename, partFilenames);
+
+    } else if (gCodegenGPU == false) {
       llvm::raw_fd_ostream outputOfile(moduleFilename, error, flags);
       if (error || outputOfile.has_error())
         USR_FATAL("Could not open output file %s", moduleFilename.c_str());
@@ -3788,7 +3857,9 @@ void makeBinaryLLVM(void) {
     useLinkCXX = ldOverride[0];
 
 
-  std::vector<std::string> dotOFiles;
+  // Any additional partitions from --llvm-codegen-threads are linked in
+  // along with the main module object file.
+  std::vector<std::string> dotOFiles(partFilenames);
 
   // Gather C flags for compiling C files.
   std::string cargs;
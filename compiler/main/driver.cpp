@@ -173,6 +173,9 @@ FILE* printPassesFile = NULL;
 // flag for llvmWideOpt
 bool fLLVMWideOpt = false;
 
+// number of partitions the LLVM module is split into for code generation
+int llvmCodegenThreads = 1;
+
 bool fWarnConstLoops = true;
 bool fWarnUnstable = false;
 
@@ -998,6 +1001,7 @@ static ArgumentDescription arg_desc[] = {
  {"", ' ', NULL, "LLVM Code Generation Options", NULL, NULL, NULL, NULL},
  {"llvm", ' ', NULL, "[Don't] use the LLVM code generator", "N", &fYesLlvmCodegen, "CHPL_LLVM_CODEGEN", setLlvmCodegen},
  {"llvm-wide-opt", ' ', NULL, "Enable [disable] LLVM wide pointer optimizations", "N", &fLLVMWideOpt, "CHPL_LLVM_WIDE_OPTS", NULL},
+ {"llvm-codegen-threads", ' ', "<threads>", "Number of threads used to emit object code with --llvm", "I", &llvmCodegenThreads, "CHPL_LLVM_CODEGEN_THREADS", NULL},
  {"mllvm", ' ', "<flags>", "LLVM flags (can be specified multiple times)", "S", NULL, "CHPL_MLLVM", setLLVMFlags},
 
  {"", ' ', NULL, "Compilation Trace Options", NULL, NULL, NULL, NULL},
@@ -1507,6 +1511,12 @@ static void checkLLVMCodeGen() {
   if (fLlvmCodegen)
     USR_FATAL("This compiler was built without LLVM support");
 #endif
+
+  if (llvmCodegenThreads < 1)
+    USR_FATAL("--llvm-codegen-threads must be at least 1");
+
+  if (llvmCodegenThreads > 1 && !fLlvmCodegen)
+    USR_WARN("--llvm-codegen-threads has no effect without --llvm");
 }
 
 static void checkTargetCpu() {
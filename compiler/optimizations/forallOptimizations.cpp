@@ -19,6 +19,9 @@
  */
 
 #include <algorithm>
+#include <cctype>
+#include <map>
+#include <set>
 
 #include "astutil.h"
 #include "build.h"
@@ -30,6 +33,7 @@
 #include "optimizations.h"
 #include "resolution.h"
 #include "stlUtil.h"
+#include "stringutil.h"
 #include "view.h"
 
 // This file contains analysis and transformation logic that need to happen
@@ -42,8 +46,11 @@
 // - automatic local access: Use `localAccess` instead of `this` for array
 //                           accesses that can be proven to be local
 //
-// - automatic aggregation: Use aggregation instead of regular assignments for
-//                          applicable last statements within `forall` bodies
+// - automatic aggregation: Use aggregation instead of regular assignments and
+//                          `op=` updates within `forall` bodies. The last
+//                          statements are always considered, other statements
+//                          are considered if they are independent of the
+//                          statements that follow them
 
 static int curLogDepth = 0;
 static void LOG_ALA(int depth, const char *msg, BaseAST *node);
@@ -100,13 +107,42 @@ static CallExpr *confirmAccess(CallExpr *call);
 static void symbolicFastFollowerAnalysis(ForallStmt *forall);
 
 static const char *getForallCloneTypeStr(Symbol *aggMarker);
-static CallExpr *getAggGenCallForChild(Expr *child, bool srcAggregation);
+static CallExpr *getAggGenCallForChild(Expr *child, bool srcAggregation,
+                                       const char *updateOp);
 static bool assignmentSuitableForAggregation(CallExpr *call, ForallStmt *forall);
-static void insertAggCandidate(CallExpr *call, ForallStmt *forall);
+static const char *getAssignmentRejectionReason(CallExpr *call,
+                                                ForallStmt *forall);
+static const char *getAggregatableUpdateOp(CallExpr *call);
+static bool updateSuitableForAggregation(CallExpr *call, ForallStmt *forall);
+static bool isAccessLikeExpr(Expr *expr);
+static void collectAggCandidateStmts(BlockStmt *block,
+                                     std::vector<Expr *> &lastStmts,
+                                     bool inNestedLoop,
+                                     std::vector<CallExpr *> &stmts);
+static void collectLaterStmts(Expr *stmt, ForallStmt *forall,
+                              std::vector<Expr *> &laterStmts);
+static bool stmtsAreIndependentOf(std::vector<Expr *> &stmts,
+                                  std::set<Symbol *> &syms,
+                                  ForallStmt *forall,
+                                  bool allowIndexReads,
+                                  std::string &reason);
+static bool candidateIsIndependentOfLaterStmts(CallExpr *call,
+                                               ForallStmt *forall);
+static void combineReadsWithLaterStores(ForallStmt *forall,
+                                        std::map<CallExpr *, DefExpr *> &combined);
+static void undoCombinedRead(CallExpr *store, DefExpr *def);
+static void insertAggCandidate(CallExpr *call, ForallStmt *forall,
+                               const char *updateOp, bool independent,
+                               bool combinedRead);
+static Expr *getAlignedIterandForTheYieldedSym(Symbol *sym,
+                                               ForallStmt *forall);
+static SymExpr *getYieldedArrayElementInAssignment(CallExpr *call,
+                                                   ForallStmt *forall,
+                                                   Expr *&maybeArrExpr);
 static bool handleYieldedArrayElementsInAssignment(CallExpr *call,
                                                    ForallStmt *forall);
 static void findAndUpdateMaybeAggAssign(CallExpr *call, bool confirmed);
-static CallExpr *findMaybeAggAssignInBlock(BlockStmt *block);
+static CallExpr *findMaybeAggAssignUsing(Expr *stmt, Symbol *tmpSym);
 static void removeAggregatorFromMaybeAggAssign(CallExpr *call, int argIndex);
 static void removeAggregatorFromFunction(Symbol *aggregator, FnSymbol *parent);
 static void removeAggregationFromRecursiveForallHelp(BlockStmt *block);
@@ -276,6 +312,14 @@ void cleanupRemainingAggCondStmts() {
                 INT_ASSERT(aggregatorToRemove != NULL);
                 INT_ASSERT(parentFn != NULL);
 
+                if (fReportAutoAggregation) {
+                  std::stringstream message;
+                  message << "Reverted aggregation: could not prove that the ";
+                  message << "assignment can be deferred ";
+                  message << getForallCloneTypeStr(condSymExpr->symbol());
+                  LOG_AA(0, message.str().c_str(), condSymExpr);
+                }
+
                 // put the nodes in the then block right before the conditional
                 for_alist(expr, condStmt->thenStmt->body) {
                   condStmt->insertBefore(expr->remove());
@@ -1437,26 +1481,76 @@ static void autoAggregation(ForallStmt *forall) {
 
   LOG_AA(0, "Start analyzing forall for automatic aggregation", forall);
 
+  // `var x = B[j]; A[i] = x;` is turned into `A[i] = B[j];` if that is the
+  // only use of `x`, so that the remote read can be aggregated. Stores that
+  // don't end up as aggregation candidates are turned back into what the user
+  // wrote at the end of this function
+  std::map<CallExpr *, DefExpr *> combinedReads;
+  combineReadsWithLaterStores(forall, combinedReads);
+
   std::vector<Expr *> lastStmts = getLastStmtsForForallUnorderedOps(forall);
 
-  for_vector(Expr, lastStmt, lastStmts) {
-    if (CallExpr *lastCall = toCallExpr(lastStmt)) {
-      if (lastCall->isNamedAstr(astrSassign)) {
-        // no need to do anything if it is array access
-        if (assignmentSuitableForAggregation(lastCall, forall)) {
-          LOG_AA(1, "Found an aggregation candidate", lastCall);
+  std::vector<CallExpr *> stmts;
+  collectAggCandidateStmts(forall->loopBody(), lastStmts,
+                           /*inNestedLoop=*/false, stmts);
+
+  for_vector(CallExpr, call, stmts) {
+    // the last statements can always be aggregated, anything else needs to be
+    // independent of what comes after it in the loop body
+    bool isLastStmt = (std::find(lastStmts.begin(), lastStmts.end(), call) !=
+                       lastStmts.end());
+
+    if (call->isNamedAstr(astrSassign)) {
+      Expr *maybeArrExpr = NULL;
+
+      // no need to do anything if it is array access
+      if (assignmentSuitableForAggregation(call, forall)) {
+        if (isLastStmt || candidateIsIndependentOfLaterStmts(call, forall)) {
+          LOG_AA(1, "Found an aggregation candidate", call);
+
+          bool combinedRead = (combinedReads.erase(call) > 0);
+          insertAggCandidate(call, forall, NULL, !isLastStmt, combinedRead);
+        }
+      }
+      // we need special handling if it is a symbol that is an array element
+      else if (getYieldedArrayElementInAssignment(call, forall,
+                                                  maybeArrExpr) != NULL) {
+        if (isLastStmt || candidateIsIndependentOfLaterStmts(call, forall)) {
+          handleYieldedArrayElementsInAssignment(call, forall);
+
+          LOG_AA(1, "Found an aggregation candidate", call);
 
-          insertAggCandidate(lastCall, forall);
+          bool combinedRead = (combinedReads.erase(call) > 0);
+          insertAggCandidate(call, forall, NULL, !isLastStmt, combinedRead);
         }
-        // we need special handling if it is a symbol that is an array element
-        else if (handleYieldedArrayElementsInAssignment(lastCall, forall)) {
-          LOG_AA(1, "Found an aggregation candidate", lastCall);
+      }
+      else if (const char *reason = getAssignmentRejectionReason(call,
+                                                                 forall)) {
+        std::stringstream message;
+        message << "Rejected aggregation candidate: " << reason;
+        LOG_AA(1, message.str().c_str(), call);
+      }
+    }
+    else if (const char *updateOp = getAggregatableUpdateOp(call)) {
+      if (updateSuitableForAggregation(call, forall)) {
+        if (isLastStmt || candidateIsIndependentOfLaterStmts(call, forall)) {
+          LOG_AA(1, "Found an aggregation candidate for an update", call);
 
-          insertAggCandidate(lastCall, forall);
+          // updates are always applied through an aggregator that does the
+          // read-modify-write on the locale that owns the element, which is
+          // not a plain assignment that the last statement analysis knows about
+          insertAggCandidate(call, forall, updateOp, /*independent=*/true,
+                             /*combinedRead=*/false);
         }
       }
     }
   }
+
+  for (std::map<CallExpr *, DefExpr *>::iterator it = combinedReads.begin();
+       it != combinedReads.end(); ++it) {
+    undoCombinedRead(it->first, it->second);
+  }
+
   LOG_AA(0, "End analyzing forall for automatic aggregation", forall);
   LOGLN_AA(forall);
 }
@@ -1470,9 +1564,13 @@ AggregationCandidateInfo::AggregationCandidateInfo(CallExpr *candidate,
   lhsLogicalChild(NULL),
   rhsLogicalChild(NULL),
   srcAggregator(NULL),
-  dstAggregator(NULL) { }
+  dstAggregator(NULL),
+  updateOp(NULL),
+  independent(false),
+  combinedRead(false) { }
 
-static CondStmt *createAggCond(CallExpr *noOptAssign, Symbol *aggregator, SymExpr *aggMarkerSE) {
+static CondStmt *createAggCond(CallExpr *noOptAssign, Symbol *aggregator,
+                               SymExpr *aggMarkerSE, bool isUpdate) {
   INT_ASSERT(aggregator);
   INT_ASSERT(aggMarkerSE);
 
@@ -1485,7 +1583,7 @@ static CondStmt *createAggCond(CallExpr *noOptAssign, Symbol *aggregator, SymExp
   SET_LINENO(noOptAssign);
 
   // generate the aggregated call
-  Expr *callBase = buildDotExpr(aggregator, "copy");
+  Expr *callBase = buildDotExpr(aggregator, isUpdate ? "update" : "copy");
   CallExpr *aggCall = new CallExpr(callBase, lhsSE->copy(), rhsSE->copy());
 
   // create the conditional with regular assignment on the then block
@@ -1508,7 +1606,7 @@ static CondStmt *createAggCond(CallExpr *noOptAssign, Symbol *aggregator, SymExp
 // remove it when we use it, but we can also leave some untouched. This
 // function removes that argument if the primitive still has 3 arguments
 void AggregationCandidateInfo::removeSideEffectsFromPrimitive() {
-  INT_ASSERT(this->candidate->isNamed("="));
+  INT_ASSERT(this->candidate->isNamed("=") || this->updateOp != NULL);
 
   if (CallExpr *childCall = toCallExpr(this->candidate->get(1))) {
     if (childCall->isPrimitive(PRIM_MAYBE_LOCAL_ARR_ELEM)) {
@@ -1544,11 +1642,13 @@ void AggregationCandidateInfo::addAggregators() {
   }
 
   // we have a lhs that waits analysis or local, and a rhs that we can't know
-  // about
-  if (srcAggregator == NULL &&
+  // about. Updates have to be applied where the lhs lives, so they can only
+  // use destination aggregation
+  if (srcAggregator == NULL && updateOp == NULL &&
       (lhsLocalityInfo == PENDING || lhsLocalityInfo == LOCAL) &&
       rhsLogicalChild != NULL) {
-    if (CallExpr *genCall = getAggGenCallForChild(rhsLogicalChild, true)) {
+    if (CallExpr *genCall = getAggGenCallForChild(rhsLogicalChild, true,
+                                                  NULL)) {
       SET_LINENO(this->forall);
 
       UnresolvedSymExpr *aggTmp = new UnresolvedSymExpr("chpl_src_auto_agg");
@@ -1569,7 +1669,8 @@ void AggregationCandidateInfo::addAggregators() {
   if (dstAggregator == NULL &&
       (rhsLocalityInfo == PENDING || rhsLocalityInfo == LOCAL) &&
       lhsLogicalChild != NULL) {
-    if (CallExpr *genCall = getAggGenCallForChild(lhsLogicalChild, false)) {
+    if (CallExpr *genCall = getAggGenCallForChild(lhsLogicalChild, false,
+                                                  updateOp)) {
       SET_LINENO(this->forall);
 
       UnresolvedSymExpr *aggTmp = new UnresolvedSymExpr("chpl_dst_auto_agg");
@@ -1598,26 +1699,35 @@ static const char *getForallCloneTypeStr(Symbol *aggMarker) {
   return "";
 }
 
-static CallExpr *getAggGenCallForChild(Expr *child, bool srcAggregation) {
+// `updateOp` is non-NULL for destination aggregators that apply an update
+// like `+=` instead of copying the value
+static CallExpr *getAggGenCallForChild(Expr *child, bool srcAggregation,
+                                       const char *updateOp) {
   SET_LINENO(child);
 
+  CallExpr *genCall = NULL;
   if (CallExpr *childCall = toCallExpr(child)) {
     const char *aggFnName = srcAggregation ? "chpl_srcAggregatorFor" :
                                              "chpl_dstAggregatorFor";
     if (childCall->isPrimitive(PRIM_MAYBE_LOCAL_THIS)) {
       if (SymExpr *arrSymExpr = toSymExpr(childCall->get(1))) {
-        return new CallExpr(aggFnName, new SymExpr(arrSymExpr->symbol()));
+        genCall = new CallExpr(aggFnName, new SymExpr(arrSymExpr->symbol()));
       }
     }
     else if (childCall->isPrimitive(PRIM_MAYBE_LOCAL_ARR_ELEM)) {
-      return new CallExpr(aggFnName, childCall->get(2)->remove());
+      genCall = new CallExpr(aggFnName, childCall->get(2)->remove());
     }
     else if (SymExpr *arrSymExpr = toSymExpr(childCall->baseExpr)) {
-      return new CallExpr(aggFnName, new SymExpr(arrSymExpr->symbol()));
+      genCall = new CallExpr(aggFnName, new SymExpr(arrSymExpr->symbol()));
     }
   }
 
-  return NULL;
+  if (genCall != NULL && updateOp != NULL) {
+    INT_ASSERT(!srcAggregation);
+    genCall->insertAtTail(new SymExpr(new_StringSymbol(updateOp)));
+  }
+
+  return genCall;
 }
 
 // currently we want both sides to be calls, but we need to relax these to
@@ -1658,14 +1768,502 @@ static bool assignmentSuitableForAggregation(CallExpr *call, ForallStmt *forall)
   return false;
 }
 
+// Returns true if `expr` looks like an array access. This is used to decide
+// whether a statement that we can't aggregate is worth reporting
+static bool isAccessLikeExpr(Expr *expr) {
+  if (CallExpr *call = toCallExpr(expr)) {
+    if (call->isPrimitive(PRIM_MAYBE_LOCAL_THIS) ||
+        call->isPrimitive(PRIM_MAYBE_LOCAL_ARR_ELEM)) {
+      return true;
+    }
+    if (SymExpr *baseSE = toSymExpr(call->baseExpr)) {
+      return !isFnSymbol(baseSE->symbol());
+    }
+  }
+  return false;
+}
+
+static bool isLiteralOrParam(Expr *expr) {
+  if (SymExpr *se = toSymExpr(expr)) {
+    return se->symbol()->isImmediate() || se->symbol()->isParameter();
+  }
+  return false;
+}
+
+// Explains why an assignment that involves an array access can't be
+// aggregated. Returns NULL if the assignment doesn't look like something we
+// could aggregate in the first place.
+static const char *getAssignmentRejectionReason(CallExpr *call,
+                                                ForallStmt *forall) {
+  Expr *lhs = call->get(1);
+  Expr *rhs = call->get(2);
+
+  if (!isAccessLikeExpr(lhs) && !isAccessLikeExpr(rhs)) {
+    return NULL;
+  }
+
+  CallExpr *lhsCall = toCallExpr(lhs);
+  CallExpr *rhsCall = toCallExpr(rhs);
+
+  if (lhsCall == NULL) {
+    return "the LHS is not an array element";
+  }
+
+  bool lhsMaybeLocal = lhsCall->isPrimitive(PRIM_MAYBE_LOCAL_THIS);
+
+  if (rhsCall == NULL) {
+    if (!isLiteralOrParam(rhs)) {
+      return "the RHS is not a literal, a param or an array element";
+    }
+    if (lhsMaybeLocal) {
+      return "the LHS may be local and the RHS is a literal or a param";
+    }
+    return "the LHS is not an array access that can be aggregated";
+  }
+
+  bool rhsMaybeLocal = rhsCall->isPrimitive(PRIM_MAYBE_LOCAL_THIS);
+
+  if (lhsMaybeLocal && rhsMaybeLocal) {
+    return "both sides may be local";
+  }
+  if (!lhsMaybeLocal && !rhsMaybeLocal) {
+    return "neither side is known to be a local access";
+  }
+
+  CallExpr *otherCall = lhsMaybeLocal ? rhsCall : lhsCall;
+  if (!isAccessLikeExpr(otherCall)) {
+    return lhsMaybeLocal ? "the RHS is not an array element" :
+                           "the LHS is not an array element";
+  }
+
+  return "the nonlocal side is not an array access that can be aggregated";
+}
+
+// Compound assignments that we can apply through a destination aggregator.
+// The aggregator applies them with plain, non-atomic updates, so this doesn't
+// make racy updates to the same element safe.
+static const char *getAggregatableUpdateOp(CallExpr *call) {
+  static const char *updateOps[] = { "+=", "-=", "&=", "|=", "^=", NULL };
+
+  if (call->numActuals() == 2) {
+    for (int i = 0 ; updateOps[i] != NULL ; i++) {
+      if (call->isNamed(updateOps[i])) {
+        return astr(updateOps[i]);
+      }
+    }
+  }
+  return NULL;
+}
+
+// `A[j] op= x` can be aggregated if `A[j]` may be remote and `x` is known to be
+// local. In that case, the update is applied by the destination aggregator on
+// the locale that owns `A[j]`
+static bool updateSuitableForAggregation(CallExpr *call, ForallStmt *forall) {
+  CallExpr *lhsCall = toCallExpr(call->get(1));
+
+  // updates to things other than array elements are not candidates
+  if (lhsCall == NULL || !isAccessLikeExpr(lhsCall)) {
+    return false;
+  }
+
+  const char *reason = NULL;
+  if (lhsCall->isPrimitive(PRIM_MAYBE_LOCAL_THIS)) {
+    reason = "the LHS of the update may be local";
+  }
+  else if (getCallBaseSymIfSuitable(lhsCall, forall, /*checkArgs=*/false,
+                                    NULL) == NULL) {
+    reason = "the LHS of the update is not an array access that can be "
+             "aggregated";
+  }
+  else if (CallExpr *rhsCall = toCallExpr(call->get(2))) {
+    if (!rhsCall->isPrimitive(PRIM_MAYBE_LOCAL_THIS)) {
+      reason = "the RHS of the update is not known to be local";
+    }
+  }
+  else if (SymExpr *rhsSE = toSymExpr(call->get(2))) {
+    Symbol *rhsSym = rhsSE->symbol();
+
+    // variables declared in the loop body are on this locale, unless they
+    // refer to something else
+    bool rhsIsLocalVar = isVarSymbol(rhsSym) &&
+                         !rhsSym->hasFlag(FLAG_REF_VAR) &&
+                         !rhsSym->hasFlag(FLAG_INDEX_VAR) &&
+                         forall->loopBody()->contains(rhsSym->defPoint);
+
+    if (!isLiteralOrParam(rhsSE) && !rhsIsLocalVar) {
+      reason = "the RHS of the update is not known to be local";
+    }
+  }
+  else {
+    reason = "the RHS of the update is not known to be local";
+  }
+
+  if (reason != NULL) {
+    std::stringstream message;
+    message << "Rejected aggregation candidate: " << reason;
+    LOG_AA(1, message.str().c_str(), call);
+    return false;
+  }
+
+  return true;
+}
+
+// Collects the statements in the loop body that we consider for aggregation.
+// We look into conditionals and nested blocks. In nested loops, only the last
+// statements are considered as the other statements would run again in the
+// next iteration of the nested loop.
+static void collectAggCandidateStmts(BlockStmt *block,
+                                     std::vector<Expr *> &lastStmts,
+                                     bool inNestedLoop,
+                                     std::vector<CallExpr *> &stmts) {
+  for_alist(stmt, block->body) {
+    if (CallExpr *call = toCallExpr(stmt)) {
+      if (!inNestedLoop ||
+          std::find(lastStmts.begin(), lastStmts.end(), call) !=
+          lastStmts.end()) {
+        stmts.push_back(call);
+      }
+    }
+    else if (CondStmt *cond = toCondStmt(stmt)) {
+      collectAggCandidateStmts(cond->thenStmt, lastStmts, inNestedLoop, stmts);
+      if (cond->elseStmt != NULL) {
+        collectAggCandidateStmts(cond->elseStmt, lastStmts, inNestedLoop,
+                                 stmts);
+      }
+    }
+    else if (BlockStmt *nestedBlock = toBlockStmt(stmt)) {
+      if (nestedBlock->isRealBlockStmt()) {
+        collectAggCandidateStmts(nestedBlock, lastStmts,
+                                 inNestedLoop || nestedBlock->isLoopStmt(),
+                                 stmts);
+      }
+    }
+  }
+}
+
+// Collects the statements that can run after `stmt` in the same iteration
+static void collectLaterStmts(Expr *stmt, ForallStmt *forall,
+                              std::vector<Expr *> &laterStmts) {
+  for (Expr *cur = stmt;
+       cur != NULL && cur != forall->loopBody();
+       cur = cur->parentExpr) {
+    // the branches of a conditional are not in a list, so they don't have
+    // siblings
+    for (Expr *next = cur->next; next != NULL; next = next->next) {
+      laterStmts.push_back(next);
+    }
+  }
+}
+
+static bool isInductionVariable(Symbol *sym, ForallStmt *forall) {
+  for_alist(expr, forall->inductionVariables()) {
+    if (DefExpr *def = toDefExpr(expr)) {
+      if (def->sym == sym) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Symbols that are defined outside of the loop and may refer to the same data
+// as other symbols
+static bool symbolMayAlias(Symbol *sym, ForallStmt *forall) {
+  if (forall->loopBody()->contains(sym->defPoint)) {
+    return false;
+  }
+  return isArgSymbol(sym) || isShadowVarSymbol(sym) ||
+         sym->hasFlag(FLAG_REF_VAR);
+}
+
+// Returns true if one of the iterands of the forall can yield references into
+// one of `syms`
+static bool iterandMayYieldElementsOf(ForallStmt *forall,
+                                      std::set<Symbol *> &syms) {
+  for_alist(iterExpr, forall->iteratedExpressions()) {
+    Symbol *iterSym = NULL;
+    if (SymExpr *iterSE = toSymExpr(iterExpr)) {
+      iterSym = iterSE->symbol();
+    }
+    else if (CallExpr *iterCall = toCallExpr(iterExpr)) {
+      // e.g. a slice. `A.domain` and the like are not accesses
+      if (isAccessLikeExpr(iterCall)) {
+        iterSym = getCallBase(iterCall);
+      }
+    }
+
+    if (iterSym != NULL) {
+      if (syms.count(iterSym) != 0 || symbolMayAlias(iterSym, forall)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Returns the name of the function if `call` may call a function that can
+// access arbitrary data. Operators and compiler-generated calls are assumed to
+// be harmless. Array accesses are checked through the symbols they use
+static const char *getCalledFunctionName(CallExpr *call) {
+  if (call->primitive != NULL) {
+    return NULL;
+  }
+
+  if (SymExpr *baseSE = toSymExpr(call->baseExpr)) {
+    Symbol *baseSym = baseSE->symbol();
+    return isFnSymbol(baseSym) ? baseSym->name : NULL;
+  }
+  else if (UnresolvedSymExpr *baseUSE = toUnresolvedSymExpr(call->baseExpr)) {
+    const char *name = baseUSE->unresolved;
+    if (isalpha(name[0]) && !startsWith(name, "chpl_")) {
+      return name;
+    }
+    return NULL;
+  }
+
+  // a method call or something more complicated
+  return "a method";
+}
+
+// Returns true if none of the `stmts` access the `syms`, or data that they may
+// alias. Sets `reason` if that is not the case. If `allowIndexReads` is set, the
+// loop index variables in `syms` can be read, but not written.
+static bool stmtsAreIndependentOf(std::vector<Expr *> &stmts,
+                                  std::set<Symbol *> &syms,
+                                  ForallStmt *forall,
+                                  bool allowIndexReads,
+                                  std::string &reason) {
+  bool symsMayAlias = false;
+  for_set(Symbol, sym, syms) {
+    if (symbolMayAlias(sym, forall)) {
+      symsMayAlias = true;
+    }
+  }
+
+  bool iterandHasSyms = iterandMayYieldElementsOf(forall, syms);
+
+  for_vector(Expr, stmt, stmts) {
+    if (CallExpr *stmtCall = toCallExpr(stmt)) {
+      if (stmtCall->isPrimitive(PRIM_END_OF_STATEMENT)) {
+        continue;
+      }
+    }
+
+    std::vector<SymExpr *> symExprs;
+    collectSymExprs(stmt, symExprs);
+
+    for_vector(SymExpr, se, symExprs) {
+      Symbol *sym = se->symbol();
+      CallExpr *parentCall = toCallExpr(se->parentExpr);
+
+      bool isWritten = false;
+      bool isAccessBase = false;
+      if (parentCall != NULL) {
+        isWritten = (parentCall->get(1) == se &&
+                     (parentCall->isNamedAstr(astrSassign) ||
+                      getAggregatableUpdateOp(parentCall) != NULL));
+        isAccessBase = (parentCall->baseExpr == se ||
+                        (parentCall->isPrimitive(PRIM_MAYBE_LOCAL_THIS) &&
+                         parentCall->get(1) == se));
+      }
+
+      if (syms.count(sym) != 0) {
+        if (!(allowIndexReads && isInductionVariable(sym, forall) &&
+              !isWritten)) {
+          reason = std::string("a later statement accesses ") + sym->name;
+          return false;
+        }
+      }
+      else if (isInductionVariable(sym, forall) && iterandHasSyms) {
+        reason = std::string("a later statement uses ") + sym->name +
+                 ", which may refer to the same array";
+        return false;
+      }
+      else if ((isAccessBase || isWritten) &&
+               (symsMayAlias || symbolMayAlias(sym, forall))) {
+        reason = std::string("a later statement accesses ") + sym->name +
+                 ", which may alias the same array";
+        return false;
+      }
+    }
+
+    std::vector<CallExpr *> calls;
+    collectCallExprs(stmt, calls);
+
+    for_vector(CallExpr, call, calls) {
+      if (const char *fnName = getCalledFunctionName(call)) {
+        reason = std::string("a later statement calls ") + fnName +
+                 ", which may access the same array";
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+// Collects the symbols whose data an aggregation candidate reads or writes
+static void gatherAccessedSyms(Expr *expr, ForallStmt *forall,
+                               std::set<Symbol *> &syms) {
+  if (CallExpr *call = toCallExpr(expr)) {
+    if (call->isPrimitive(PRIM_MAYBE_LOCAL_THIS)) {
+      if (SymExpr *arrSE = toSymExpr(call->get(1))) {
+        syms.insert(arrSE->symbol());
+      }
+    }
+    else if (Symbol *baseSym = getCallBase(call)) {
+      syms.insert(baseSym);
+    }
+  }
+  else if (SymExpr *se = toSymExpr(expr)) {
+    if (!isLiteralOrParam(se)) {
+      syms.insert(se->symbol());
+
+      // a yielded array element is also an access to the array
+      if (Expr *iterExpr = getAlignedIterandForTheYieldedSym(se->symbol(),
+                                                             forall)) {
+        if (SymExpr *iterSE = toSymExpr(iterExpr)) {
+          syms.insert(iterSE->symbol());
+        }
+      }
+    }
+  }
+}
+
+// The last statement of the loop body can always be aggregated as nothing can
+// observe the deferred assignment until the end of the forall. Other statements
+// can be aggregated only if the statements that follow them don't touch the
+// same data.
+static bool candidateIsIndependentOfLaterStmts(CallExpr *call,
+                                               ForallStmt *forall) {
+  std::set<Symbol *> syms;
+  gatherAccessedSyms(call->get(1), forall, syms);
+  gatherAccessedSyms(call->get(2), forall, syms);
+
+  std::vector<Expr *> laterStmts;
+  collectLaterStmts(call, forall, laterStmts);
+
+  std::string reason;
+  if (!stmtsAreIndependentOf(laterStmts, syms, forall,
+                             /*allowIndexReads=*/false, reason)) {
+    std::stringstream message;
+    message << "Rejected aggregation candidate: " << reason;
+    LOG_AA(1, message.str().c_str(), call);
+    return false;
+  }
+
+  return true;
+}
+
+// Turns
+//
+//   var x = B[j];
+//   ...
+//   A[i] = x;
+//
+// into
+//
+//   ...
+//   A[i] = B[j];
+//
+// if that's the only use of `x`, so that the read can be aggregated as part of
+// the assignment. The statements in between must not touch anything that the
+// read uses. The removed definitions are recorded in `combined`, keyed by the
+// store, so that the rewrite can be undone if the store is not aggregated.
+static void combineReadsWithLaterStores(ForallStmt *forall,
+                                        std::map<CallExpr *, DefExpr *> &combined) {
+  BlockStmt *body = forall->loopBody();
+
+  for_alist(stmt, body->body) {
+    DefExpr *def = toDefExpr(stmt);
+    if (def == NULL || def->init == NULL || def->exprType != NULL) continue;
+
+    VarSymbol *var = toVarSymbol(def->sym);
+    if (var == NULL ||
+        var->hasFlag(FLAG_REF_VAR) ||
+        var->hasFlag(FLAG_PARAM) ||
+        var->hasFlag(FLAG_TYPE_VARIABLE) ||
+        var->hasFlag(FLAG_CONFIG)) continue;
+
+    // we are only interested in reads that may be remote
+    CallExpr *readCall = toCallExpr(def->init);
+    if (readCall == NULL ||
+        readCall->isPrimitive(PRIM_MAYBE_LOCAL_THIS) ||
+        !isAccessLikeExpr(readCall)) continue;
+
+    std::vector<SymExpr *> uses;
+    collectSymExprsFor(body, var, uses);
+    if (uses.size() != 1) continue;
+
+    SymExpr *use = uses[0];
+    CallExpr *store = toCallExpr(use->parentExpr);
+    if (store == NULL ||
+        !store->isNamedAstr(astrSassign) ||
+        store->get(2) != use ||
+        store->parentExpr != body ||
+        !isAccessLikeExpr(store->get(1))) continue;
+
+    std::set<Symbol *> syms;
+    std::vector<SymExpr *> readSymExprs;
+    collectSymExprs(readCall, readSymExprs);
+    for_vector(SymExpr, se, readSymExprs) {
+      if (!isFnSymbol(se->symbol()) && !isLiteralOrParam(se)) {
+        syms.insert(se->symbol());
+      }
+    }
+
+    std::vector<Expr *> stmtsInBetween;
+    for (Expr *cur = def->next; cur != store; cur = cur->next) {
+      stmtsInBetween.push_back(cur);
+    }
+
+    std::string reason;
+    if (!stmtsAreIndependentOf(stmtsInBetween, syms, forall,
+                               /*allowIndexReads=*/true, reason)) {
+      std::stringstream message;
+      message << "Can't combine the read with the store that uses it: ";
+      message << reason;
+      LOG_AA(1, message.str().c_str(), def);
+      continue;
+    }
+
+    LOG_AA(1, "Combined a read with the store that uses it", store);
+
+    // the read is moved, not copied, as it may be tracked by the forall's
+    // optimization info. A placeholder is left in the definition for
+    // undoCombinedRead
+    SET_LINENO(store);
+    readCall->replace(new SymExpr(gNil));
+    use->replace(readCall);
+    def->remove();
+    combined[store] = def;
+  }
+}
+
+// Puts back the definition that combineReadsWithLaterStores removed, for a
+// store that didn't become an aggregation candidate. The definition is
+// inserted right before the store; the statements it is moved past are
+// independent of the read.
+static void undoCombinedRead(CallExpr *store, DefExpr *def) {
+  INT_ASSERT(store->inTree());
+
+  LOG_AA(1, "Store is not an aggregation candidate, undoing the combined read",
+         store);
+
+  SET_LINENO(store);
+  store->insertBefore(def);
+
+  Expr *readCall = store->get(2);
+  readCall->replace(new SymExpr(def->sym));
+  def->init->replace(readCall);
+}
+
 Expr *preFoldMaybeAggregateAssign(CallExpr *call) {
   INT_ASSERT(call->isPrimitive(PRIM_MAYBE_AGGREGATE_ASSIGN));
 
   Expr *rhs = call->get(2)->remove();
   Expr *lhs = call->get(1)->remove();
 
-  CallExpr *assign = new CallExpr("=", lhs, rhs);
-
   SymExpr *srcAggregatorSE = toSymExpr(call->get(2)->remove());
   INT_ASSERT(srcAggregatorSE);
   SymExpr *dstAggregatorSE = toSymExpr(call->get(1)->remove());
@@ -1685,42 +2283,85 @@ Expr *preFoldMaybeAggregateAssign(CallExpr *call) {
   SymExpr *aggMarkerSE = toSymExpr(call->get(1)->remove());
   INT_ASSERT(aggMarkerSE);
 
+  // updates have an additional argument for the name of the operator
+  const char *updateOp = NULL;
+  if (call->numActuals() > 0) {
+    updateOp = get_string(call->get(1)->remove());
+  }
+
+  // the RHS was moved here from the initializer of a variable by
+  // combineReadsWithLaterStores
+  bool combinedRead = aggMarkerSE->symbol()->hasFlag(FLAG_AGG_COMBINED_READ);
+
+  CallExpr *assign = new CallExpr(updateOp ? updateOp : "=", lhs, rhs);
+
   Expr *replacement = NULL;
 
+  std::stringstream message;
+
   // either side is local, but not both
   if (lhsLocal != rhsLocal) {
     Symbol *aggregator = NULL;
 
-    std::stringstream message;
-
     // aggregator can be nil in two cases:
     // (1) we couldn't determine what the code looks like statically on one side of
     //     the assignment, in which case we set this argument to `gNil`.
     // (2) we may have called an aggregator generator on an unsupported type,
     //     which returns `nil` in the module code.
-    if (lhsLocal && (srcAggregator->type != dtNil)) {
-      if (fReportAutoAggregation) {
-        message << "LHS is local, RHS is nonlocal. Will use source aggregation ";
+    if (combinedRead && !isPOD(rhs->getValType())) {
+      // aggregators copy the value as is, so they can't stand in for the
+      // copy-initialization and deinitialization of the variable that the
+      // read was combined from
+      message << (lhsLocal ? "LHS is local, RHS is nonlocal, " :
+                             "LHS is nonlocal, RHS is local, ");
+      message << "but the combined read is not of a POD type. ";
+      message << "Will not use aggregation ";
+    }
+    else if (lhsLocal && (srcAggregator->type != dtNil)) {
+      // the source aggregator copies the remote value as is, so it can't
+      // handle an assignment that needs a conversion
+      if (lhs->getValType() != rhs->getValType()) {
+        message << "LHS and RHS have different types. ";
+        message << "Will not use aggregation ";
+      }
+      else {
+        message << "LHS is local, RHS is nonlocal. ";
+        message << "Will use source aggregation ";
+        aggregator = srcAggregator;
       }
-      aggregator = srcAggregator;
     }
     else if (rhsLocal && (dstAggregator->type != dtNil)) {
-      if (fReportAutoAggregation) {
-        message << "LHS is nonlocal, RHS is local. Will use destination aggregation ";
+      message << "LHS is nonlocal, RHS is local. ";
+      message << "Will use destination aggregation ";
+      if (updateOp != NULL) {
+        message << "for the update ";
       }
       aggregator = dstAggregator;
     }
+    else {
+      message << (lhsLocal ? "LHS is local, RHS is nonlocal, " :
+                             "LHS is nonlocal, RHS is local, ");
+      message << "but there is no aggregator for this access. ";
+      message << "Will not use aggregation ";
+    }
 
     if (aggregator != NULL) {
-      if (fReportAutoAggregation) {
-        message << getForallCloneTypeStr(aggMarkerSE->symbol());
-        LOG_AA(0, message.str().c_str(), call);
-      }
-
-      replacement = createAggCond(assign, aggregator, aggMarkerSE);
+      replacement = createAggCond(assign, aggregator, aggMarkerSE,
+                                  updateOp != NULL);
     }
   }
-  
+  else if (lhsLocal) {
+    message << "LHS and RHS are both local. Will not use aggregation ";
+  }
+  else {
+    message << "LHS and RHS are both nonlocal. Will not use aggregation ";
+  }
+
+  if (fReportAutoAggregation) {
+    message << getForallCloneTypeStr(aggMarkerSE->symbol());
+    LOG_AA(0, message.str().c_str(), call);
+  }
+
   if (replacement == NULL) {
     aggMarkerSE->symbol()->defPoint->remove();
 
@@ -1733,7 +2374,20 @@ Expr *preFoldMaybeAggregateAssign(CallExpr *call) {
     if (dstAggregator != gNil) {
       removeAggregatorFromFunction(dstAggregator, parentFn);
     }
-    replacement = assign;
+    if (combinedRead) {
+      // go back to what the user wrote, `var x = B[j]; A[i] = x;`, so that
+      // `x` is copy-initialized and deinitialized as usual
+      SET_LINENO(call);
+      VarSymbol *readCopy = new VarSymbol("chpl_aggReadCopy");
+      BlockStmt *block = new BlockStmt();
+      rhs->replace(new SymExpr(readCopy));
+      block->insertAtTail(new DefExpr(readCopy, rhs));
+      block->insertAtTail(assign);
+      replacement = block;
+    }
+    else {
+      replacement = assign;
+    }
   }
 
   return replacement;
@@ -1770,15 +2424,30 @@ void AggregationCandidateInfo::transformCandidate() {
     default:
       break;
   }
+  if (this->independent) {
+    aggMarker->addFlag(FLAG_AGG_INDEPENDENT_STMT);
+  }
+  if (this->combinedRead) {
+    aggMarker->addFlag(FLAG_AGG_COMBINED_READ);
+  }
   this->candidate->insertBefore(new DefExpr(aggMarker));
 
   repl->insertAtTail(new SymExpr(aggMarker));
+
+  if (this->updateOp != NULL) {
+    repl->insertAtTail(new SymExpr(new_CStringSymbol(this->updateOp)));
+  }
   
   this->candidate->replace(repl);
 }
 
-static void insertAggCandidate(CallExpr *call, ForallStmt *forall) {
+static void insertAggCandidate(CallExpr *call, ForallStmt *forall,
+                               const char *updateOp, bool independent,
+                               bool combinedRead) {
   AggregationCandidateInfo *info = new AggregationCandidateInfo(call, forall);
+  info->updateOp = updateOp;
+  info->independent = independent;
+  info->combinedRead = combinedRead;
 
   // establish connection between PRIM_MAYBE_LOCAL_THIS and their parent
   CallExpr *lhsCall = toCallExpr(call->get(1));
@@ -1797,6 +2466,7 @@ static void insertAggCandidate(CallExpr *call, ForallStmt *forall) {
     info->rhsLogicalChild = rhsCall;
   }
   else if (SymExpr *rhsSymExpr = toSymExpr(call->get(2))) {
+    // literals, params and, for updates, variables declared in the loop body
     info->rhsLocalityInfo = LOCAL;
     info->rhsLogicalChild = rhsSymExpr;
   }
@@ -1836,18 +2506,20 @@ static Expr *getAlignedIterandForTheYieldedSym(Symbol *sym, ForallStmt *forall)
   return NULL;
 }
 
-static bool handleYieldedArrayElementsInAssignment(CallExpr *call,
-                                                   ForallStmt *forall) {
-  SET_LINENO(call);
-
+// Returns the side of the assignment that is a symbol yielded by one of the
+// iterands, if the assignment can be aggregated by treating that symbol as an
+// array element. `maybeArrExpr` is set to the corresponding iterand. This
+// doesn't change the AST.
+static SymExpr *getYieldedArrayElementInAssignment(CallExpr *call,
+                                                   ForallStmt *forall,
+                                                   Expr *&maybeArrExpr) {
   INT_ASSERT(call->isNamed("="));
 
   if (!forall->optInfo.infoGathered) {
     gatherForallInfo(forall);
   }
 
-  Symbol *maybeArrElemSym = NULL;
-  Expr *maybeArrExpr = NULL;
+  maybeArrExpr = NULL;
 
   bool lhsMaybeArrSym = false;
   bool rhsMaybeArrSym = false;
@@ -1863,23 +2535,22 @@ static bool handleYieldedArrayElementsInAssignment(CallExpr *call,
     maybeArrExpr = getAlignedIterandForTheYieldedSym(tmpSym, forall);
     if (maybeArrExpr != NULL) {
       lhsMaybeArrSym = true;
-      maybeArrElemSym = tmpSym;
     }
   }
   if (rhsSymExpr) {
     Symbol *tmpSym = rhsSymExpr->symbol();
-    maybeArrExpr = getAlignedIterandForTheYieldedSym(tmpSym, forall);
-    if (maybeArrExpr != NULL) {
+    Expr *rhsArrExpr = getAlignedIterandForTheYieldedSym(tmpSym, forall);
+    if (rhsArrExpr != NULL) {
       rhsMaybeArrSym = true;
-      maybeArrElemSym = tmpSym;
+      maybeArrExpr = rhsArrExpr;
     }
   }
 
   // stop if neither can be an array element symbol
-  if (!lhsMaybeArrSym && !rhsMaybeArrSym) return false;
+  if (!lhsMaybeArrSym && !rhsMaybeArrSym) return NULL;
 
   // just to be sure, stop if someone's doing `a=a`;
-  if (lhsMaybeArrSym && rhsMaybeArrSym) return false;
+  if (lhsMaybeArrSym && rhsMaybeArrSym) return NULL;
 
   Expr *otherChild = lhsMaybeArrSym ? call->get(2) : call->get(1);
 
@@ -1896,9 +2567,21 @@ static bool handleYieldedArrayElementsInAssignment(CallExpr *call,
     }
   }
 
-  if (!otherChildIsSuitable) return false;
+  if (!otherChildIsSuitable) return NULL;
+
+  return lhsMaybeArrSym ? lhsSymExpr : rhsSymExpr;
+}
+
+static bool handleYieldedArrayElementsInAssignment(CallExpr *call,
+                                                   ForallStmt *forall) {
+  SET_LINENO(call);
+
+  Expr *maybeArrExpr = NULL;
+  SymExpr *symExprToReplace = getYieldedArrayElementInAssignment(call, forall,
+                                                                 maybeArrExpr);
+  if (symExprToReplace == NULL) return false;
 
-  SymExpr *symExprToReplace = lhsMaybeArrSym ? lhsSymExpr : rhsSymExpr;
+  Symbol *maybeArrElemSym = symExprToReplace->symbol();
 
   // add the check symbol
   VarSymbol *checkSym = new VarSymbol("chpl__yieldedArrayElemIsAligned");
@@ -1923,20 +2606,21 @@ static bool handleYieldedArrayElementsInAssignment(CallExpr *call,
   return true;
 }
 
-static CallExpr *findMaybeAggAssignInBlock(BlockStmt *block) {
-  Expr *cur = block->body.last();
-  
-  // at this point, only skippable call seems like PRIM_END_OF_STATEMENT, so
-  // just skip that and give up after.
-  if (CallExpr *curCall = toCallExpr(cur)) {
-    if (curCall->isPrimitive(PRIM_END_OF_STATEMENT)) {
-      cur = cur->prev;
-    }
-  }
-
-  if (CallExpr *curCall = toCallExpr(cur)) {
-    if (curCall->isPrimitive(PRIM_MAYBE_AGGREGATE_ASSIGN)) {
-      return curCall;
+// the candidate that uses `tmpSym` follows the statement that defines it, but
+// need not be the last statement in the block anymore, so look for the one
+// that uses `tmpSym` as either side
+static CallExpr *findMaybeAggAssignUsing(Expr *stmt, Symbol *tmpSym) {
+  for (Expr *cur = stmt->next; cur != NULL; cur = cur->next) {
+    if (CallExpr *curCall = toCallExpr(cur)) {
+      if (curCall->isPrimitive(PRIM_MAYBE_AGGREGATE_ASSIGN)) {
+        for (int i = 1 ; i <= 2 ; i++) {
+          if (SymExpr *se = toSymExpr(curCall->get(i))) {
+            if (se->symbol() == tmpSym) {
+              return curCall;
+            }
+          }
+        }
+      }
     }
   }
 
@@ -1997,7 +2681,10 @@ static void findAndUpdateMaybeAggAssign(CallExpr *call, bool confirmed) {
   }
 
   if (tmpSym) {
-    if (CallExpr *maybeAggAssign = findMaybeAggAssignInBlock(call->getScopeBlock())) {
+    CallExpr *maybeAggAssign = findMaybeAggAssignUsing(call->getStmtExpr(),
+                                                       tmpSym);
+
+    if (maybeAggAssign != NULL) {
 
 
       if (fReportAutoAggregation) {
@@ -2055,13 +2742,13 @@ static void removeAggregationFromRecursiveForallHelp(BlockStmt *block) {
 
       if (aggMarkerSym->hasFlag(FLAG_AGG_MARKER)) {
 
+        // this is either `=` or an update like `+=`
         CallExpr *assignCall = toCallExpr(condStmt->thenStmt->getFirstExpr()->parentExpr);
         INT_ASSERT(assignCall);
-        INT_ASSERT(assignCall->isNamed("="));
 
         CallExpr *aggCall = toCallExpr(condStmt->elseStmt->getFirstExpr()->parentExpr);
         INT_ASSERT(aggCall);
-        INT_ASSERT(aggCall->isNamed("copy"));
+        INT_ASSERT(aggCall->isNamed("copy") || aggCall->isNamed("update"));
 
         SymExpr *aggregatorSE = toSymExpr(aggCall->get(1));
         INT_ASSERT(aggregatorSE);
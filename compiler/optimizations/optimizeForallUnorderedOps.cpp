@@ -36,6 +36,7 @@
 #include "virtualDispatch.h"
 #include "wellknown.h"
 
+#include <algorithm>
 #include <stack>
 
 /*
@@ -188,6 +189,65 @@ std::vector<Expr *> getLastStmtsForForallUnorderedOps(ForallStmt *forall) {
   return lastStmts;
 }
 
+// ---- aggregated statements that are not necessarily the last statement
+
+// Automatic aggregation can also target statements other than the last one in
+// the loop body, and `op=` updates. Those have been checked against the
+// statements that follow them before normalization, and their aggregation
+// markers are flagged accordingly.
+
+static CondStmt *getAggregationCondStmt(Expr *stmt);
+
+static bool isIndependentAggCondStmt(CondStmt *cond) {
+  if (SymExpr *condSymExpr = toSymExpr(cond->condExpr)) {
+    Symbol *marker = condSymExpr->symbol();
+    return marker->hasFlag(FLAG_AGG_MARKER) &&
+           marker->hasFlag(FLAG_AGG_INDEPENDENT_STMT);
+  }
+  return false;
+}
+
+// Nested loops are skipped, they are considered on their own.
+static void collectIndependentAggCondStmts(BlockStmt *block,
+                                           std::vector<CondStmt *> &conds) {
+  for_alist(stmt, block->body) {
+    if (CondStmt *cond = toCondStmt(stmt)) {
+      if (isIndependentAggCondStmt(cond)) {
+        conds.push_back(cond);
+      } else {
+        collectIndependentAggCondStmts(cond->thenStmt, conds);
+        if (cond->elseStmt != NULL)
+          collectIndependentAggCondStmts(cond->elseStmt, conds);
+      }
+    } else if (BlockStmt *nestedBlock = toBlockStmt(stmt)) {
+      if (!nestedBlock->isLoopStmt())
+        collectIndependentAggCondStmts(nestedBlock, conds);
+    }
+  }
+}
+
+// Returns the assignment or update in the then block of the conditional
+static Expr *getAggCondStmtAssign(CondStmt *cond) {
+  std::vector<Expr *> stmts;
+  helpGetLastStmts(cond->thenStmt->body.last(), stmts);
+  return stmts.size() == 1 ? stmts[0] : NULL;
+}
+
+// Adds the assignments of the aggregation conditionals to `stmts`, if they are
+// not there already
+static void addIndependentAggStmts(BlockStmt *loop,
+                                   std::vector<Expr *> &stmts) {
+  std::vector<CondStmt *> aggConds;
+  collectIndependentAggCondStmts(loop, aggConds);
+
+  for_vector(CondStmt, aggCond, aggConds) {
+    if (Expr *stmt = getAggCondStmtAssign(aggCond)) {
+      if (std::find(stmts.begin(), stmts.end(), stmt) == stmts.end())
+        stmts.push_back(stmt);
+    }
+  }
+}
+
 // ---- mark optimizable foralls during lifetime checking
 
 // This could definitely be implemented in a faster way.
@@ -236,6 +296,15 @@ bool exprIsOptimizable(BlockStmt* loop, Expr* lastStmt,
         Symbol* atomic = toSymExpr(call->get(1))->symbol();
         INT_ASSERT(atomic->getValType()->symbol->hasFlag(FLAG_ATOMIC_TYPE));
         return true;
+      } else if (CondStmt* aggCond = getAggregationCondStmt(call)) {
+        // an update like `+=` that automatic aggregation has found to be
+        // independent of the rest of the loop body
+        if (isIndependentAggCondStmt(aggCond) && call->numActuals() == 2) {
+          SymExpr* lhs = toSymExpr(call->get(1));
+          SymExpr* rhs = toSymExpr(call->get(2));
+          if (lhs && rhs && isPOD(lhs->getValType()))
+            return true;
+        }
       }
     }
   }
@@ -304,6 +373,7 @@ void MarkOptimizableForallLastStmts::markLoopsInForall(ForallStmt* forall) {
   for_vector(BlockStmt, block, bodies) {
     std::vector<Expr*> lastStmts;
     getLastStmts(block, lastStmts);
+    addIndependentAggStmts(block, lastStmts);
     lastStatementsPerBody.push_back(lastStmts);
   }
 
@@ -901,6 +971,27 @@ static bool isOptimizableAssignStmt(Expr* stmt, BlockStmt* loop) {
   return false;
 }
 
+// Like isOptimizableAssignStmt, but for the statement in an aggregation
+// conditional that may be any call updating its first argument, e.g. a
+// `+=` that was inlined to a primitive.
+static bool isOptimizableAggregationStmt(Expr* stmt, BlockStmt* loop) {
+  Symbol* lhs = NULL;
+  if (CallExpr* call = toCallExpr(stmt))
+    if (call->numActuals() >= 1)
+      if (SymExpr* lhsSe = toSymExpr(call->get(1)))
+        lhs = lhsSe->symbol();
+
+  if (lhs)
+    if (BlockStmt* defInBlock = toBlockStmt(lhs->defPoint->parentExpr))
+      if (isBlockWithinBlock(defInBlock, loop))
+        if (CallExpr* marker = findMarkerNear(stmt))
+          if (hasOptimizationFlag(marker, OPT_INFO_LHS_OUTLIVES_FORALL) &&
+              hasOptimizationFlag(marker, OPT_INFO_FLAG_NO_TASK_PRIVATE))
+            return true;
+
+  return false;
+}
+
 static CondStmt *getAggregationCondStmt(Expr *stmt) {
 
   // if this was an aggregatable assignment, it must be inside a then block of
@@ -1037,7 +1128,9 @@ void optimizeForallUnorderedOps() {
           }
           else if (isOptimizableAssignStmt(lastStmt, loop)) {
             if (CondStmt *aggCond = getAggregationCondStmt(lastStmt)) {
-              aggCondsToTransform.push_back(aggCond);
+              // independent aggregations are gathered below
+              if (!isIndependentAggCondStmt(aggCond))
+                aggCondsToTransform.push_back(aggCond);
             }
             else {
               assignsToOptimize.push_back(lastStmt);
@@ -1045,6 +1138,17 @@ void optimizeForallUnorderedOps() {
           }
         }
       }
+
+      {
+        std::vector<CondStmt*> aggConds;
+        collectIndependentAggCondStmts(loop, aggConds);
+        for_vector(CondStmt, aggCond, aggConds) {
+          Expr* stmt = getAggCondStmtAssign(aggCond);
+          if (stmt != NULL && isOptimizableAggregationStmt(stmt, loop)) {
+            aggCondsToTransform.push_back(aggCond);
+          }
+        }
+      }
     }
   }
 
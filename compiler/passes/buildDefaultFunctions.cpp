@@ -38,6 +38,12 @@
 FnSymbol* chplUserMain = NULL;
 static bool mainReturnsSomething;
 
+// While buildDefaultFunctions() runs, functionExists() looks functions up
+// in fnsByName instead of scanning gFnSymbols; see updateFnsByName().
+static bool fnsByNameActive = false;
+static std::map<const char*, std::vector<FnSymbol*> > fnsByName;
+static int fnsByNameIndexed = 0;
+
 static void buildChplEntryPoints();
 static void buildAccessors(AggregateType* ct, Symbol* field);
 
@@ -80,6 +86,8 @@ static void buildFieldAccessorFunctions(AggregateType* at);
 void buildDefaultFunctions() {
   buildChplEntryPoints();
 
+  fnsByNameActive = true;
+
   SET_LINENO(rootModule); // todo - remove reset_ast_loc() calls below?
 
   std::vector<BaseAST*> asts;
@@ -157,6 +165,10 @@ void buildDefaultFunctions() {
       }
     }
   }
+
+  fnsByNameActive = false;
+  fnsByName.clear();
+  fnsByNameIndexed = 0;
 }
 
 
@@ -190,6 +202,18 @@ typedef enum {
 } functionExistsKind;
 
 
+// functionExists() is called several times for every type in the program,
+// so index the functions by name, catching up on functions that were added
+// since the last call.  The index is only valid during the pass since
+// gFnSymbols is compacted by cleanAst() between passes.
+static void updateFnsByName() {
+  for (; fnsByNameIndexed < gFnSymbols.n; fnsByNameIndexed++) {
+    FnSymbol* fn = gFnSymbols.v[fnsByNameIndexed];
+
+    fnsByName[fn->name].push_back(fn);
+  }
+}
+
 // functionExists returns true iff
 //  function's name matches name
 //  function's number of formals matches numFormals
@@ -218,8 +242,26 @@ static FnSymbol* functionExists(const char* name,
 
   const char* nameAstr = astr(name);
 
-  forv_Vec(FnSymbol, fn, gFnSymbols)
+  std::vector<FnSymbol*>* candidates = NULL;
+
+  if (fnsByNameActive) {
+    updateFnsByName();
+
+    std::map<const char*, std::vector<FnSymbol*> >::iterator it =
+      fnsByName.find(nameAstr);
+
+    if (it == fnsByName.end())
+      return NULL;
+
+    candidates = &it->second;
+  }
+
+  int n = candidates ? (int)candidates->size() : gFnSymbols.n;
+
+  for (int i = 0; i < n; i++)
   {
+    FnSymbol* fn = candidates ? (*candidates)[i] : gFnSymbols.v[i];
+
     if (fn->name != nameAstr)
       continue;
 
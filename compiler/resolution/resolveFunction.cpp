@@ -1016,6 +1016,12 @@ static void insertUnrefForArrayOrTupleReturn(FnSymbol* fn) {
 
   Symbol* ret = fn->getReturnSymbol();
 
+  // A function that returns a global such as gVoid has nothing to
+  // unref, and walking that global's uses would visit every other
+  // function that mentions it.
+  if (ret->defPoint->getFunction() != fn)
+    return;
+
   for_SymbolSymExprs(se, ret) {
     if (CallExpr* call = toCallExpr(se->parentExpr)) {
       if (call->isPrimitive(PRIM_MOVE) == true &&
@@ -332,6 +332,50 @@ void closefile(fileinfo* thefile) {
 }
 
 
+//
+// With --incremental, generated files are first written next to their
+// final location and only moved into place if their contents changed.
+// Leaving unchanged files alone preserves their timestamps, so the
+// generated Makefile only recompiles the translation units that differ
+// from the previous compile into the same --savec directory.
+//
+static const char* incrementalNewFilename(const char* pathname) {
+  return astr(pathname, ".new");
+}
+
+static bool sameFileContents(const char* path1, const char* path2) {
+  FILE* f1 = openfile(path1, "r", false);
+  FILE* f2 = openfile(path2, "r", false);
+  bool  same = (f1 != NULL && f2 != NULL);
+
+  while (same) {
+    char   buf1[8192];
+    char   buf2[8192];
+    size_t n1 = fread(buf1, 1, sizeof(buf1), f1);
+    size_t n2 = fread(buf2, 1, sizeof(buf2), f2);
+
+    if (n1 != n2 || memcmp(buf1, buf2, n1) != 0)
+      same = false;
+    else if (n1 == 0)
+      break;
+  }
+
+  if (f1) closefile(f1);
+  if (f2) closefile(f2);
+
+  return same;
+}
+
+static void replaceFileIfChanged(const char* newPath, const char* path) {
+  if (sameFileContents(newPath, path)) {
+    if (remove(newPath) != 0) {
+      USR_FATAL("removing %s: %s", newPath, strerror(errno));
+    }
+  } else if (rename(newPath, path) != 0) {
+    USR_FATAL("renaming %s to %s: %s", newPath, path, strerror(errno));
+  }
+}
+
 void openCFile(fileinfo* fi, const char* name, const char* ext) {
   if (ext)
     fi->filename = astr(name, ".", ext);
@@ -339,11 +383,21 @@ void openCFile(fileinfo* fi, const char* name, const char* ext) {
     fi->filename = astr(name);
 
   fi->pathname = genIntermediateFilename(fi->filename);
-  openfile(fi, "w");
+
+  if (fIncrementalCompilation)
+    fi->fptr = openfile(incrementalNewFilename(fi->pathname), "w");
+  else
+    openfile(fi, "w");
 }
 
 void closeCFile(fileinfo* fi, bool beautifyIt) {
   closefile(fi->fptr);
+
+  fileinfo written = *fi;
+
+  if (fIncrementalCompilation)
+    written.pathname = incrementalNewFilename(fi->pathname);
+
   //
   // We should beautify if (1) we were asked to and (2) either (a) we
   // were asked to save the C code or (b) we were asked to codegen cpp
@@ -357,7 +411,10 @@ void closeCFile(fileinfo* fi, bool beautifyIt) {
   // save some time.
   //
   if (beautifyIt && (saveCDir[0] || printCppLineno))
-    beautify(fi);
+    beautify(&written);
+
+  if (fIncrementalCompilation)
+    replaceFileIfChanged(written.pathname, fi->pathname);
 }
 
 fileinfo* openTmpFile(const char* tmpfilename, const char* mode) {
@@ -729,6 +786,14 @@ void codegen_makefile(fileinfo* mainfile, const char** tmpbinname,
     fprintf(makefile.fptr, "SKIP_COMPILE_LINK = skip\n");
   }
 
+  //
+  // With --incremental, let make decide which generated translation units
+  // need to be recompiled rather than always compiling all of them.
+  //
+  if (fIncrementalCompilation) {
+    fprintf(makefile.fptr, "CHPL_INCREMENTAL = 1\n");
+  }
+
   //
   // In --library compilation, put the generated library in the library
   // directory.
@@ -1255,6 +1255,125 @@ where useBulkTransferDist {
   return true;
 }
 
+config param debugCyclicScan = false;
+
+//
+// Consecutive elements of a Cyclic array live on different locales, so
+// rather than scanning its local elements, each locale gathers a
+// contiguous block of the array into a local buffer, with one bulk GET per
+// locale. It scans that buffer, combines its total with those of the
+// preceding blocks much like BlockArr.doiScan() does, and then scatters the
+// results back into the Cyclic-distributed result.
+//
+proc CyclicArr.doiScan(op, dom) where (rank == 1) &&
+                                      chpl__scanStateResTypesMatch(op) {
+  import RangeChunk;
+
+  // The result of this scan, which will be Cyclic-distributed as well
+  type resType = op.generate().type;
+  var res = dom.buildArray(resType, initElts=!isPOD(resType));
+  const resArr = res._value;
+
+  // Store one element per locale in order to track our local total
+  // for a cross-locale scan as well as flags to negotiate reading and
+  // writing it.
+  const ref targetLocs = this.dsiTargetLocales();
+  const locDom = dom.dist.targetLocDom;
+  var elemPerLoc: [locDom] resType;
+  var inputReady$: [locDom] sync bool;
+  var outputReady$: [locDom] sync bool;
+
+  const whole = dom.dim(0);
+  const numBlocks = min(locDom.size, whole.size);
+
+  // Fire up tasks per participating locale
+  coforall locid in locDom {
+    on targetLocs[locid] {
+      const myop = op.clone(); // this will be deleted by doiScan()
+
+      // the contiguous block of indices that this locale scans
+      const blockIdx = locDom.indexOrder(locid);
+      const myRng = if blockIdx < numBlocks
+                      then RangeChunk.chunk(whole, numBlocks, blockIdx)
+                      else whole[1..0];
+      const myInds = {myRng};
+
+      // The block is stored with a positive stride, since bulk transfers
+      // into negatively strided arrays are not reliable. The scan itself
+      // still visits myInds in its own order.
+      const myStore = if dom.stridable
+                        then {myRng.alignedLow..myRng.alignedHigh by abs(myRng.stride)}
+                        else myInds;
+      var myElems: [myStore] eltType;
+      var myRes: [myStore] resType;
+
+      // gather our block from the locales that own it
+      forall j in locDom {
+        const inters = locArr[j].locDom.myBlock[myStore];
+        if inters.size > 0 then
+          myElems[inters] = locArr[j].myElems[inters];
+      }
+
+      // Compute the local pre-scan on our block
+      var (numTasks, rngs, state, tot) = myElems._value.chpl__preScan(myop, myRes, myInds);
+      if debugCyclicScan then
+        writeln(locid, ": ", (numTasks, rngs, state, tot));
+
+      // save our local scan total away and signal that it's ready
+      elemPerLoc[locid] = tot;
+      inputReady$[locid] = true;
+
+      // the "first" locale scans the per-locale contributions as they
+      // become ready
+      if (locid == locDom.low) {
+        const metaop = op.clone();
+
+        var next: resType = metaop.identity;
+        for locid in locDom {
+          const locready = inputReady$[locid];
+
+          // store the scan value and mark that it's ready
+          ref locVal = elemPerLoc[locid];
+          locVal <=> next;
+          outputReady$[locid] = true;
+
+          // accumulate to prep for the next iteration
+          metaop.accumulateOntoState(next, locVal);
+        }
+        delete metaop;
+      }
+
+      // block until someone tells us that our local value has been updated
+      // and then read it
+      const resready = outputReady$[locid];
+      const myadjust = elemPerLoc[locid];
+      if debugCyclicScan then
+        writeln(locid, ": myadjust = ", myadjust);
+
+      // update our state vector with our locale's adjustment value
+      for s in state do
+        myop.accumulateOntoState(s, myadjust);
+
+      // have our block compute its post scan with the globally
+      // accurate state vector
+      myElems._value.chpl__postScan(op, myRes, numTasks, rngs, state);
+
+      // scatter the results back to the locales that own them
+      forall j in locDom {
+        const inters = resArr.locArr[j].locDom.myBlock[myStore];
+        if inters.size > 0 then
+          resArr.locArr[j].myElems[inters] = myRes[inters];
+      }
+
+      delete myop;
+    }
+  }
+  if isPOD(resType) then res.dsiElementInitializationComplete();
+
+  delete op;
+  return res;
+}
+
 proc CyclicArr.dsiTargetLocales() const ref {
   return dom.dist.targetLocs;
 }
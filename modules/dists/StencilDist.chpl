@@ -56,7 +56,7 @@ config param stencilDistAllowPackedUpdateFluff = true;
 
 config param disableStencilDistBulkTransfer = false;
 
-// Instructs the _packedUpdate method to only perform the optimized buffer
+// Instructs the _packedUpdateLocal method to only perform the optimized buffer
 // packing if the number of GETs/PUTs would be greater than or equal to the
 // value in this config const.
 //
@@ -214,6 +214,33 @@ config param disableStencilLazyRAD = defaultDisableLazyRADOpt;
   After updating, any read from the array should be up-to-date. The
   ``updateFluff`` function does not currently accept any arguments.
 
+  The update can also be split into two phases so that computation which does
+  not read the cached elements, such as the interior of each locale's block,
+  can overlap the communication. ``startFluffUpdate`` begins updating the
+  cached elements in the background and returns, and ``finishFluffUpdate``
+  waits for the update to complete:
+
+  .. code-block:: chapel
+
+    A.startFluffUpdate();
+
+    // compute using elements away from each locale's boundary
+
+    A.finishFluffUpdate();
+
+    // ghost caches are now up-to-date
+
+  Each call to ``startFluffUpdate`` must be matched by a call to
+  ``finishFluffUpdate``. The array must not be written to between the two
+  calls, and reads of cached elements between them may return either the old
+  or the new values.
+
+  When the element type allows it, each locale packs the elements it sends to
+  a neighbor into a contiguous buffer and transfers it with a single PUT. The
+  faces are exchanged one dimension at a time, with each face carrying the
+  edge and corner elements received for earlier dimensions, so a locale sends
+  only two messages per dimension.
+
   **Reading and Writing to Array Elements**
 
   The Stencil distribution uses ghost cells as cached read-only values from
@@ -315,6 +342,12 @@ class LocStencilDom {
   var recvDest, recvSrc,
       sendDest, sendSrc: [NeighDom] domain(rank, idxType, stridable);
   var Neighs: [NeighDom] rank*int;
+
+  // Faces extended across the fluff of earlier dimensions, used by the
+  // dimension-ordered packed update. Only the face directions are set.
+  var faceRecvDest, faceRecvSrc,
+      faceSendDest, faceSendSrc: [NeighDom] domain(rank, idxType, stridable);
+  var faceExchangeOk: bool;
 }
 
 //
@@ -364,6 +397,10 @@ class LocStencilArr {
   var recvBufs, sendBufs : [locDom.NeighDom] [locDom.bufDom] eltType;
   var sendRecvFlag : [locDom.NeighDom] atomic bool;
 
+  // State of a split-phase fluff update on this locale
+  var fluffPending: bool;
+  var fluffDone: atomic bool;
+
   proc init(type eltType,
             param rank: int,
             type idxType,
@@ -936,6 +973,13 @@ private proc nearestDom(param rank) {
   return ND;
 }
 
+// Index into a 'nearestDom' domain of the neighbor across dimension 'dim'
+private proc unitNeigh(param rank, dim, side) {
+  var L : rank*int;
+  L(dim) = side;
+  return L;
+}
+
 proc StencilDom.setup() {
   coforall localeIdx in dist.targetLocDom {
     on dist.targetLocales(localeIdx) {
@@ -1044,8 +1088,76 @@ proc StencilDom.setup() {
             }
           }
         }
+
+        // Extend each face across the fluff of the earlier dimensions. When
+        // faces are exchanged one dimension at a time, an extended face
+        // carries the edge and corner elements received in earlier
+        // dimensions along with it.
+        for param d in 0..rank-1 {
+          for side in (-1, 1) {
+            const L = unitNeigh(rank, d, side);
+            if myLocDom.recvSrc[L].size == 0 {
+              // Clear out faces left over from an earlier setup
+              myLocDom.faceRecvDest[L] = myLocDom.recvSrc[L];
+              myLocDom.faceRecvSrc[L] = myLocDom.recvSrc[L];
+              myLocDom.faceSendSrc[L] = myLocDom.recvSrc[L];
+              myLocDom.faceSendDest[L] = myLocDom.recvSrc[L];
+              continue;
+            }
+
+            var dr : rank*whole.dim(0).type;
+            for param e in 0..rank-1 {
+              const cur = blockDims(e);
+              var low = cur.alignedLow, high = cur.alignedHigh;
+              if e < d {
+                for s in (-1, 1) {
+                  const E = unitNeigh(rank, e, s);
+                  if myLocDom.recvSrc[E].size != 0 {
+                    const fr = myLocDom.recvDest[E].dim(e);
+                    low = min(low, fr.alignedLow);
+                    high = max(high, fr.alignedHigh);
+                  }
+                }
+              }
+              dr(e) = low..high;
+              if stridable then
+                dr(e) = dr(e) by cur.stride;
+            }
+
+            proc withDim(dom) {
+              var ret = dr;
+              ret(d) = dom.dim(d);
+              return {(...ret)};
+            }
+            myLocDom.faceRecvDest[L] = withDim(myLocDom.recvDest[L]);
+            myLocDom.faceRecvSrc[L]  = withDim(myLocDom.recvSrc[L]);
+            myLocDom.faceSendSrc[L]  = withDim(myLocDom.sendSrc[L]);
+            myLocDom.faceSendDest[L] = withDim(myLocDom.sendDest[L]);
+
+            bufLen = max(bufLen, myLocDom.faceRecvDest[L].size);
+          }
+        }
+
         myLocDom.bufDom = {1..bufLen};
       }
+
+      // The dimension-ordered update expects each face's fluff to come from
+      // the adjacent locale in that dimension, so every locale needs a
+      // non-empty block at least as wide as the fluff. Block sizes along a
+      // dimension only depend on the locale's position in that dimension,
+      // so checking the locales in line with this one gives every locale
+      // the same answer.
+      var faceOk = true;
+      for param d in 0..rank-1 {
+        for c in dist.targetLocDom.dim(d) {
+          var idx = chpl__tuplify(localeIdx);
+          idx(d) = c;
+          const chunk = dist.getChunk(whole, idx);
+          if chunk.size == 0 || chunk.dim(d).size < fluff(d) then
+            faceOk = false;
+        }
+      }
+      myLocDom.faceExchangeOk = faceOk;
     }
   }
 
@@ -1069,6 +1181,11 @@ proc StencilDom.setup() {
 
             checker(localeIdx, recvS, N, locDoms[N].sendSrc[other]);
             checker(localeIdx, recvD, N, locDoms[N].sendDest[other]);
+
+            if myLocDom.faceRecvDest[L].size != 0 {
+              checker(localeIdx, myLocDom.faceRecvSrc[L], N, locDoms[N].faceSendSrc[other]);
+              checker(localeIdx, myLocDom.faceRecvDest[L], N, locDoms[N].faceSendDest[other]);
+            }
           }
         }
       }
@@ -1580,112 +1697,126 @@ proc StencilArr.noFluffView() {
 proc StencilArr.naiveUpdateFluff() {
   coforall i in dom.dist.targetLocDom {
     on dom.dist.targetLocales(i) {
-      ref myLocDom = locArr[i].locDom;
-      forall (S, D, N, L) in zip(myLocDom.recvSrc, myLocDom.recvDest,
-          myLocDom.Neighs, myLocDom.NeighDom) {
-        // A source domain of size zero indicates that no communication
-        // is necessary.
-        //
-        // if "L" is zero, that indicates we are at the center of the stencil
-        // and do not need to update
-        if !isZeroTuple(L) && S.size != 0 {
-          locArr[i].myElems[D] = locArr[N].myElems[S];
-        }
-      }
+      _naiveUpdateLocal(i);
+    }
+  }
+}
+
+// The part of naiveUpdateFluff performed on locale 'i'
+proc StencilArr._naiveUpdateLocal(i) {
+  ref myLocDom = locArr[i].locDom;
+  forall (S, D, N, L) in zip(myLocDom.recvSrc, myLocDom.recvDest,
+      myLocDom.Neighs, myLocDom.NeighDom) {
+    // A source domain of size zero indicates that no communication
+    // is necessary.
+    //
+    // if "L" is zero, that indicates we are at the center of the stencil
+    // and do not need to update
+    if !isZeroTuple(L) && S.size != 0 {
+      locArr[i].myElems[D] = locArr[N].myElems[S];
     }
   }
 }
 
-//
-// TODO: GET or PUT the data? Does it matter for performance?
 //
 // TODO: should we avoid doing the packed transfer for dense-ish regions?
 // e.g. {1..5, 1..100} might only require 5 GETs/PUTs
 //
-// This is an optimized variant of the naiveUpdateFluff method. This variant
-// packs elements into a buffer such that we only do one GET/PUT. This is
-// most beneficial when the communicated region would require many GETs in
-// the naive approach. For example, Let's say we have a 10x10 domain with
-// a fluff of (1,1). Our wholeFluff domain would be {0..11, 0..11}. When we go
-// to communicate the region {1..10,1..1}, the naive method requires 10 GETs or
-// PUTs, whereas the packed method requires just one.
-//
-// On each locale:
-// 1) Repeat the following for each region of data that other locales will
-//    want to fetch:
-//    a) Serialize/pack the region of data into a 1D buffer array. This is the
-//       buffer that other locales will read from.
-//    b) Write 'true' to an atomic flag on the local that intends to read from
-//       the buffer that was just populated.
-// 2) Once we have prepared our local data for reading, repeat the following
-//    for each region of data that *our* cache wants to update:
+// This is an optimized variant of the naive update, performed on locale 'i'.
+// Rather than communicating with each of the 3**rank-1 neighbors separately,
+// the faces are exchanged one dimension at a time. Each face is extended
+// across the fluff already received for earlier dimensions (see
+// LocStencilDom.faceSendSrc), so the edge and corner elements travel along
+// with the faces and only 2*rank messages are needed. For example, a 3D
+// stencil sends 6 messages instead of 26.
+//
+// Each face is packed into a 1D buffer and sent to the neighbor with a
+// single PUT, which matters most when the face would require many
+// GETs/PUTs in the naive approach. For example, Let's say we have a 10x10
+// domain with a fluff of (1,1). Our wholeFluff domain would be
+// {0..11, 0..11}. When we go to communicate the region {1..10,1..1}, the
+// naive method requires 10 GETs or PUTs, whereas the packed method requires
+// just one.
+//
+// For each dimension, in order:
+// 1) For each of the two faces in this dimension:
+//    a) Serialize/pack the face into a 1D buffer array.
+//    b) PUT the buffer into the neighbor's receive buffer for this face.
+//    c) Write 'true' to the atomic flag on the neighbor for this face.
+// 2) For each of the two faces in this dimension:
 //    a) Wait for the corresponding atomic flag to be 'true' so that we know
-//       it is safe to fetch the data from the remote locale. Reset the flag to
-//       false afterwards.
-//    b) Bulk-copy the remote buffer into a local buffer
-//    c) Copy elements from the local buffer into the cache
+//       the data has arrived. Reset the flag to false afterwards.
+//    b) Copy elements from the local receive buffer into the cache
 //
-proc StencilArr._packedUpdate() {
-  coforall i in dom.dist.targetLocDom {
-    on dom.dist.targetLocales(i) {
-      var myLocDom = locArr[i].locDom;
+// Faces of later dimensions include fluff received in step 2, which is why
+// the dimensions must be handled in order. Every locale sends its first
+// faces without waiting, so the exchange cannot deadlock.
+//
+proc StencilArr._packedUpdateLocal(i) {
+  const myLocDom = locArr[i].locDom;
 
-      proc translateIdx(idx) {
-        return -1 * chpl__tuplify(idx);
-      }
+  proc numChunks(D) {
+    const chunkSize = max(1, D.dim(rank-1).size); // avoid divide by zero
+    return D.size / chunkSize;
+  }
 
-      // BHARSH TODO: can we fuse these two foralls? My current concern is that
-      // by waiting we might prevent another iteration running and possibly
-      // find ourselves in a deadlock.
-      forall (D, S, recvIdx, sendBufIdx) in zip(myLocDom.sendDest, myLocDom.sendSrc,
-                                                myLocDom.Neighs,
-                                                myLocDom.NeighDom) {
-        // If S.size == 0, no communication is required
-        if S.size != 0 {
-          const chunkSize  = max(1, S.dim(rank-1).size); // avoid divide by zero
-          const numChunks = S.size / chunkSize;
-          if numChunks >= stencilDistPackedUpdateMinChunks {
-            const recvBufIdx = translateIdx(sendBufIdx);
-
-            // Pack the buffer
-            //
-            // TODO: Should we have a serialization helper for N-dimensional
-            // DefaultRectangulars into 1-dimension arrays?
-            ref src = locArr[i].myElems[S];
-            ref buf = locArr[i].sendBufs[sendBufIdx];
-            local do for (s, i) in zip(src, buf.domain.first..#src.size) do buf[i] = s;
-
-            if debugStencilDist then
-              writeln("Filled ", here, ".", S, " for ", dom.dist.targetLocales(recvIdx), "::", recvBufIdx);
-            locArr[recvIdx].sendRecvFlag[recvBufIdx].write(true);
-          } else {
-            // 'naive' update
-            locArr[recvIdx].myElems[D] = locArr[i].myElems[S];
-          }
-        }
-      }
-      forall (D, S, srcIdx, recvBufIdx) in zip(myLocDom.recvDest, myLocDom.recvSrc,
-                                               myLocDom.Neighs,
-                                               myLocDom.NeighDom) {
-        const chunkSize  = max(1, S.dim(rank-1).size); // avoid divide by zero
-        const numChunks = S.size / chunkSize;
-
-        // If we did a naive update in the previous loop, this iteration does
-        // not need to do anything.
-        if S.size != 0 && numChunks >= stencilDistPackedUpdateMinChunks {
-          const srcBufIdx = translateIdx(recvBufIdx);
-          if debugStencilDist then
-            writeln(here, "::", recvBufIdx, " WAITING");
-          locArr[i].sendRecvFlag[recvBufIdx].waitFor(true); // Can we read yet?
-          locArr[i].sendRecvFlag[recvBufIdx].write(false);  // reset for next call
-
-          locArr[i].recvBufs[recvBufIdx][1..D.size] = locArr[srcIdx].sendBufs[srcBufIdx][1..D.size];
-
-          ref dest = locArr[i].myElems[D];
-          ref buf = locArr[i].recvBufs[recvBufIdx];
-          local do for (d, i) in zip(dest, buf.domain.first..#dest.size) do d = buf[i];
-        }
-      }
+  proc sendFace(L) {
+    const S = myLocDom.faceSendSrc[L];
+
+    // If S.size == 0, no communication is required
+    if S.size == 0 then return;
+
+    const N = myLocDom.Neighs[L];
+    const recvBufIdx = -1 * L;
+
+    if numChunks(S) >= stencilDistPackedUpdateMinChunks {
+      // Pack the buffer
+      //
+      // TODO: Should we have a serialization helper for N-dimensional
+      // DefaultRectangulars into 1-dimension arrays?
+      ref src = locArr[i].myElems[S];
+      ref buf = locArr[i].sendBufs[L];
+      local do for (s, j) in zip(src, buf.domain.first..#src.size) do buf[j] = s;
+
+      locArr[N].recvBufs[recvBufIdx][1..S.size] = buf[1..S.size];
+    } else {
+      // 'naive' update
+      const D = myLocDom.faceSendDest[L];
+      locArr[N].myElems[D] = locArr[i].myElems[S];
+    }
+
+    if debugStencilDist then
+      writeln("Sent ", here, ".", S, " to ", dom.dist.targetLocales(N), "::", recvBufIdx);
+    locArr[N].sendRecvFlag[recvBufIdx].write(true);
+  }
+
+  proc recvFace(L) {
+    const D = myLocDom.faceRecvDest[L];
+    if D.size == 0 then return;
+
+    if debugStencilDist then
+      writeln(here, "::", L, " WAITING");
+    locArr[i].sendRecvFlag[L].waitFor(true); // Has the data arrived?
+    locArr[i].sendRecvFlag[L].write(false);  // reset for next call
+
+    // If the sender did a naive update, the data is already in place.
+    if numChunks(D) >= stencilDistPackedUpdateMinChunks {
+      ref dest = locArr[i].myElems[D];
+      ref buf = locArr[i].recvBufs[L];
+      local do for (d, j) in zip(dest, buf.domain.first..#dest.size) do d = buf[j];
+    }
+  }
+
+  for param d in 0..rank-1 {
+    const lo = unitNeigh(rank, d, -1),
+          hi = unitNeigh(rank, d, 1);
+    cobegin {
+      sendFace(lo);
+      sendFace(hi);
+    }
+    cobegin {
+      recvFace(lo);
+      recvFace(hi);
     }
   }
 }
@@ -1695,6 +1826,24 @@ proc StencilArr.shouldDoPackedUpdate() param : bool {
          chpl__supportedDataTypeForBulkTransfer(eltType);
 }
 
+//
+// Update the cache on locale 'i'. Every locale must make the same choice
+// between the packed and naive updates, since the packed update waits on
+// its neighbors.
+//
+// TODO: Checking for 'dom.dist.targetLocales.size' isn't the most general
+// approach. What we really want is to do a naive transfer if the periodic
+// neighbor is the current locale.
+//
+proc StencilArr._updateLocalFluff(i) {
+  if shouldDoPackedUpdate() && dom.dist.targetLocales.size > 1 &&
+     locArr[i].locDom.faceExchangeOk {
+    _packedUpdateLocal(i);
+  } else {
+    _naiveUpdateLocal(i);
+  }
+}
+
 // Update caches
 //
 // TODO: allow a bool argument here?
@@ -1705,17 +1854,59 @@ proc StencilArr.shouldDoPackedUpdate() param : bool {
 // TODO: What if this is called from a locale not in targetLocales? Should
 // we do an on-statement?
 //
-// TODO: Checking for 'dom.dist.targetLocales.size' isn't the most general
-// approach. What we really want is to do a naive transfer if the periodic
-// neighbor is the current locale.
-//
 proc StencilArr.updateFluff() {
   if isZeroTuple(dom.fluff) then return;
 
-  if shouldDoPackedUpdate() && dom.dist.targetLocales.size > 1 {
-    this._packedUpdate();
-  } else {
-    this.naiveUpdateFluff();
+  coforall i in dom.dist.targetLocDom {
+    on dom.dist.targetLocales(i) {
+      _updateLocalFluff(i);
+    }
+  }
+}
+
+//
+// Start updating the caches in the background. The update runs in a task
+// on each locale, and finishFluffUpdate() waits for those tasks, so that
+// computation that does not read the cached elements can overlap the
+// communication.
+//
+proc StencilArr.startFluffUpdate() {
+  if isZeroTuple(dom.fluff) then return;
+
+  coforall i in dom.dist.targetLocDom {
+    on dom.dist.targetLocales(i) {
+      const myLocArr = locArr[i];
+      if myLocArr.fluffPending then
+        halt("startFluffUpdate() called while a fluff update is in progress");
+      myLocArr.fluffPending = true;
+
+      // 'i' is a tuple, so copy it into the task rather than capturing a
+      // reference to this task's index.
+      begin with (in i) {
+        _updateLocalFluff(i);
+        myLocArr.fluffDone.write(true);
+      }
+    }
+  }
+}
+
+//
+// Wait for the update begun by startFluffUpdate() to complete on every
+// locale.
+//
+proc StencilArr.finishFluffUpdate() {
+  if isZeroTuple(dom.fluff) then return;
+
+  coforall i in dom.dist.targetLocDom {
+    on dom.dist.targetLocales(i) {
+      const myLocArr = locArr[i];
+      if !myLocArr.fluffPending then
+        halt("finishFluffUpdate() called without a matching startFluffUpdate()");
+
+      myLocArr.fluffDone.waitFor(true);
+      myLocArr.fluffDone.write(false);
+      myLocArr.fluffPending = false;
+    }
   }
 }
 
@@ -692,6 +692,16 @@ module ChapelArray {
     return D;
   }
 
+  //
+  // {A}, where A is an array, builds an associative domain over the
+  // elements of A, adding them with a single bulk insertion.
+  //
+  proc chpl__buildDomainExpr(keys: [], definedConst) {
+    var D: domain(keys.eltType);
+    D.bulkAdd(keys);
+    return D;
+  }
+
   //
   // Support for domain expressions within array types, e.g. [1..n], [D]
   //
@@ -1656,6 +1666,20 @@ module ChapelArray {
       return _value.dsiBulkAdd(inds, dataSorted, isUnique, preserveInds, addOn);
     }
 
+    pragma "no doc"
+    proc ref bulkAdd(inds: [] _value.idxType) where isAssociativeDom(this) {
+      if inds.size == 0 then return 0;
+
+      if __primitive("method call resolves", _value, "dsiBulkAdd", inds) {
+        return _value.dsiBulkAdd(inds);
+      } else {
+        var numAdded = 0;
+        forall i in inds with (+ reduce numAdded) do
+          numAdded += _value.dsiAdd(i);
+        return numAdded;
+      }
+    }
+
     /*
      Creates an index buffer which can be used for faster index addition.
 
@@ -1703,11 +1727,9 @@ module ChapelArray {
        some cases, expensive operations can be avoided by setting those flags.
        To do so, ``bulkAdd`` must be called explicitly (instead of ``+=``).
 
-       .. note::
-
-         Right now, this method and the corresponding ``+=`` operator are
-         only available for sparse domains. In the future, we expect that
-         these methods will be available for all irregular domains.
+       For associative domains, ``bulkAdd`` and ``+=`` resize the domain at
+       most once and insert large arrays of indices in parallel. The flags
+       below only apply to sparse domains.
 
        .. note::
 
@@ -1736,7 +1758,7 @@ module ChapelArray {
        :returns: Number of indices added to the domain
        :rtype: int
     */
-    proc ref bulkAdd(inds: [] _value.rank*_value.idxType,
+    proc ref bulkAdd(inds: [] rank*_value.idxType,
         dataSorted=false, isUnique=false, preserveInds=true, addOn=nilLocale)
         where isSparseDom(this) && _value.rank>1 {
 
@@ -3331,6 +3353,12 @@ module ChapelArray {
       return _value.doiScan(op, this.domain);
     }
 
+    pragma "no doc"
+    proc _scan(op) where !Reflection.canResolveMethod(_value, "doiScan", op, this.domain) &&
+                         isRectangularArr(this) && chpl__scanStateResTypesMatch(op) {
+      return chpl__scanRectangular(op, this);
+    }
+
     proc iteratorYieldsLocalElements() param {
       return _value.dsiIteratorYieldsLocalElements();
     }
@@ -3587,6 +3615,17 @@ module ChapelArray {
         a.add(e);
   }
 
+  /*
+     Adds the indices in an array to an associative domain in bulk. The
+     domain's storage is resized at most once, and large arrays of indices
+     are inserted in parallel. Indices that are already in the domain, or
+     that appear more than once in the array, are only added once.
+  */
+  proc +=(ref D: domain, inds: [] index(D)) where isAssociativeDom(D) {
+    D.bulkAdd(inds);
+  }
+
+
   //
   // BaseSparseDom operator overloads
   //
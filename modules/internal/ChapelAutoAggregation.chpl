@@ -60,6 +60,20 @@ module ChapelAutoAggregation {
     return nil;  // return type signals that we shouldn't aggregate
   }
 
+  // these are for updates like `A[i] += x`, `op` is the name of the operator
+  pragma "aggregator generator"
+  proc chpl_dstAggregatorFor(arr: [], param op: string) {
+    if isNumericType(arr.eltType) || isBoolType(arr.eltType) then
+      return new DstAggregator(arr.eltType, op);
+    else
+      return nil;
+  }
+
+  pragma "aggregator generator"
+  proc chpl_dstAggregatorFor(arr, param op: string) {
+    return nil;  // return type signals that we shouldn't aggregate
+  }
+
   proc chpl__arrayIteratorYieldsLocalElements(x) param {
     if isArray(x) {
       if !isClass(x.eltType) { // I have no idea if we can do this for wide pointers
@@ -91,9 +105,16 @@ module ChapelAutoAggregation {
      * Aggregates copy(ref dst, src). Optimized for when src is local.
      * Not parallel safe and is expected to be created on a per-task basis
      * High memory usage since there are per-destination buffers
+     *
+     * If op is a compound assignment like "+=", update(ref dst, src) applies
+     * it on the locale that owns dst instead of copying. The update is not
+     * atomic: buffers from different aggregators may be applied to the same
+     * dst at once, so concurrent updates to one element race, just as the
+     * unaggregated `op=` would.
      */
     record DstAggregator {
       type elemType;
+      param op = "=";
       type aggType = (c_ptr(elemType), elemType);
       const bufferSize = dstBuffSize;
       const myLocaleSpace = LocaleSpace;
@@ -122,6 +143,21 @@ module ChapelAutoAggregation {
         if verboseAggregation {
           writeln("DstAggregator.copy is called");
         }
+        _bufferOp(dst, srcVal);
+      }
+
+      // Buffers `dst op= srcVal`, which is applied non-atomically when the
+      // buffer for dst's locale is flushed
+      inline proc update(ref dst: elemType, const in srcVal: elemType) {
+        if op == "=" then
+          compilerError("DstAggregator.update needs a compound assignment");
+        if verboseAggregation {
+          writeln("DstAggregator.update is called");
+        }
+        _bufferOp(dst, srcVal);
+      }
+
+      inline proc _bufferOp(ref dst: elemType, const in srcVal: elemType) {
         // Get the locale of dst and the local address on that locale
         const loc = dst.locale.id;
         const dstAddr = getAddr(dst);
@@ -161,7 +197,7 @@ module ChapelAutoAggregation {
         // Process remote buffer
         on Locales[loc] {
           for (dstAddr, srcVal) in rBuffer.localIter(remBufferPtr, myBufferIdx) {
-            dstAddr.deref() = srcVal;
+            _applyOp(dstAddr.deref(), srcVal);
           }
           if freeData {
             rBuffer.localFree(remBufferPtr);
@@ -172,6 +208,15 @@ module ChapelAutoAggregation {
         }
         bufferIdx = 0;
       }
+
+      inline proc _applyOp(ref dst: elemType, srcVal: elemType) {
+        if op == "+=" then dst += srcVal;
+        else if op == "-=" then dst -= srcVal;
+        else if op == "&=" then dst &= srcVal;
+        else if op == "|=" then dst |= srcVal;
+        else if op == "^=" then dst ^= srcVal;
+        else dst = srcVal;
+      }
     }
 
 
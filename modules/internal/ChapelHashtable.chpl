@@ -144,6 +144,67 @@ module ChapelHashtable {
     }
   }
 
+  // #### parallel insertion helpers ####
+
+  // Rehashing and bulk addition can place keys from many tasks at once.
+  // Since the table entries themselves are not atomic, each task first
+  // claims its destination slot in a separate array of atomics. A slot's
+  // claim is free, busy while a key is being moved into it, or done once
+  // its key can be compared against.
+  private param claimFree = 0:uint(8);
+  private param claimBusy = 1:uint(8);
+  private param claimDone = 2:uint(8);
+
+  private proc claimType type return chpl__processorAtomicType(uint(8));
+
+  // Tables with fewer keys than this are filled by a single task, since
+  // starting tasks would cost more than it saves.
+  private param parallelInsertMinKeys = 1 << 14;
+
+  private proc _allocateClaims(size: int) {
+    return _ddata_allocate(claimType, size);
+  }
+
+  private proc _freeClaims(claims, size: int) {
+    _ddata_free(claims, size);
+  }
+
+  // #### control byte helpers ####
+
+  // Besides its status, each slot has a control byte that is empty,
+  // deleted, or for a full slot, the high bit plus 7 bits of the key's
+  // hash. Probing compares a group of control bytes at once (see
+  // runtime/include/chpl-hashtable.h) and only compares keys in the slots
+  // whose hash bits match.
+  //
+  // The control bytes for the first group of slots are repeated after
+  // the last slot so that a group starting near the end can be read
+  // without wrapping around.
+  private param groupWidth = 16;
+  private param ctrlEmpty = 0:uint(8);
+  private param ctrlDeleted = 1:uint(8);
+
+  // The default hashes for short strings and the like leave the top bits
+  // zero, so mix all of the bits into the ones used for the tag.
+  private inline proc _ctrlTag(h: uint): uint(8) {
+    return (0x80 | ((h * 0x9E3779B97F4A7C15) >> 57)):uint(8);
+  }
+
+  pragma "fn synchronization free"
+  private extern proc chpl_hashtable_match_byte(ctrl: c_ptr(uint(8)),
+                                                b: uint(8)): uint(32);
+  pragma "fn synchronization free"
+  private extern proc chpl_hashtable_match_high_clear(ctrl: c_ptr(uint(8))):
+                                                      uint(32);
+  private extern proc chpl_bitops_ctz_32(x: uint(32)): uint(32);
+  private extern proc chpl_bitops_clz_32(x: uint(32)): uint(32);
+
+  private proc _freeCtrl(ctrl, size: int) {
+    if ctrl != nil {
+      _ddata_free(ctrl, size + groupWidth);
+    }
+  }
+
   // #### deinit helpers ####
   private proc _typeNeedsDeinit(type t) param {
     return __primitive("needs auto destroy", t);
@@ -267,6 +328,7 @@ module ChapelHashtable {
     var tableSizeNum: int;
     var tableSize: int;
     var table: _ddata(chpl_TableEntry(keyType, valType)); // 0..<tableSize
+    var ctrl: _ddata(uint(8)); // 0..<tableSize+groupWidth
 
     var rehashHelpers: owned chpl__rehashHelpers?;
 
@@ -289,6 +351,7 @@ module ChapelHashtable {
       // This allows them to be empty, but the key and val
       // are considered uninitialized.
       this.table = allocateTable(this.tableSize);
+      this.ctrl = allocateCtrl(this.tableSize);
     }
     proc deinit() {
       // Go through the full slots in the current table and run
@@ -312,8 +375,9 @@ module ChapelHashtable {
         }
       }
 
-      // Free the buffer
+      // Free the buffers
       _freeData(table, tableSize);
+      _freeCtrl(ctrl, tableSize);
     }
 
     // #### iteration helpers ####
@@ -355,6 +419,78 @@ module ChapelHashtable {
 
     // #### add & remove helpers ####
 
+    inline proc _hashOf(const ref key: keyType): uint {
+      return chpl__defaultHashWrapper(key):uint;
+    }
+
+    // Sets the control byte for 'slot', along with its copy past the
+    // end of the table if it has one
+    inline proc _setCtrl(slot: int, c: uint(8)) {
+      ctrl[slot] = c;
+      if slot < groupWidth then
+        ctrl[tableSize + slot] = c;
+    }
+
+    inline proc _ctrlIsLocal(): bool {
+      return _local ||
+             chpl_nodeFromLocaleID(__primitive("_wide_get_locale", ctrl)) ==
+             chpl_nodeID;
+    }
+
+    // Returns a mask with bit i set when the control byte for slot pos+i
+    // is 'b'
+    inline proc _matchGroup(pos: int, b: uint(8)): uint(32) {
+      if _ctrlIsLocal() {
+        return chpl_hashtable_match_byte(c_ptrTo(ctrl[pos]), b);
+      } else {
+        var mask = 0:uint(32);
+        for i in 0..#groupWidth do
+          if ctrl[pos+i] == b then mask |= 1:uint(32) << i;
+        return mask;
+      }
+    }
+
+    // Returns a mask with bit i set when slot pos+i is empty or deleted
+    inline proc _matchAvailable(pos: int): uint(32) {
+      if _ctrlIsLocal() {
+        return chpl_hashtable_match_high_clear(c_ptrTo(ctrl[pos]));
+      } else {
+        var mask = 0:uint(32);
+        for i in 0..#groupWidth do
+          if ctrl[pos+i] & 0x80 == 0 then mask |= 1:uint(32) << i;
+        return mask;
+      }
+    }
+
+    // Returns the slot for the lowest bit set in 'mask', a nonzero mask
+    // for the group starting at 'pos'
+    inline proc _groupSlot(pos: int, mask: uint(32)): int {
+      var slot = pos + chpl_bitops_ctz_32(mask):int;
+      if slot >= tableSize then slot -= tableSize;
+      return slot;
+    }
+
+    // Yields the first slot of each group to probe for hash 'h'.
+    // The groups follow one another, so together they cover the table.
+    iter _probeGroups(h: uint, numSlots = tableSize) {
+      if numSlots == 0 then return;
+      var pos = (h % numSlots:uint):int;
+      for 0..#(numSlots + groupWidth - 1) / groupWidth {
+        yield pos;
+        pos += groupWidth;
+        if pos >= numSlots then pos -= numSlots;
+      }
+    }
+
+    // Yields the slots to probe for hash 'h', one at a time
+    iter _probeSlots(h: uint, numSlots = tableSize) {
+      for pos in _probeGroups(h, numSlots) {
+        for i in 0..#groupWidth {
+          yield (pos + i) % numSlots;
+        }
+      }
+    }
+
     // Searches for 'key' in a filled slot.
     //
     // Returns (filledSlotFound, slot)
@@ -362,38 +498,46 @@ module ChapelHashtable {
     // slot will be the matching filled slot in that event.
     //
     // If no matching slot was found, slot will store an
-    // empty slot that may be re-used for faster addition to the domain
-    //
-    // This function never returns deleted slots.
+    // empty or deleted slot that may be re-used for faster addition
+    // to the domain, or -1 if there is none.
     proc _findSlot(key: keyType) : (bool, int) {
+      return _findSlot(key, _hashOf(key));
+    }
+    proc _findSlot(key: keyType, h: uint) : (bool, int) {
+      const tag = _ctrlTag(h);
       var firstOpen = -1;
-      for slotNum in _lookForSlots(key) {
-        const slotStatus = table[slotNum].status;
-        // if we encounter a slot that's empty, our element could not
-        // be found past this point.
-        if (slotStatus == chpl__hash_status.empty) {
-          if firstOpen == -1 then firstOpen = slotNum;
-          return (false, firstOpen);
-        } else if (slotStatus == chpl__hash_status.full) {
-          if (table[slotNum].key == key) {
+      for pos in _probeGroups(h) {
+        // only compare keys whose hash bits match
+        var matches = _matchGroup(pos, tag);
+        while matches != 0 {
+          const slotNum = _groupSlot(pos, matches);
+          if table[slotNum].key == key {
             return (true, slotNum);
           }
-        } else { // this entry was removed, but is the first slot we could use
-          if firstOpen == -1 then firstOpen = slotNum;
+          matches &= matches - 1;
+        }
+        if firstOpen == -1 {
+          const available = _matchAvailable(pos);
+          if available != 0 then firstOpen = _groupSlot(pos, available);
+        }
+        // if we encounter a group with an empty slot, our element could
+        // not be found past this point.
+        if _matchGroup(pos, ctrlEmpty) != 0 {
+          return (false, firstOpen);
         }
       }
-      return (false, -1);
+      return (false, firstOpen);
     }
 
-    pragma "order independent yielding loops"
-    iter _lookForSlots(key: keyType, numSlots = tableSize) {
-      const baseSlot = chpl__defaultHashWrapper(key):uint;
-      if numSlots == 0 then return;
-      for probe in 0..numSlots/2 {
-        var uprobe = probe:uint;
-        var n = numSlots:uint;
-        yield ((baseSlot + uprobe**2)%n):int;
+    // Returns the first empty slot for hash 'h'. Only for use when the
+    // table has no deleted slots and the key is known to be absent.
+    proc _firstEmptySlot(h: uint): int {
+      for pos in _probeGroups(h) {
+        const empties = _matchGroup(pos, ctrlEmpty);
+        if empties != 0 then
+          return _groupSlot(pos, empties);
       }
+      return -1;
     }
 
     // add pattern:
@@ -409,7 +553,14 @@ module ChapelHashtable {
       var foundSlot = false;
 
       if (tableNumFullSlots+tableNumDeletedSlots+1)*2 > tableSize {
-        resize(grow=true);
+        if tableNumDeletedSlots > 0 &&
+           (tableNumFullSlots+1)*8 <= tableSize*3 && !postponeResize {
+          // The full slots alone would leave the table well under half
+          // full, so remove the deleted slots instead of growing it.
+          rehash(tableSizeNum, tableSize);
+        } else {
+          resize(grow=true);
+        }
       }
 
       // Note that when adding elements, if a deleted slot is encountered,
@@ -440,9 +591,10 @@ module ChapelHashtable {
       }
     }
 
-    proc fillSlot(ref tableEntry: chpl_TableEntry(keyType, valType),
+    proc fillSlot(slotNum: int,
                   in key: keyType,
                   in val: valType) {
+      ref tableEntry = table[slotNum];
       if tableEntry.status == chpl__hash_status.full {
         _deinitSlot(tableEntry);
       } else {
@@ -450,6 +602,7 @@ module ChapelHashtable {
           tableNumDeletedSlots -= 1;
         }
         tableNumFullSlots += 1;
+        _setCtrl(slotNum, _ctrlTag(_hashOf(key)));
       }
 
       tableEntry.status = chpl__hash_status.full;
@@ -457,12 +610,6 @@ module ChapelHashtable {
       _moveInit(tableEntry.key, key);
       _moveInit(tableEntry.val, val);
     }
-    proc fillSlot(slotNum: int,
-                  in key: keyType,
-                  in val: valType) {
-      ref tableEntry = table[slotNum];
-      fillSlot(tableEntry, key, val);
-    }
 
     // remove pattern:
     //   findFullSlot
@@ -484,23 +631,42 @@ module ChapelHashtable {
     // Clears a slot that is full
     // (Should not be called on empty/deleted slots)
     // Returns the key and value that were removed in the out arguments
-    proc clearSlot(ref tableEntry: chpl_TableEntry(keyType, valType),
-                   out key: keyType, out val: valType) {
+    proc clearSlot(slotNum: int, out key: keyType, out val: valType) {
       // move the table entry into the key/val variables to be returned
+      ref tableEntry = table[slotNum];
       key = _moveToReturn(tableEntry.key);
       val = _moveToReturn(tableEntry.val);
 
-      // set the slot status to deleted
-      tableEntry.status = chpl__hash_status.deleted;
+      // A probe only continues past a group with no empty slots. If the
+      // run of non-empty slots around this one is shorter than a group,
+      // no probe has gone past it, so it can be empty again rather than
+      // deleted.
+      const emptyBefore = _matchGroup((slotNum + tableSize - groupWidth) %
+                                      tableSize, ctrlEmpty);
+      const emptyAfter = _matchGroup(slotNum, ctrlEmpty);
+      if emptyBefore != 0 && emptyAfter != 0 &&
+         chpl_bitops_ctz_32(emptyAfter) +
+         (chpl_bitops_clz_32(emptyBefore) - 16) < groupWidth {
+        _setCtrl(slotNum, ctrlEmpty);
+        tableEntry.status = chpl__hash_status.empty;
+      } else {
+        _setCtrl(slotNum, ctrlDeleted);
+        tableEntry.status = chpl__hash_status.deleted;
+        tableNumDeletedSlots += 1;
+      }
 
       // update the table counts
       tableNumFullSlots -= 1;
-      tableNumDeletedSlots += 1;
     }
-    proc clearSlot(slotNum: int, out key: keyType, out val: valType) {
-      // move the table entry into the key/val variables to be returned
-      ref tableEntry = table[slotNum];
-      clearSlot(tableEntry, key, val);
+
+    // Marks every slot empty. Only for use once no slot is full.
+    proc clearDeletedSlots() {
+      for slot in _allSlots(tableSize) {
+        table[slot].status = chpl__hash_status.empty;
+      }
+      if ctrl != nil then
+        c_memset(c_ptrTo(ctrl[0]), ctrlEmpty, tableSize + groupWidth);
+      tableNumDeletedSlots = 0;
     }
 
     proc maybeShrinkAfterRemove() {
@@ -545,6 +711,14 @@ module ChapelHashtable {
         return _allocateData(size, chpl_TableEntry(keyType, valType));
       }
     }
+    proc allocateCtrl(size:int) {
+      if size == 0 {
+        return nil;
+      } else {
+        // _ddata_allocate zeroes the bytes, so every slot starts out empty
+        return _ddata_allocate(uint(8), size + groupWidth);
+      }
+    }
 
     // newSize is the new table size
     // newSizeNum is an index into chpl__primes == newSize
@@ -553,6 +727,7 @@ module ChapelHashtable {
       // save the old table
       var oldSize = tableSize;
       var oldTable = table;
+      var oldCtrl = ctrl;
 
       tableSizeNum = newSizeNum;
       tableSize = newSize;
@@ -566,6 +741,7 @@ module ChapelHashtable {
         }
 
         table = allocateTable(tableSize);
+        ctrl = allocateCtrl(tableSize);
 
         if rehashHelpers != nil then
           rehashHelpers!.startRehash(tableSize);
@@ -576,32 +752,29 @@ module ChapelHashtable {
 
         // Move old data into newly resized table
         //
-        // It would be nice if this could be done in parallel
-        // but it's possible that multiple old keys will go to the
-        // same position in the new array which would lead to data
-        // races. So it's not as simple as using forall here.
-        for oldslot in _allSlots(oldSize) {
-          if oldTable[oldslot].status == chpl__hash_status.full {
-            ref oldEntry = oldTable[oldslot];
-            // find a destination slot
-            var (foundSlot, newslot) = _findSlot(oldEntry.key);
-            if foundSlot {
-              halt("duplicate element found while resizing for key");
+        // Multiple old keys can probe the same position in the new table,
+        // so when this is done in parallel each task claims its destination
+        // slot before moving an entry into it.
+        if shouldAddInParallel(entries) {
+          var claims = _allocateClaims(tableSize);
+          forall oldslot in _allSlots(oldSize) {
+            if oldTable[oldslot].status == chpl__hash_status.full {
+              const h = _hashOf(oldTable[oldslot].key);
+              const newslot = _claimSlotForRehash(claims, h);
+              _moveEntryDuringRehash(oldTable, oldslot, newslot, _ctrlTag(h));
             }
-            if newslot < 0 {
-              halt("couldn't add element during resize - got slot ", newslot,
-                   " for key");
+          }
+          _freeClaims(claims, tableSize);
+        } else {
+          for oldslot in _allSlots(oldSize) {
+            if oldTable[oldslot].status == chpl__hash_status.full {
+              // find a destination slot; the keys are distinct and
+              // nothing has been deleted, so there is no need to compare
+              // them
+              const h = _hashOf(oldTable[oldslot].key);
+              const newslot = _firstEmptySlot(h);
+              _moveEntryDuringRehash(oldTable, oldslot, newslot, _ctrlTag(h));
             }
-
-            // move the key and value from the old entry into the new one
-            ref dstSlot = table[newslot];
-            dstSlot.status = chpl__hash_status.full;
-            _moveInit(dstSlot.key, _moveToReturn(oldEntry.key));
-            _moveInit(dstSlot.val, _moveToReturn(oldEntry.val));
-
-            // move array elements to the new location
-            if rehashHelpers != nil then
-              rehashHelpers!.moveElementDuringRehash(oldslot, newslot);
           }
         }
 
@@ -610,6 +783,7 @@ module ChapelHashtable {
 
         // delete the old allocation
         _freeData(oldTable, oldSize);
+        _freeCtrl(oldCtrl, oldSize);
 
       } else {
         // There were no entries, so just make a new allocation
@@ -622,12 +796,129 @@ module ChapelHashtable {
 
         // delete the old allocation
         _freeData(oldTable, oldSize);
+        _freeCtrl(oldCtrl, oldSize);
 
         table = allocateTable(tableSize);
+        ctrl = allocateCtrl(tableSize);
         tableNumDeletedSlots = 0;
       }
     }
 
+    // Moves the entry in 'oldslot' of 'oldTable' into the empty 'newslot'
+    // of the current table, along with any array elements for it.
+    proc _moveEntryDuringRehash(oldTable, oldslot: int, newslot: int,
+                                tag: uint(8)) {
+      if newslot < 0 {
+        halt("couldn't add element during resize - got slot ", newslot,
+             " for key");
+      }
+
+      // move the key and value from the old entry into the new one
+      ref oldEntry = oldTable[oldslot];
+      ref dstSlot = table[newslot];
+      dstSlot.status = chpl__hash_status.full;
+      _setCtrl(newslot, tag);
+      _moveInit(dstSlot.key, _moveToReturn(oldEntry.key));
+      _moveInit(dstSlot.val, _moveToReturn(oldEntry.val));
+
+      // move array elements to the new location
+      if rehashHelpers != nil then
+        rehashHelpers!.moveElementDuringRehash(oldslot, newslot);
+    }
+
+    // Returns the first slot along the probe sequence for hash 'h' that no
+    // other task has claimed. The keys being rehashed are distinct, so the
+    // slots claimed before it never need to be compared against.
+    proc _claimSlotForRehash(claims, h: uint): int {
+      for slot in _probeSlots(h) {
+        ref claim = claims[slot];
+        if claim.read() == claimFree &&
+           claim.compareAndSwap(claimFree, claimDone) {
+          return slot;
+        }
+      }
+      return -1;
+    }
+
+    // Returns whether adding 'numKeys' keys, by rehashing or by bulk
+    // addition, should use multiple tasks.
+    proc shouldAddInParallel(numKeys: int): bool {
+      return rootLocaleInitialized && numKeys >= parallelInsertMinKeys;
+    }
+
+    // bulk add pattern:
+    //   prepareForBulkAdd
+    //   if shouldAddInParallel:
+    //     startBulkAdd
+    //     bulkFillSlot, from any number of tasks
+    //     finishBulkAdd
+    //   else the add pattern above
+
+    // Grows the table once so that 'numKeys' more keys fit without another
+    // resize, and removes any deleted slots.
+    proc prepareForBulkAdd(numKeys: int) {
+      const needed = tableNumFullSlots + numKeys;
+      if (needed + 1) * 2 > tableSize {
+        const primeLoc = _findPrimeSizeIndex(needed);
+        rehash(primeLoc, chpl__primes(primeLoc));
+      } else if tableNumDeletedSlots > 0 {
+        rehash(tableSizeNum, tableSize);
+      }
+    }
+
+    // Returns the claims that bulkFillSlot uses to coordinate tasks. Must
+    // follow prepareForBulkAdd, with no other changes to the table until
+    // finishBulkAdd.
+    proc startBulkAdd() {
+      var claims = _allocateClaims(tableSize);
+      forall slot in _allSlots(tableSize) {
+        if isSlotFull(slot) then
+          claims[slot].write(claimDone);
+      }
+      return claims;
+    }
+
+    // Adds 'key' with value 'val' unless it is already present. This may be
+    // called by many tasks at once between startBulkAdd and finishBulkAdd.
+    // Returns (added, slotNum).
+    proc bulkFillSlot(claims, in key: keyType, in val: valType): (bool, int) {
+      const h = _hashOf(key);
+      const tag = _ctrlTag(h);
+      for slot in _probeSlots(h) {
+        ref claim = claims[slot];
+        while true {
+          const state = claim.read();
+          if state == claimDone {
+            if ctrl[slot] == tag && table[slot].key == key then
+              return (false, slot);
+            break;
+          } else if state == claimBusy {
+            // another task is moving a key into this slot
+            chpl_task_yield();
+          } else if claim.compareAndSwap(claimFree, claimBusy) {
+            ref tableEntry = table[slot];
+            tableEntry.status = chpl__hash_status.full;
+            _setCtrl(slot, tag);
+            _moveInit(tableEntry.key, key);
+            _moveInit(tableEntry.val, val);
+            claim.write(claimDone);
+            return (true, slot);
+          }
+        }
+      }
+
+      // prepareForBulkAdd made room for every key, so this shouldn't happen
+      halt("couldn't add key -- ", tableNumFullSlots, " / ", tableSize,
+           " taken");
+      return (false, -1);
+    }
+
+    // Records the keys added since startBulkAdd and frees the claims.
+    proc finishBulkAdd(claims, numAdded: int) {
+      tableNumFullSlots += numAdded;
+      _freeClaims(claims, tableSize);
+    }
+
     proc requestCapacity(numKeys:int) {
       if tableNumFullSlots < numKeys {
 
@@ -31,11 +31,18 @@ module ChapelReduce {
   }
 
   proc chpl__scanIteratorZip(op, data) {
-    compilerWarning("scan has been serialized (see issue #12482)");
-    var arr = for d in zip((...data)) do chpl__accumgen(op, d);
+    if chpl__scanCanCaptureZip(data(0)) {
+      // Capture the zippered elements into an array shaped like the leader
+      // so that it can be scanned in parallel.
+      const arr = [d in zip((...data))] d;
+      return chpl__scanIterator(op, arr);
+    } else {
+      compilerWarning("scan has been serialized (see issue #12482)");
+      var arr = for d in zip((...data)) do chpl__accumgen(op, d);
 
-    delete op;
-    return arr;
+      delete op;
+      return arr;
+    }
   }
 
   proc chpl__scanIterator(op, data) {
@@ -43,6 +50,11 @@ module ChapelReduce {
     param supportsPar = isArray(data) && canResolveMethod(data, "_scan", op);
     if (supportsPar) {
       return data._scan(op);
+    } else if chpl__scanCanCapture(data) {
+      // Evaluate promoted expressions, ranges and domains into an array in
+      // parallel, with the distribution of their shape, and scan that.
+      const arr = chpl__scanCapture(data);
+      return chpl__scanIterator(op, arr);
     } else {
       compilerWarning("scan has been serialized (see issue #12482)");
       var arr = for d in data do chpl__accumgen(op, d);
@@ -52,6 +64,207 @@ module ChapelReduce {
     }
   }
 
+  // Can 'data' be evaluated into a rectangular array in parallel, so that
+  // the array can be scanned in parallel?
+  proc chpl__scanCanCapture(data) param return false;
+  proc chpl__scanCanCapture(data: []) param return false;
+  proc chpl__scanCanCapture(data: range(?)) param return isBoundedRange(data);
+  proc chpl__scanCanCapture(data: domain) param return isRectangularDom(data);
+  proc chpl__scanCanCapture(data: _iteratorRecord) param {
+    if chpl_iteratorHasDomainShape(data) then
+      return isSubtype(data._shape_.type, BaseRectangularDom);
+    else if chpl_iteratorHasRangeShape(data) then
+      return !chpl_iteratorFromForExpr(data) && isBoundedRange(data._shape_);
+    else
+      return false;
+  }
+
+  // Can zippered data led by 'leader' be evaluated into a rectangular array?
+  proc chpl__scanCanCaptureZip(leader) param {
+    if isArray(leader) then
+      return isRectangularArr(leader);
+    else
+      return chpl__scanCanCapture(leader);
+  }
+
+  proc chpl__scanCapture(data) {
+    if isRange(data) || isDomain(data) then
+      return [i in data] i;
+    else
+      return data;
+  }
+
+  // A parallel scan of any rectangular array, in row-major order, into a
+  // result with the same distribution. This is used for arrays without a
+  // doiScan() of their own. The array is split along its first dimension
+  // into slabs, which are contiguous in row-major order, one per target
+  // locale. Each slab is gathered onto the locale owning its first
+  // element with a bulk transfer, and scanned there by several tasks.
+  // A first pass computes the total of each task's part, the totals are
+  // then scanned, and a second pass scans each part starting from its
+  // prefix and bulk-transfers the results back.
+  proc chpl__scanRectangular(op, data) {
+    use DSIUtil;
+
+    type resType = op.generate().type;
+    const ref dom = data.domain;
+    var res = dom.buildArray(resType, initElts=!isPOD(resType));
+
+    if dom.size > 0 {
+      const dims = dom.dims();
+      const distributed = data.targetLocales().size > 1;
+      const numLocChunks = if __primitive("task_get_serial") then 1
+                           else max(1, min(dims(0).size: int,
+                                           data.targetLocales().size));
+      const tasksPerLoc = if __primitive("task_get_serial") then 1
+                          else max(1, _computeNumChunks(dom.size: int /
+                                                        numLocChunks));
+      var state: [0..#numLocChunks*tasksPerLoc] resType = op.identity;
+
+      // Take first pass, computing the total of each task's part
+      coforall l in 0..#numLocChunks with (ref state) {
+        const slab = chpl__scanSlab(dims, numLocChunks, l);
+        on data[slab.first] {
+          var myState: [0..#tasksPerLoc] resType = op.identity;
+          if distributed {
+            const store = chpl__scanStoreDom(slab);
+            var elems: [store] data.eltType;
+            elems = data[store];
+            chpl__scanReduceParts(op, elems, slab, myState);
+          } else {
+            chpl__scanReduceParts(op, data, slab, myState);
+          }
+          state[l*tasksPerLoc..#tasksPerLoc] = myState;
+        }
+      }
+
+      // Scan state vector itself, leaving each part's prefix in place
+      const metaop = op.clone();
+      var next: resType = metaop.identity;
+      for s in state {
+        s <=> next;
+        metaop.accumulateOntoState(next, s);
+      }
+      delete metaop;
+
+      // Take second pass scanning each part, adjusted by its prefix
+      coforall l in 0..#numLocChunks with (ref res) {
+        const slab = chpl__scanSlab(dims, numLocChunks, l);
+        on data[slab.first] {
+          const myState = state[l*tasksPerLoc..#tasksPerLoc];
+          if distributed {
+            const store = chpl__scanStoreDom(slab);
+            var elems: [store] data.eltType;
+            var results: [store] resType;
+            elems = data[store];
+            chpl__scanParts(op, elems, results, slab, myState);
+            res[store] = results;
+          } else {
+            chpl__scanParts(op, data, res, slab, myState);
+          }
+        }
+      }
+    }
+    if isPOD(resType) then res.dsiElementInitializationComplete();
+
+    delete op;
+    return res;
+  }
+
+  // The 'l'th of 'numChunks' slabs of the domain with dimensions 'dims',
+  // split along the first dimension
+  proc chpl__scanSlab(dims, numChunks, l) {
+    import RangeChunk;
+    var slabDims = dims;
+    slabDims(0) = RangeChunk.chunk(dims(0), numChunks, l);
+    return {(...slabDims)};
+  }
+
+  // A domain with the same indices as 'slab', but positive strides, to
+  // store a gathered slab in. Bulk transfers into negatively strided
+  // arrays are not reliable.
+  proc chpl__scanStoreDom(slab) {
+    if !slab.stridable {
+      return slab;
+    } else {
+      var storeDims: slab.rank*range(slab.idxType, stridable=true);
+      for param d in 0..slab.rank-1 {
+        const r = slab.dim(d);
+        storeDims(d) = r.alignedLow..r.alignedHigh by abs(r.stride);
+      }
+      return {(...storeDims)};
+    }
+  }
+
+  // Split the row-major positions of 'slab' among myState.size tasks, and
+  // store the total of 'src' over each task's positions in 'myState'
+  proc chpl__scanReduceParts(op, const ref src, slab, ref myState) {
+    import RangeChunk;
+    const rngs = RangeChunk.chunks(0..#slab.size: int, myState.size);
+    coforall (rng, tid) in zip(rngs, 0..) with (ref myState) {
+      const myop = op.clone();
+      for i in chpl__orderedIndices(slab, rng) do
+        myop.accumulate(src[i]);
+      myState[tid] = myop.generate();
+      delete myop;
+    }
+  }
+
+  // Scan each task's part of 'src' (as split by chpl__scanReduceParts())
+  // into 'dst', starting from the prefix in 'myState'
+  proc chpl__scanParts(op, const ref src, ref dst, slab, const ref myState) {
+    import RangeChunk;
+    const rngs = RangeChunk.chunks(0..#slab.size: int, myState.size);
+    coforall (rng, tid) in zip(rngs, 0..) with (ref dst) {
+      const myop = op.clone();
+      const myadjust = myState[tid];
+      for i in chpl__orderedIndices(slab, rng) {
+        myop.accumulate(src[i]);
+        dst[i] = myop.generate();
+        op.accumulateOntoState(dst[i], myadjust);
+      }
+      delete myop;
+    }
+  }
+
+  // Yields the indices of the rectangular domain 'dom' that are at the
+  // positions 'rng' of its row-major order
+  iter chpl__orderedIndices(dom, rng: range) {
+    param rank = dom.rank;
+    const dims = dom.dims();
+
+    if rank == 1 {
+      for o in rng do yield dims(0).orderToIndex(o);
+    } else if rng.size > 0 {
+      var pos: rank*int;
+      var idx: rank*dom.idxType;
+      var rem = rng.first;
+      for d in 0..rank-1 by -1 {
+        const dimSize = dims(d).size: int;
+        pos(d) = rem % dimSize;
+        rem /= dimSize;
+        idx(d) = dims(d).orderToIndex(pos(d));
+      }
+
+      for 1..rng.size {
+        yield idx;
+
+        // advance to the next index in row-major order
+        var d = rank-1;
+        while d >= 0 {
+          pos(d) += 1;
+          if pos(d) < dims(d).size {
+            idx(d) = dims(d).orderToIndex(pos(d));
+            break;
+          }
+          pos(d) = 0;
+          idx(d) = dims(d).first;
+          d -= 1;
+        }
+      }
+    }
+  }
+
   // helper routine to run the accumulate + generate steps of a scan
   // in an expression context.
   proc chpl__accumgen(op, d) {
@@ -61,9 +274,22 @@ module ChapelReduce {
 
   proc chpl__reduceCombine(globalOp, localOp) {
     on globalOp {
-      globalOp.l.lock();
-      globalOp.combine(localOp);
-      globalOp.l.unlock();
+      if localOp.locale == here {
+        globalOp.l.lock();
+        globalOp.combine(localOp);
+        globalOp.l.unlock();
+      } else {
+        // When the tasks of many locales combine into this op at once,
+        // fetching each one's state while holding the lock serializes
+        // them behind a round trip apiece.  Fetch it into a fresh local
+        // op first, so only the local combine happens under the lock.
+        const copyOp = globalOp.clone();
+        copyOp.combine(localOp);
+        globalOp.l.lock();
+        globalOp.combine(copyOp);
+        globalOp.l.unlock();
+        delete copyOp;
+      }
     }
   }
 
@@ -277,18 +277,17 @@ module DefaultAssociative {
       on this {
         lockTable();
         for slot in table.allSlots() {
-          ref aSlot = table.table[slot];
-          if aSlot.isFull() {
+          if table.isSlotFull(slot) {
             var tmpKey: idxType;
             var tmpVal: nothing;
-            table.clearSlot(aSlot, tmpKey, tmpVal);
+            table.clearSlot(slot, tmpKey, tmpVal);
             // deinit any array entries
             for arr in _arrs {
               arr._deinitSlot(slot);
             }
           }
-          table.table[slot].status = chpl__hash_status.empty;
         }
+        table.clearDeletedSlots();
         numEntries.write(0);
         table.maybeShrinkAfterRemove();
         unlockTable();
@@ -356,6 +355,46 @@ module DefaultAssociative {
       }
     }
 
+    // Adds all of 'inds' at once and returns the number of indices added.
+    // The table is grown a single time up front. For large inputs the
+    // indices are then inserted by a forall loop, with tasks coordinating
+    // through the table's slot claims rather than the table lock.
+    proc dsiBulkAdd(inds: [] idxType): int {
+      var numAdded = 0;
+
+      on this {
+        lockTable();
+        defer {
+          unlockTable();
+        }
+
+        table.prepareForBulkAdd(inds.size);
+
+        if table.shouldAddInParallel(inds.size) {
+          const claims = table.startBulkAdd();
+          forall idx in inds with (+ reduce numAdded) {
+            const (added, slotNum) = table.bulkFillSlot(claims, idx, none);
+            if added {
+              numAdded += 1;
+
+              // default initialize newly added array elements
+              for arr in _arrs {
+                arr._defaultInitSlot(slotNum);
+              }
+            }
+          }
+          table.finishBulkAdd(claims, numAdded);
+          numEntries.add(numAdded);
+        } else {
+          for idx in inds {
+            numAdded += _add(idx)[1];
+          }
+        }
+      }
+
+      return numAdded;
+    }
+
     // returns the number of indices removed
     proc dsiRemove(idx: idxType) {
       var retval: int;
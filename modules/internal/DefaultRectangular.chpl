@@ -1168,6 +1168,9 @@ module DefaultRectangular {
                            followThis);
       }
 
+      if localeModelHasSublocales then
+        numaDiagsSample(followThis);
+
       for i in dom.these(tag=iterKind.follower, followThis,
                          tasksPerLocale,
                          ignoreRunning,
@@ -1237,11 +1240,17 @@ module DefaultRectangular {
         if !localeModelHasSublocales {
           data = _ddata_allocate_noinit(eltType, size, callPostAlloc);
         } else {
+          const numSublocs = here.getChildCount();
           data = _ddata_allocate_noinit(eltType, size,
                                         callPostAlloc,
-                                        subloc = (if here.getChildCount() > 1
+                                        subloc = (if numSublocs > 1
                                                   then c_sublocid_all
                                                   else c_sublocid_none));
+          // The runtime sets a NUMA policy on ordinary memory, but memory
+          // that came from the comm layer is placed by first touch, so do
+          // that here before element initialization touches it serially.
+          if callPostAlloc && numSublocs > 1 && rootLocaleInitialized then
+            numaFirstTouch(numSublocs, size);
         }
 
         if initElts {
@@ -1253,6 +1262,54 @@ module DefaultRectangular {
       initShiftedData();
     }
 
+    //
+    // Touch each sublocale's share of the data from that sublocale, so
+    // the pages end up on the NUMA domain whose forall chunk will use
+    // them.  The shares follow the per-sublocale chunking done by the
+    // domain's leader iterator.
+    //
+    proc numaFirstTouch(numSublocs: int, size: intIdxType) {
+      extern proc chpl_topo_touchMemFromSubloc(p: c_void_ptr, size: size_t,
+                                               onlyInside: bool,
+                                               subloc: chpl_sublocID_t);
+      const eltSize = _ddata_sizeof_element(data);
+      coforall s in 0..#numSublocs {
+        local do on here.getChild(s) {
+          const (lo, hi) = _computeBlock(size, numSublocs, s, size-1);
+          if lo <= hi then
+            chpl_topo_touchMemFromSubloc(c_ptrTo(data[lo]):c_void_ptr,
+                                         (hi-lo+1):size_t * eltSize,
+                                         true, s:chpl_sublocID_t);
+        }
+      }
+    }
+
+    //
+    // For the NUMA diagnostics in Memory.Diagnostics: sample where the
+    // elements a follower is about to visit live, relative to the
+    // sublocale it is running on.
+    //
+    proc numaDiagsSample(followThis) {
+      extern proc chpl_topo_numaDiagsEnabled(): bool;
+      extern proc chpl_topo_numaDiagsSample(p: c_void_ptr, size: size_t,
+                                            subloc: chpl_sublocID_t);
+      if !chpl_topo_numaDiagsEnabled() then return;
+
+      var lo, hi: rank*idxType;
+      for param i in 0..rank-1 {
+        if followThis(i).size == 0 then return;
+        const r = dom.dsiDim(i);
+        lo(i) = r.orderToIndex(followThis(i).first);
+        hi(i) = r.orderToIndex(followThis(i).last);
+      }
+      const iLo = getDataIndex(lo), iHi = getDataIndex(hi);
+      const first = min(iLo, iHi), last = max(iLo, iHi);
+      chpl_topo_numaDiagsSample(c_ptrTo(theData(first)):c_void_ptr,
+                                (last-first+1):size_t
+                                  * _ddata_sizeof_element(theData),
+                                chpl_getSubloc());
+    }
+
     inline proc getDataIndex(ind: idxType ...1,
                              param getShifted = true)
       where rank == 1
@@ -2343,7 +2400,7 @@ module DefaultRectangular {
         myop.accumulate(elem);
         res[i] = myop.generate();
       }
-      state[tid] = res[rngs[tid].high];
+      state[tid] = res[rngs[tid].last];
       delete myop;
     }
 
@@ -0,0 +1,180 @@
+/*
+ * Copyright 2020-2021 Hewlett Packard Enterprise Development LP
+ * Copyright 2004-2019 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Support for collective operations between all locales.
+
+   This module provides broadcast, reduction, gather and all-to-all
+   operations in which every locale takes part, similar to
+   ``MPI_Bcast()``, ``MPI_Allreduce()``, ``MPI_Allgather()`` and
+   ``MPI_Alltoall()`` on ``MPI_COMM_WORLD``.  Each of these procedures must
+   be called by exactly one task on every locale, and all the locales must
+   call them in the same order, with the same arguments where noted.  See
+   :mod:`AllLocalesBarriers` for the corresponding barrier.
+
+   .. code-block:: chapel
+
+     use AllLocalesCollectives;
+
+     coforall loc in Locales do on loc {
+       const mySum = + reduce [i in 1..1000] (i * here.id);
+       // every locale gets the sum over all the locales
+       const total = allLocalesReduce(mySum, ReduceOp.Sum);
+     }
+
+   The implementation is dependent on the communication layer.  Where the
+   network library supplies collectives they are used; otherwise the
+   data is combined using recursive doubling, taking a number of steps
+   that grows with the logarithm of the number of locales.
+
+   These collectives only move plain old data: the reductions support
+   ``int(32)``, ``int(64)``, ``uint(32)``, ``uint(64)``, ``real(32)`` and
+   ``real(64)`` values and arrays of them, and the other operations
+   support any type for which :proc:`~Types.isPODType` is true.
+*/
+module AllLocalesCollectives {
+  private use CPtr, SysCTypes;
+
+  /* The operations that :proc:`allLocalesReduce` can apply.  The bitwise
+     operations only apply to integral types. */
+  enum ReduceOp { Sum, Prod, Min, Max, BitAnd, BitOr, BitXor };
+
+  private extern const CHPL_COMM_COLL_INT32: c_int;
+  private extern const CHPL_COMM_COLL_INT64: c_int;
+  private extern const CHPL_COMM_COLL_UINT32: c_int;
+  private extern const CHPL_COMM_COLL_UINT64: c_int;
+  private extern const CHPL_COMM_COLL_REAL32: c_int;
+  private extern const CHPL_COMM_COLL_REAL64: c_int;
+
+  private extern const CHPL_COMM_COLL_SUM: c_int;
+  private extern const CHPL_COMM_COLL_PROD: c_int;
+  private extern const CHPL_COMM_COLL_MIN: c_int;
+  private extern const CHPL_COMM_COLL_MAX: c_int;
+  private extern const CHPL_COMM_COLL_BAND: c_int;
+  private extern const CHPL_COMM_COLL_BOR: c_int;
+  private extern const CHPL_COMM_COLL_BXOR: c_int;
+
+  private extern proc chpl_comm_coll_broadcast(root: int(32), buf: c_void_ptr,
+                                               size: size_t);
+  private extern proc chpl_comm_coll_allreduce(buf: c_void_ptr, count: size_t,
+                                               eltType: c_int, op: c_int);
+  private extern proc chpl_comm_coll_allgather(src: c_void_ptr,
+                                               dst: c_void_ptr,
+                                               size: size_t);
+  private extern proc chpl_comm_coll_alltoall(src: c_void_ptr,
+                                              dst: c_void_ptr,
+                                              size: size_t);
+
+  private proc collType(type t): c_int {
+    if t == int(32) then return CHPL_COMM_COLL_INT32;
+    else if t == int(64) then return CHPL_COMM_COLL_INT64;
+    else if t == uint(32) then return CHPL_COMM_COLL_UINT32;
+    else if t == uint(64) then return CHPL_COMM_COLL_UINT64;
+    else if t == real(32) then return CHPL_COMM_COLL_REAL32;
+    else if t == real(64) then return CHPL_COMM_COLL_REAL64;
+    else compilerError("allLocalesReduce() does not support type ",
+                       t: string, 2);
+  }
+
+  private proc collOp(type t, param op: ReduceOp): c_int {
+    if isRealType(t) && (op == ReduceOp.BitAnd || op == ReduceOp.BitOr ||
+                         op == ReduceOp.BitXor) then
+      compilerError("bitwise reductions require an integral type", 2);
+    select op {
+      when ReduceOp.Sum do return CHPL_COMM_COLL_SUM;
+      when ReduceOp.Prod do return CHPL_COMM_COLL_PROD;
+      when ReduceOp.Min do return CHPL_COMM_COLL_MIN;
+      when ReduceOp.Max do return CHPL_COMM_COLL_MAX;
+      when ReduceOp.BitAnd do return CHPL_COMM_COLL_BAND;
+      when ReduceOp.BitOr do return CHPL_COMM_COLL_BOR;
+      otherwise do return CHPL_COMM_COLL_BXOR;
+    }
+  }
+
+  /* Copy `x` on locale `root` to `x` on every locale.
+
+     :arg x: the value to broadcast, on `root`, or to overwrite, elsewhere.
+             It must have the same type on every locale.
+     :arg root: the id of the locale to broadcast from, the same on every
+                locale
+   */
+  proc allLocalesBroadcast(ref x: ?t, root: int = 0) where isPODType(t) {
+    chpl_comm_coll_broadcast(root: int(32), c_ptrTo(x), c_sizeof(t));
+  }
+
+  /* Copy the elements of the local array `A` on locale `root` to `A` on
+     every locale.  `A` must have the same number of elements on every
+     locale. */
+  proc allLocalesBroadcast(ref A: [] ?t, root: int = 0) where isPODType(t) {
+    if A.size > 0 then
+      chpl_comm_coll_broadcast(root: int(32), c_ptrTo(A),
+                               A.size: size_t * c_sizeof(t));
+  }
+
+  /* Combine `x` from every locale using `op`.
+
+     :arg x: this locale's value
+     :arg op: the operation, the same on every locale
+     :returns: the combination of all the locales' values, on every locale
+   */
+  proc allLocalesReduce(x: ?t, param op: ReduceOp): t
+    where !isArrayType(t) {
+    var result = x;
+    chpl_comm_coll_allreduce(c_ptrTo(result), 1, collType(t),
+                             collOp(t, op));
+    return result;
+  }
+
+  /* Combine the elements of the local array `A` from every locale using
+     `op`, elementwise, leaving the results in `A` on every locale.  `A`
+     must have the same number of elements on every locale. */
+  proc allLocalesReduce(ref A: [] ?t, param op: ReduceOp) {
+    if A.size > 0 then
+      chpl_comm_coll_allreduce(c_ptrTo(A), A.size: size_t, collType(t),
+                               collOp(t, op));
+  }
+
+  /* Gather `x` from every locale.
+
+     :returns: an array, on every locale, whose element `i` is the value
+               of `x` on the locale with id `i`
+   */
+  proc allLocalesGather(x: ?t) where isPODType(t) {
+    var mine = x;
+    var result: [0..#numLocales] t;
+    chpl_comm_coll_allgather(c_ptrTo(mine), c_ptrTo(result), c_sizeof(t));
+    return result;
+  }
+
+  /* Exchange values between every pair of locales.  Each locale sends
+     element `j` of `src` to the locale with id `j`.
+
+     :arg src: a local array of `numLocales` elements
+     :returns: an array, on every locale, whose element `i` is the value
+               the locale with id `i` sent to this one
+   */
+  proc allLocalesAlltoall(src: [] ?t) where isPODType(t) {
+    if src.size != numLocales then
+      halt("allLocalesAlltoall() needs an element for each locale");
+    var mine: [0..#numLocales] t = src;
+    var result: [0..#numLocales] t;
+    chpl_comm_coll_alltoall(c_ptrTo(mine), c_ptrTo(result), c_sizeof(t));
+    return result;
+  }
+}
@@ -0,0 +1,479 @@
+/*
+ * Copyright 2020-2021 Hewlett Packard Enterprise Development LP
+ * Copyright 2004-2019 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+  A hash map intended to be modified by many tasks at once.
+
+  A :record:`~Map.map` created with ``parSafe=true`` protects its whole table
+  with a single lock, so every ``add`` or ``contains`` made from a ``forall``
+  loop serializes on that lock. A :class:`ConcurrentMap` instead splits its
+  keys across a number of independent segments, each of which is a separate
+  hash table guarded by its own lock. Tasks that touch keys in different
+  segments proceed in parallel, and each segment grows or shrinks on its own
+  while the rest of the map remains available.
+
+  .. code-block:: chpl
+
+    use ConcurrentMap;
+
+    record inc {
+      proc this(k, ref v) { v += 1; }
+    }
+
+    var counts = new ConcurrentMap(int, int);
+    forall x in data do
+      counts.addOrUpdate(x, 1, new inc());
+
+  Many key-value pairs can be inserted with a single call to :proc:`addAll`,
+  which consumes its arguments with a ``forall`` loop:
+
+  .. code-block:: chpl
+
+    var index = new ConcurrentMap(string, int);
+    index.addAll(names, 1..names.size);
+
+  Because every operation on a segment holds that segment's lock, an entry
+  that is removed can be destroyed right away; no task can be reading it. As
+  a result, no epoch-based reclamation is needed.
+
+  .. note::
+
+    The iterators of this class do not acquire any locks. The map should
+    not be modified while it is being iterated over.
+*/
+module ConcurrentMap {
+  import ChapelLocks;
+  private use HaltWrappers;
+  private use ChapelHashtable;
+  private use IO;
+
+  pragma "no doc"
+  record _Segment {
+    type keyType;
+    type valType;
+
+    var lock$: ChapelLocks.chpl_LocalSpinlock;
+    var table: chpl__hashtable(keyType, valType);
+
+    inline proc lock() {
+      lock$.lock();
+    }
+
+    inline proc unlock() {
+      lock$.unlock();
+    }
+  }
+
+  pragma "no doc"
+  proc _defaultNumSegments() {
+    return 4 * here.maxTaskPar;
+  }
+
+  class ConcurrentMap {
+    /* Type of map keys. */
+    type keyType;
+    /* Type of map values. */
+    type valType;
+
+    pragma "no doc"
+    const numSegments: int;
+
+    pragma "no doc"
+    var segments: [0..#numSegments] _Segment(keyType, valType);
+
+    /*
+      Initializes an empty map containing keys and values of given types.
+
+      :arg keyType: The type of the keys of this map.
+      :arg valType: The type of the values of this map.
+      :arg numSegments: A lower bound on the number of independently locked
+                        segments; it is rounded up to a power of two.
+    */
+    proc init(type keyType, type valType,
+              numSegments: int = _defaultNumSegments()) {
+      if isGenericType(keyType) then
+        compilerError("ConcurrentMap key type cannot currently be generic");
+      if isGenericType(valType) then
+        compilerError("ConcurrentMap value type cannot currently be generic");
+      if isNonNilableClass(keyType) || isNonNilableClass(valType) then
+        compilerError("ConcurrentMap does not support non-nilable classes");
+
+      if numSegments < 1 then
+        halt("ConcurrentMap requires at least one segment");
+
+      this.keyType = keyType;
+      this.valType = valType;
+
+      var n = 1;
+      while n < numSegments do n *= 2;
+      this.numSegments = n;
+    }
+
+    // The segment is chosen from the upper bits of a multiplicative mix of
+    // the hash, since each segment's table uses the hash modulo its size.
+    pragma "no doc"
+    inline proc _segmentIdx(const ref k: keyType): int {
+      const h = chpl__defaultHashWrapper(k):uint;
+      return (((h * 0x9E3779B97F4A7C15) >> 32) & (numSegments-1):uint):int;
+    }
+
+    pragma "no doc"
+    inline proc _segmentFor(const ref k: keyType) ref {
+      return segments[_segmentIdx(k)];
+    }
+
+    /*
+      The current number of keys contained in this map.
+    */
+    proc size {
+      var n = 0;
+      for seg in segments {
+        seg.lock();
+        n += seg.table.tableNumFullSlots;
+        seg.unlock();
+      }
+      return n;
+    }
+
+    /*
+      Returns `true` if this map contains zero keys.
+    */
+    proc isEmpty(): bool {
+      return size == 0;
+    }
+
+    /*
+      Returns `true` if the given key is a member of this map, and `false`
+      otherwise.
+    */
+    proc contains(const k: keyType): bool {
+      ref seg = _segmentFor(k);
+      seg.lock(); defer seg.unlock();
+      var (found, _) = seg.table.findFullSlot(k);
+      return found;
+    }
+
+    /*
+      Adds a key-value pair to the map. Does nothing if the key is already
+      present.
+
+      :returns: `true` if `k` was not in the map and was added with value `v`.
+    */
+    proc add(in k: keyType, in v: valType): bool {
+      ref seg = _segmentFor(k);
+      seg.lock(); defer seg.unlock();
+      var (found, slot) = seg.table.findAvailableSlot(k);
+      if found then
+        return false;
+      seg.table.fillSlot(slot, k, v);
+      return true;
+    }
+
+    /*
+      Sets the value associated with a key that is already in the map.
+
+      :returns: `true` if `k` was in the map and its value was set to `v`.
+    */
+    proc set(k: keyType, in v: valType): bool {
+      ref seg = _segmentFor(k);
+      seg.lock(); defer seg.unlock();
+      var (found, slot) = seg.table.findFullSlot(k);
+      if !found then
+        return false;
+      seg.table.fillSlot(slot, k, v);
+      return true;
+    }
+
+    /*
+      Adds the key `k` with value `v`, or sets its value to `v` if `k` is
+      already in the map.
+    */
+    proc addOrSet(in k: keyType, in v: valType) {
+      ref seg = _segmentFor(k);
+      seg.lock(); defer seg.unlock();
+      var (_, slot) = seg.table.findAvailableSlot(k);
+      seg.table.fillSlot(slot, k, v);
+    }
+
+    /*
+      Updates the value stored for a key in place via an updater object,
+      while holding the lock for the key's segment.
+
+      The updater object must define a `this()` method that takes the key and
+      a reference to the value. Whatever that method returns is returned
+      from `update()`. It must not call back into this map.
+
+      Halts if `k` is not in the map.
+    */
+    proc update(const ref k: keyType, updater) throws {
+      ref seg = _segmentFor(k);
+      seg.lock(); defer seg.unlock();
+
+      var (found, slot) = seg.table.findFullSlot(k);
+      if !found then
+        boundsCheckHalt("map index " + k:string + " out of bounds");
+
+      const ref key = seg.table.table[slot].key;
+      ref val = seg.table.table[slot].val;
+
+      import Reflection;
+      if !Reflection.canResolveMethod(updater, "this", key, val) then
+        compilerError('`ConcurrentMap.update()` failed to resolve method ' +
+                      updater.type:string + '.this() for arguments (' +
+                      key.type:string + ', ' + val.type:string + ')');
+
+      return updater(key, val);
+    }
+
+    /*
+      Adds the key `k` with value `v` if it is not in the map. Otherwise,
+      updates its existing value in place by calling `updater(key, val)`.
+      The check and the insertion or update happen atomically.
+
+      :returns: `true` if `k` was added, `false` if its value was updated.
+    */
+    proc addOrUpdate(in k: keyType, in v: valType, updater): bool throws {
+      ref seg = _segmentFor(k);
+      seg.lock(); defer seg.unlock();
+
+      var (found, slot) = seg.table.findAvailableSlot(k);
+      if !found {
+        seg.table.fillSlot(slot, k, v);
+        return true;
+      }
+
+      const ref key = seg.table.table[slot].key;
+      ref val = seg.table.table[slot].val;
+
+      import Reflection;
+      if !Reflection.canResolveMethod(updater, "this", key, val) then
+        compilerError('`ConcurrentMap.addOrUpdate()` failed to resolve ' +
+                      'method ' + updater.type:string + '.this() for ' +
+                      'arguments (' + key.type:string + ', ' +
+                      val.type:string + ')');
+
+      updater(key, val);
+      return false;
+    }
+
+    /*
+      Returns a copy of the value stored for `k`. Halts if `k` is not in the
+      map.
+    */
+    proc getValue(k: keyType): valType {
+      if !isCopyableType(valType) then
+        compilerError('cannot call `getValue()` for non-copyable ' +
+                      'map value type: ' + valType:string);
+
+      ref seg = _segmentFor(k);
+      seg.lock(); defer seg.unlock();
+      var (found, slot) = seg.table.findFullSlot(k);
+      if !found then
+        boundsCheckHalt("map index " + k:string + " out of bounds");
+      return seg.table.table[slot].val;
+    }
+
+    /*
+      Looks up `k` without halting when it is absent.
+
+      :returns: A tuple of whether `k` was found and a copy of its value, or
+                a default-initialized value when it was not.
+    */
+    proc tryGetValue(k: keyType): (bool, valType) {
+      if !isCopyableType(valType) then
+        compilerError('cannot call `tryGetValue()` for non-copyable ' +
+                      'map value type: ' + valType:string);
+
+      ref seg = _segmentFor(k);
+      seg.lock(); defer seg.unlock();
+      var (found, slot) = seg.table.findFullSlot(k);
+      if !found {
+        var v: valType;
+        return (false, v);
+      }
+      return (true, seg.table.table[slot].val);
+    }
+
+    /*
+      Removes the key-value pair with the given key from the map.
+
+      :returns: `false` if `k` was not in the map, `true` if it was removed.
+    */
+    proc remove(k: keyType): bool {
+      ref seg = _segmentFor(k);
+      seg.lock(); defer seg.unlock();
+      var (found, slot) = seg.table.findFullSlot(k);
+      if !found then
+        return false;
+      var outKey: keyType, outVal: valType;
+      seg.table.clearSlot(slot, outKey, outVal);
+      seg.table.maybeShrinkAfterRemove();
+      return true;
+    }
+
+    /*
+      Adds the key-value pairs in `pairs` using a ``forall`` loop, so the
+      insertions are spread over the tasks of the collection's parallel
+      iterator. Keys that are already present keep their existing values.
+
+      :arg pairs: An array or other collection with a parallel iterator that
+                  yields `(keyType, valType)` tuples.
+
+      :returns: The number of keys that were added.
+    */
+    proc addAll(pairs): int {
+      var n = 0;
+      forall (k, v) in pairs with (+ reduce n) do
+        if add(k, v) then n += 1;
+      return n;
+    }
+
+    /*
+      Adds the keys from `keys` paired with the values from `vals` using a
+      zippered ``forall`` loop led by `keys`. Both arguments must be
+      collections, such as arrays, domains or ranges, that support zippered
+      parallel iteration. Keys that are already present keep their existing
+      values.
+
+      :returns: The number of keys that were added.
+    */
+    proc addAll(keys, vals): int {
+      var n = 0;
+      forall (k, v) in zip(keys, vals) with (+ reduce n) do
+        if add(k, v) then n += 1;
+      return n;
+    }
+
+    /*
+      Removes every key-value pair from this map. This is not named
+      ``clear()`` so that it is not confused with the method of the same name
+      on ``owned`` and ``shared``, which releases the map itself.
+    */
+    proc clearAll() {
+      forall seg in segments {
+        seg.lock();
+        for slot in seg.table.allSlots() {
+          if seg.table.isSlotFull(slot) {
+            var key: keyType;
+            var val: valType;
+            seg.table.clearSlot(slot, key, val);
+          }
+        }
+        seg.table.maybeShrinkAfterRemove();
+        seg.unlock();
+      }
+    }
+
+    /*
+      Iterates over the keys of this map. This is a shortcut for :iter:`keys`.
+    */
+    iter these() const ref {
+      for key in keys() do
+        yield key;
+    }
+
+    pragma "no doc"
+    iter these(param tag: iterKind) const ref
+    where tag == iterKind.standalone {
+      forall key in keys() do
+        yield key;
+    }
+
+    /*
+      Iterates over the keys of this map.
+    */
+    iter keys() const ref {
+      for seg in segments do
+        for slot in seg.table.allSlots() do
+          if seg.table.isSlotFull(slot) then
+            yield seg.table.table[slot].key;
+    }
+
+    pragma "no doc"
+    iter keys(param tag: iterKind) const ref
+    where tag == iterKind.standalone {
+      forall seg in segments do
+        for slot in seg.table.allSlots() do
+          if seg.table.isSlotFull(slot) then
+            yield seg.table.table[slot].key;
+    }
+
+    /*
+      Iterates over the key-value pairs of this map, yielding copies as
+      tuples.
+    */
+    iter items() {
+      for seg in segments do
+        for slot in seg.table.allSlots() do
+          if seg.table.isSlotFull(slot) {
+            ref entry = seg.table.table[slot];
+            yield (entry.key, entry.val);
+          }
+    }
+
+    pragma "no doc"
+    iter items(param tag: iterKind) where tag == iterKind.standalone {
+      forall seg in segments do
+        for slot in seg.table.allSlots() do
+          if seg.table.isSlotFull(slot) {
+            ref entry = seg.table.table[slot];
+            yield (entry.key, entry.val);
+          }
+    }
+
+    /*
+      Iterates over the values of this map.
+    */
+    iter values() ref {
+      for seg in segments do
+        for slot in seg.table.allSlots() do
+          if seg.table.isSlotFull(slot) then
+            yield seg.table.table[slot].val;
+    }
+
+    pragma "no doc"
+    iter values(param tag: iterKind) ref where tag == iterKind.standalone {
+      forall seg in segments do
+        for slot in seg.table.allSlots() do
+          if seg.table.isSlotFull(slot) then
+            yield seg.table.table[slot].val;
+    }
+
+    /*
+      Writes the contents of this map to a channel. The format looks like:
+
+        .. code-block:: chapel
+
+           {k1: v1, k2: v2, .... , kn: vn}
+    */
+    proc writeThis(ch: channel) throws {
+      var first = true;
+      ch <~> "{";
+      for (k, v) in items() {
+        if first then
+          first = false;
+        else
+          ch <~> ", ";
+        ch <~> k <~> ": " <~> v;
+      }
+      ch <~> "}";
+    }
+  }
+}
@@ -32,6 +32,7 @@ module DistributedIters
 {
 use DynamicIters,
     Time,
+    ChapelLocks,
     DSIUtil;
 
 /*
@@ -568,6 +569,296 @@ where tag == iterKind.follower
   for i in current do yield i;
 }
 
+// Distributed Adaptive Iterator.
+// Serial version.
+/*
+  :arg c: The range (or domain) to iterate over. The range (domain) size must
+    be positive.
+  :type c: `range(?)` or `domain`
+
+  :arg numTasks: The number of tasks to use on each locale. Must be
+    nonnegative. If this argument has value 0, the iterator will use the value
+    indicated by ``dataParTasksPerLocale``.
+  :type numTasks: int
+
+  :arg parDim: If ``c`` is a domain, then this specifies the dimension index
+    to parallelize across. Must be non-negative and less than the rank of
+    the domain ``c``. Defaults to 0.
+  :type parDim: int
+
+  :arg minChunkSize: The smallest chunk size to split off. Must be positive.
+    Defaults to 1.
+  :type minChunkSize: int
+
+  :arg workerLocales: An array of locales over which to distribute the work.
+    Defaults to ``Locales`` (all available locales).
+  :type workerLocales: [] locale
+
+  :yields: Indices in the range ``c``.
+
+  This iterator is a distributed, hierarchical version of the ``adaptive``
+  iterator from the ``DynamicIters`` module. There is no central coordinator.
+
+  Given an input range (or domain) ``c``, the iterations are initially divided
+  evenly among the locales in ``workerLocales``, and each locale divides its
+  share evenly among its ``numTasks`` tasks. Each task repeatedly splits off
+  half of its remaining iterations (but at least ``minChunkSize``) and yields
+  them. When a task runs out of work, it steals half of the remaining
+  iterations of the other tasks on its locale, from their tail. When the
+  whole locale has run out of work, the task visits the other worker locales,
+  starting from a randomly chosen one, and steals half of the remaining
+  iterations of the most loaded task there. Stolen iterations become the
+  thief's own work, so that they can be stolen again by the tasks on its
+  locale. A task finishes when a visit to every other locale finds no work.
+
+  Available for serial and zippered contexts.
+*/
+iter distributedAdaptive(c,
+                         numTasks:int=0,
+                         parDim:int=0,
+                         minChunkSize:int=1,
+                         workerLocales=Locales)
+{
+  compilerAssert(isDomain(c) || isRange(c),
+                 ("DistributedIters: Adaptive iterator (serial): must use a "
+                  + "valid domain or range"),
+                 1);
+  if debugDistributedIters
+  then writeln("DistributedIters: Adaptive iterator (serial): working with ",
+               (if isDomain(c) then "domain " else "range "), c);
+  for i in c do yield i;
+}
+
+// Zippered leader.
+pragma "no doc"
+iter distributedAdaptive(param tag:iterKind,
+                         c,
+                         numTasks:int=0,
+                         parDim:int=0,
+                         minChunkSize:int=1,
+                         workerLocales=Locales)
+where tag == iterKind.leader
+{
+  compilerAssert(isDomain(c) || isRange(c),
+                 ("DistributedIters: Adaptive iterator (leader): must use a "
+                  + "valid domain or range"),
+                 1);
+  assert(minChunkSize > 0,
+         ("DistributedIters: Adaptive iterator (leader): "
+          + "minChunkSize must be a positive integer"));
+
+  type cType = c.type;
+
+  if isDomain(c) then
+  {
+    assert(c.rank > 0, ("DistributedIters: Adaptive iterator (leader): "
+                        + "Must use a valid domain"));
+    assert(parDim >= 0, ("DistributedIters: Adaptive iterator (leader): "
+                        + "parDim must be a non-negative integer"));
+    assert(parDim < c.rank, ("DistributedIters: Adaptive iterator (leader): "
+                              + "parDim must be a dimension of the domain"));
+    var parDimDim = c.dim(parDim);
+    for t in distributedAdaptive(tag=iterKind.leader,
+                                 c=parDimDim,
+                                 numTasks=numTasks,
+                                 parDim=0,
+                                 minChunkSize=minChunkSize,
+                                 workerLocales=workerLocales)
+    {
+      // Set the new range based on the tuple the adaptive 1-D iterator yields.
+      var newRange = t(0);
+
+      // Does the same thing as densify, but densify makes a stridable domain,
+      // which mismatches here if c (and thus cType) is non-stridable.
+      var tempDom : cType = computeZeroBasedDomain(c);
+
+      // Rank-change slice the domain along parDim
+      var tempTup = tempDom.dims();
+      // Change the value of the parDim elem of the tuple to the new range
+      tempTup(parDim) = newRange;
+
+      yield tempTup;
+    }
+  }
+  else // c is a range.
+  {
+    const iterCount = c.size;
+
+    if iterCount == 0 then halt("DistributedIters: Adaptive iterator (leader):",
+                                " the range is empty");
+
+    const denseRange:cType = densify(c,c);
+    const numWorkerLocales = workerLocales.size;
+
+    if iterCount == 1
+       || numTasks == 1 && numWorkerLocales == 1
+    then
+    {
+      if debugDistributedIters
+      then writeln("DistributedIters: Adaptive iterator (leader): serial ",
+                   "execution due to insufficient work or compute resources");
+      yield (denseRange,);
+    }
+    else
+    {
+      const workerLocaleSpace = {0..#numWorkerLocales};
+      const workerLocs:[workerLocaleSpace] locale = workerLocales;
+
+      if infoDistributedIters then
+      {
+        const workerLocaleIds = [L in workerLocs] L.id:string;
+        const workerLocaleIdsSorted = workerLocaleIds.sorted();
+        writeln("DistributedIters: distributedAdaptive:");
+        writeln("  numLocales = ", numLocales);
+        writeln("  numWorkerLocales = ", numWorkerLocales);
+        writeln("  workerLocaleIds = [ ",
+                ", ".join(workerLocaleIdsSorted),
+                " ]");
+      }
+
+      // Each worker locale's share of the iterations, divided among its tasks.
+      var pools:[workerLocaleSpace] unmanaged AdaptivePool(cType)?;
+      coforall (L, lid) in zip(workerLocs, workerLocaleSpace)
+      with (ref pools)
+      do on L
+      {
+        const (lo, hi) = _computeBlock(iterCount, numWorkerLocales, lid,
+                                       denseRange.high,
+                                       denseRange.low, denseRange.low);
+        const nTasks = if numTasks > 0 then numTasks
+                       else if dataParTasksPerLocale > 0
+                            then dataParTasksPerLocale
+                            else here.maxTaskPar;
+        pools[lid] = new unmanaged AdaptivePool(cType, lo..hi, nTasks,
+                                                minChunkSize);
+      }
+
+      var localeTimes:[0..#numLocales]real;
+      var totalTime:Timer;
+      if timeDistributedIters then totalTime.start();
+
+      coforall (L, lid) in zip(workerLocs, workerLocaleSpace)
+      with (ref localeTimes)
+      do on L
+      {
+        var localeTime:Timer;
+        if timeDistributedIters then localeTime.start();
+
+        // Keep a local copy of the pools to avoid a round-trip per steal.
+        const localePools = pools;
+        const myPool = localePools[lid]!;
+
+        coforall tid in 0..#myPool.numTasks
+        {
+          var rngState = randomSeed(lid, tid);
+
+          while true
+          {
+            // Split off our own work.
+            while true
+            {
+              const taskRange = myPool.split(tid);
+              if taskRange.size == 0 then break;
+              if debugDistributedIters
+              then writeln("DistributedIters: Adaptive iterator (leader): ",
+                           here.locale, ": task ", tid, " yielding ",
+                           unDensify(taskRange,c), " as ", taskRange);
+              yield (taskRange,);
+            }
+
+            // Steal from the other tasks on this locale.
+            for offset in 1..<myPool.numTasks
+            {
+              const victim = (tid + offset) % myPool.numTasks;
+              while true
+              {
+                const taskRange = myPool.split(victim, fromTail=true);
+                if taskRange.size == 0 then break;
+                if debugDistributedIters
+                then writeln("DistributedIters: Adaptive iterator (leader): ",
+                             here.locale, ": task ", tid, " stole ",
+                             unDensify(taskRange,c), " from task ", victim);
+                yield (taskRange,);
+              }
+            }
+
+            // Steal from the other locales, starting from a random one.
+            var stolen:cType = 1..0;
+            if numWorkerLocales > 1
+            {
+              const start = nextRandom(rngState) % (numWorkerLocales - 1);
+              for offset in 0..<numWorkerLocales-1
+              {
+                const victim = (lid + 1 + (start + offset)
+                                % (numWorkerLocales - 1)) % numWorkerLocales;
+                const victimPool = localePools[victim]!;
+                on victimPool do stolen = victimPool.stealHalf();
+                if stolen.size > 0
+                {
+                  if debugDistributedIters
+                  then writeln("DistributedIters: Adaptive iterator (leader): ",
+                               here.locale, ": task ", tid, " stole ",
+                               unDensify(stolen,c), " from ",
+                               workerLocs[victim]);
+                  break;
+                }
+              }
+            }
+
+            if stolen.size == 0 then break;
+
+            // The stolen iterations become our own work again.
+            myPool.give(tid, stolen);
+          }
+        }
+
+        if timeDistributedIters then
+        {
+          localeTime.stop();
+          localeTimes[here.id] = localeTime.elapsed();
+        }
+      }
+
+      if timeDistributedIters then
+      {
+        totalTime.stop();
+        writeTimeStatistics(totalTime.elapsed(), localeTimes, false);
+      }
+
+      for pool in pools do delete pool;
+    }
+  }
+}
+
+// Zippered follower.
+pragma "no doc"
+iter distributedAdaptive(param tag:iterKind,
+                         c,
+                         numTasks:int,
+                         parDim:int,
+                         minChunkSize:int,
+                         workerLocales=Locales,
+                         followThis)
+where tag == iterKind.follower
+{
+  compilerAssert(isDomain(c) || isRange(c),
+                 ("DistributedIters: Adaptive iterator (follower): must use a "
+                  + "valid domain or range"),
+                 1);
+  const current = if isDomain(c)
+                  then c.these(tag=iterKind.follower, followThis=followThis)
+                  else unDensify(followThis(0), c);
+
+  if debugDistributedIters
+  then writeln("DistributedIters: Adaptive iterator (follower): ", here.locale,
+               ": received ",
+               if isDomain(c) then "domain " else "range ",
+               followThis, " (", current.size,
+               "/", c.size, "); shifting to ", current);
+
+  for i in current do yield i;
+}
+
 /*
   Helpers.
 */
@@ -651,6 +942,105 @@ private proc guidedSubrange(c:range(?),
   return subrange;
 }
 
+// Per-locale work for the adaptive iterator.
+/*
+  The remaining iterations of each task on one locale. Each task's range is
+  guarded by its own lock, so that the owner can split from its head while
+  thieves split from its tail. Remote thieves run stealHalf() on this
+  locale.
+*/
+pragma "no doc"
+class AdaptivePool
+{
+  type rType;
+  const numTasks:int;
+  const minChunkSize:int;
+  var work:[0..#numTasks] rType;
+  var locks:[0..#numTasks] chpl_LocalSpinlock;
+
+  proc init(type rType, r:range(?), numTasks:int, minChunkSize:int)
+  {
+    this.rType = rType;
+    this.numTasks = numTasks;
+    this.minChunkSize = minChunkSize;
+    this.complete();
+    for tid in 0..#numTasks
+    {
+      const (lo, hi) = _computeBlock(r.size, numTasks, tid, r.high,
+                                     r.low, r.low);
+      work[tid] = lo..hi;
+    }
+  }
+
+  // Split half of task tid's remaining iterations (at least minChunkSize)
+  // off its head, or off its tail if stolen by another task.
+  proc split(tid:int, fromTail:bool=false):rType
+  {
+    locks[tid].lock();
+    const totLen = work[tid].size;
+    const size = if totLen > minChunkSize
+                 then max(totLen / 2, minChunkSize)
+                 else totLen;
+    const direction = if fromTail then -1 else 1;
+    const chunk:rType = work[tid] # (direction * size);
+    work[tid] = work[tid] # (direction * (size - totLen));
+    locks[tid].unlock();
+    return chunk;
+  }
+
+  // Steal half of the remaining iterations of the most loaded task.
+  proc stealHalf():rType
+  {
+    var victim = 0, victimLen = 0;
+    for tid in 0..#numTasks
+    {
+      locks[tid].lock();
+      const len = work[tid].size;
+      locks[tid].unlock();
+      if len > victimLen
+      {
+        victim = tid;
+        victimLen = len;
+      }
+    }
+    if victimLen == 0 then return 1..0;
+
+    locks[victim].lock();
+    const totLen = work[victim].size;
+    const size = (totLen + 1) / 2;
+    const chunk:rType = work[victim] # -size;
+    work[victim] = work[victim] # (totLen - size);
+    locks[victim].unlock();
+    return chunk;
+  }
+
+  // Make r the remaining iterations of task tid.
+  proc give(tid:int, r:rType)
+  {
+    locks[tid].lock();
+    work[tid] = r;
+    locks[tid].unlock();
+  }
+}
+
+// Victim selection for the adaptive iterator.
+/*
+  A per-task xorshift generator, which is plenty for picking a starting
+  victim locale.
+*/
+private proc randomSeed(lid:int, tid:int):uint
+{
+  return ((lid:uint << 32) ^ (tid:uint * 0x9E3779B9)) | 1;
+}
+
+private proc nextRandom(ref state:uint):int
+{
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return (state >> 1):int;
+}
+
 // Per-locale time statistics.
 /*
   :arg wallTime: The wall time statistic.
@@ -67,7 +67,7 @@ module RangeChunk {
       const start = r.orderToIndex(startOrder);
       const end = r.orderToIndex(endOrder);
       yield if S
-        then start..end by r.stride
+        then (if r.stride > 0 then start..end else end..start) by r.stride
         else start..end;
     }
   }
@@ -82,7 +82,7 @@ module RangeChunk {
     const start = r.orderToIndex(startOrder);
     const end = r.orderToIndex(endOrder);
     return if S
-      then start..end by r.stride
+      then (if r.stride > 0 then start..end else end..start) by r.stride
       else start..end;
   }
 
@@ -422,14 +422,29 @@ proc radixSortOk(Data: [?Dom] ?eltType, comparator) param {
   return false;
 }
 
+private
+proc distributedSortOk(Data: [?Dom] ?eltType) param {
+  return !Data._instance.isDefaultRectangular() &&
+         !Dom.stridable &&
+         Data.hasSingleLocalSubdomain() &&
+         isDefaultInitializable(eltType) &&
+         isCopyableType(eltType);
+}
+
 /*
 
 Sort the elements in an array. It is up to the implementation to choose
 the sorting algorithm.
 
 .. note::
-  This function currently either uses a parallel radix sort or a serial
-  quickSort. The algorithms used will change over time.
+  This function currently uses a distributed sample sort, a parallel radix
+  sort, or a serial quickSort. The algorithms used will change over time.
+
+  It currently uses distributed sample sort for a non-strided array that is
+  distributed over more than one locale, such as a Block- or
+  Cyclic-distributed array. Each locale sorts the elements it owns and
+  then the locales exchange elements in bulk. The elements on each locale
+  are sorted as described below.
 
   It currently uses parallel radix sort if the following conditions are met:
 
@@ -451,6 +466,12 @@ the sorting algorithm.
     * ``string``
     * ``c_string``
 
+  When a large local array of ``int``, ``uint``, ``real``, ``imag`` or
+  tuples of one of these is sorted with the default or reverse comparator,
+  and the keys only differ in a few of their bits, the radix sort
+  processes the least significant bits first. That uses scratch space the
+  size of the array.
+
 :arg Data: The array to be sorted
 :type Data: [] `eltType`
 :arg comparator: :ref:`Comparator <comparators>` record that defines how the
@@ -464,7 +485,13 @@ proc sort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator) {
   if Dom.low >= Dom.high then
     return;
 
-  if radixSortOk(Data, comparator) {
+  if distributedSortOk(Data) && Data.targetLocales().size > 1 {
+    DistributedSampleSort.distributedSampleSort(Data, comparator=comparator);
+  } else if LSBRadixSort.lsbRadixSortOk(Data, comparator) &&
+            Dom.size >= LSBRadixSort.lsbRadixSortMinSize {
+    if !LSBRadixSort.lsbRadixSort(Data, comparator=comparator) then
+      MSBRadixSort.msbRadixSort(Data, comparator=comparator);
+  } else if radixSortOk(Data, comparator) {
     MSBRadixSort.msbRadixSort(Data, comparator=comparator);
   } else {
     QuickSort.quickSort(Data, comparator=comparator);
@@ -3219,6 +3246,267 @@ module TwoArraySampleSort {
   }
 }
 
+pragma "no doc"
+module DistributedSampleSort {
+  import Sort.{defaultComparator, chpl_compare, sort};
+
+  // Each locale contributes this many samples per target locale,
+  // in proportion to its share of the elements.
+  config const distSortOversample = 8;
+
+  // Output chunks merged by one task are at least this long
+  param minMergeChunk = 4096;
+
+  // The elements of Data that one locale sorts, or a bucket that one
+  // locale merges
+  class LocalBuffer {
+    type eltType;
+    var D: domain(1);
+    var A: [D] eltType;
+
+    proc init(type eltType, size: int) {
+      this.eltType = eltType;
+      this.D = {0..#size};
+    }
+  }
+
+  // Samples and splitters are (element, locale, position) so that equal
+  // elements can still be split between locales in a balanced way.
+  record SampleComparator {
+    var comparator;
+
+    proc compare(a, b) {
+      const c = chpl_compare(a(0), b(0), comparator);
+      if c < 0 then return -1;
+      if c > 0 then return 1;
+      if a(1) != b(1) then return if a(1) < b(1) then -1 else 1;
+      if a(2) != b(2) then return if a(2) < b(2) then -1 else 1;
+      return 0;
+    }
+  }
+
+  // Returns the first position in the sorted A[0..<n] holding an element
+  // that is not less than 'v' (or not less than or equal to, if 'upper')
+  private proc searchRun(const ref A: [], n: int, const ref v,
+                         comparator, param upper: bool) {
+    var lo = 0, hi = n;
+    while lo < hi {
+      const mid = lo + (hi - lo) / 2;
+      const c = chpl_compare(A[mid], v, comparator);
+      if c < 0 || (upper && c == 0) then
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    return lo;
+  }
+
+  // Returns how many elements of the sorted run from locale 'loc' come
+  // before 'splitter'
+  private proc countBefore(const ref A: [], n: int, loc: int,
+                           const ref splitter, comparator) {
+    const sLoc = splitter(1), sPos = splitter(2);
+    if loc == sLoc then
+      return sPos;
+    else if loc < sLoc then
+      return searchRun(A, n, splitter(0), comparator, upper=true);
+    else
+      return searchRun(A, n, splitter(0), comparator, upper=false);
+  }
+
+  // Returns how many of the first k elements of the merge of
+  // Src[aLo..<aHi] and Src[bLo..<bHi] come from the first run
+  private proc coRank(const ref Src: [], aLo: int, aHi: int,
+                      bLo: int, bHi: int, k: int, comparator) {
+    const na = aHi - aLo, nb = bHi - bLo;
+    var lo = max(0, k - nb), hi = min(k, na);
+    while lo < hi {
+      const i = lo + (hi - lo) / 2;
+      const j = k - i;
+      if chpl_compare(Src[aLo+i], Src[bLo+j-1], comparator) <= 0 then
+        lo = i + 1;
+      else
+        hi = i;
+    }
+    return lo;
+  }
+
+  // Writes elements k0..<k1 of the merge of Src[aLo..<aHi] and
+  // Src[bLo..<bHi] to Dst[aLo+k0..<aLo+k1]
+  private proc mergeChunk(const ref Src: [], ref Dst: [],
+                          aLo: int, aHi: int, bLo: int, bHi: int,
+                          k0: int, k1: int, comparator) {
+    var i = aLo + coRank(Src, aLo, aHi, bLo, bHi, k0, comparator);
+    var j = bLo + (k0 - (i - aLo));
+    for k in aLo+k0..<aLo+k1 {
+      if j >= bHi || (i < aHi && chpl_compare(Src[i], Src[j], comparator) <= 0) {
+        Dst[k] = Src[i];
+        i += 1;
+      } else {
+        Dst[k] = Src[j];
+        j += 1;
+      }
+    }
+  }
+
+  // Merges the sorted runs A[bounds[r]..<bounds[r+1]] pairwise until one
+  // run is left, using Tmp as scratch space. Returns true if the result
+  // ended up in Tmp rather than A.
+  private proc mergeRuns(ref A: [], ref Tmp: [], in bounds: [] int,
+                         comparator): bool {
+    var numRuns = bounds.size - 1;
+    var inTmp = false;
+    while numRuns > 1 {
+      const numPairs = (numRuns + 1) / 2;
+      const tasksPerPair = max(1, here.maxTaskPar / numPairs);
+      forall (pair, chunk) in {0..#numPairs, 0..#tasksPerPair} {
+        const aLo = bounds[2*pair];
+        const aHi = bounds[min(2*pair+1, numRuns)];
+        const bHi = bounds[min(2*pair+2, numRuns)];
+        const size = bHi - aLo;
+        const numChunks = max(1, min(tasksPerPair, size / minMergeChunk));
+        if chunk < numChunks {
+          const k0 = size * chunk / numChunks;
+          const k1 = size * (chunk + 1) / numChunks;
+          if inTmp then
+            mergeChunk(Tmp, A, aLo, aHi, aHi, bHi, k0, k1, comparator);
+          else
+            mergeChunk(A, Tmp, aLo, aHi, aHi, bHi, k0, k1, comparator);
+        }
+      }
+      // keep the boundaries of the merged runs
+      for r in 0..numPairs do
+        bounds[r] = bounds[min(2*r, numRuns)];
+      numRuns = numPairs;
+      inTmp = !inTmp;
+    }
+    return inTmp;
+  }
+
+  /*
+    Sorts a 1-D Block- or Cyclic-distributed array, keeping the
+    elements on the locales that own them:
+
+      * each locale sorts its own elements
+      * splitters are chosen from a sample of every locale's sorted
+        elements, dividing them into one bucket per locale
+      * each locale gathers its bucket from the others, with one bulk
+        transfer per source locale
+      * each locale merges the sorted pieces of its bucket and stores
+        them in their final place
+
+    Besides Data, each locale needs space for about three times the
+    number of elements it owns.
+   */
+  proc distributedSampleSort(Data: [?Dom] ?eltType,
+                             comparator:?rec=defaultComparator) {
+    const targetLocs = Data.targetLocales();
+    const p = targetLocs.size;
+    var locs: [0..#p] locale;
+    for (l, loc) in zip(locs, targetLocs) do l = loc;
+    type sampleType = (eltType, int, int);
+
+    // sort each locale's elements
+    var runs: [0..#p] unmanaged LocalBuffer(eltType)?;
+    var runSizes: [0..#p] int;
+    coforall (loc, l) in zip(locs, 0..) do on loc {
+      const myInds = Data.localSubdomain();
+      const run = new unmanaged LocalBuffer(eltType, myInds.size);
+      if myInds.size > 0 {
+        run.A = Data[myInds];
+        sort(run.A, comparator=comparator);
+      }
+      runs[l] = run;
+      runSizes[l] = myInds.size;
+    }
+
+    const n = + reduce runSizes;
+    if n == 0 {
+      deleteRuns(locs, runs);
+      return;
+    }
+
+    // gather samples from every locale
+    const sampleTarget = distSortOversample * p;
+    const sampleCounts = [sz in runSizes]
+                         if sz == 0 then 0
+                         else min(sz, max(1, ceil(sz:real*sampleTarget/n):int));
+    const sampleStarts = (+ scan sampleCounts) - sampleCounts;
+    const numSamples = + reduce sampleCounts;
+    var samples: [0..#numSamples] sampleType;
+    coforall (loc, l) in zip(locs, 0..) do on loc {
+      const run = runs[l]!;
+      const count = sampleCounts[l], size = run.D.size;
+      if count > 0 {
+        var mine: [0..#count] sampleType;
+        for k in 0..#count {
+          const pos = ((k + 0.5) * size / count):int;
+          mine[k] = (run.A[pos], l, pos);
+        }
+        samples[sampleStarts[l]..#count] = mine;
+      }
+    }
+
+    // choose a splitter between each pair of neighboring buckets
+    sort(samples, comparator=new SampleComparator(comparator));
+    var splitters: [0..#p-1] sampleType;
+    for b in 1..p-1 do
+      splitters[b-1] = samples[(b * numSamples) / p];
+
+    // find where each bucket starts within each sorted run
+    var cuts: [0..#p, 0..p] int;
+    coforall (loc, l) in zip(locs, 0..) do on loc {
+      const run = runs[l]!;
+      const size = run.D.size;
+      const mySplitters = splitters;
+      var myCuts: [0..p] int;
+      myCuts[p] = size;
+      forall b in 1..p-1 do
+        myCuts[b] = countBefore(run.A, size, l, mySplitters[b-1], comparator);
+      cuts[l, ..] = myCuts;
+    }
+
+    var bucketSizes: [0..#p] int;
+    forall b in 0..#p do
+      bucketSizes[b] = + reduce [src in 0..#p] (cuts[src, b+1] - cuts[src, b]);
+    const bucketStarts = (+ scan bucketSizes) - bucketSizes;
+
+    // gather and merge each bucket on its locale, then store it
+    coforall (loc, b) in zip(locs, 0..) do on loc {
+      const size = bucketSizes[b];
+      if size > 0 {
+        const myCuts: [0..#p, b..b+1] int = cuts[.., b..b+1];
+        var bounds: [0..p] int;
+        for src in 0..#p do
+          bounds[src+1] = bounds[src] + myCuts[src, b+1] - myCuts[src, b];
+
+        const bucket = new unmanaged LocalBuffer(eltType, size);
+        const tmp = new unmanaged LocalBuffer(eltType, size);
+        forall src in 0..#p {
+          const count = bounds[src+1] - bounds[src];
+          if count > 0 then
+            bucket.A[bounds[src]..#count] =
+              runs[src]!.A[myCuts[src, b]..#count];
+        }
+
+        const first = Dom.low + bucketStarts[b]:Dom.idxType;
+        if mergeRuns(bucket.A, tmp.A, bounds, comparator) then
+          Data[first..#size] = tmp.A;
+        else
+          Data[first..#size] = bucket.A;
+
+        delete bucket, tmp;
+      }
+    }
+
+    deleteRuns(locs, runs);
+  }
+
+  private proc deleteRuns(locs, runs) {
+    coforall (loc, l) in zip(locs, 0..) do on loc do delete runs[l];
+  }
+}
+
 pragma "no doc"
 module InPlacePartitioning {
   // TODO -- based on ips4o
@@ -3475,6 +3763,316 @@ module MSBRadixSort {
   }
 }
 
+pragma "no doc"
+module LSBRadixSort {
+  import Sort.{defaultComparator, reverseComparator, DefaultComparator};
+  private use super.RadixSortHelp;
+  private use CPtr;
+
+  // Arrays with fewer elements than this are left to msbRadixSort
+  config const lsbRadixSortMinSize = 1 << 16;
+
+  // Keys that need more passes than this are left to msbRadixSort, which
+  // only makes a few passes over the whole array before the pieces fit
+  // in cache
+  config const lsbRadixSortMaxPasses = 4;
+
+  // Each pass sorts by this many bits of a key component. Fewer, wider
+  // passes move the data fewer times, but need more bins.
+  param maxDigitBits = 11;
+
+  // How many elements to check before counting all of them
+  param sampleSize = 1024;
+
+  // Each task gathers this many bytes per bin before writing them out
+  param writeCombineBytes = 64;
+
+  // Returns true if lsbRadixSort can sort Data with comparator
+  proc lsbRadixSortOk(Data: [?Dom] ?eltType, comparator) param {
+    if Data._instance.isDefaultRectangular() && !Dom.stridable &&
+       (comparator.type == DefaultComparator ||
+        comparator.type == reverseComparator.type) then
+      return isKeyType(eltType);
+    else
+      return false;
+  }
+
+  private proc isKeyType(type t) param {
+    if isHomogeneousTuple(t) {
+      var tmp: t;
+      return isNumericKeyType(tmp(0).type);
+    }
+    return isNumericKeyType(t);
+  }
+
+  private proc isNumericKeyType(type t) param {
+    return isIntType(t) || isUintType(t) || isRealType(t) || isImagType(t);
+  }
+
+  private proc numComponents(type eltType) param {
+    if isHomogeneousTuple(eltType) {
+      var tmp: eltType;
+      return tmp.size;
+    }
+    return 1;
+  }
+
+  private proc componentBits(type eltType) param {
+    return fixedWidth(eltType) / numComponents(eltType);
+  }
+
+  private proc digitBits(type eltType) param {
+    return min(maxDigitBits, componentBits(eltType));
+  }
+
+  private proc digitsPerComponent(type eltType) param {
+    return (componentBits(eltType) + digitBits(eltType) - 1) /
+           digitBits(eltType);
+  }
+
+  // Returns component 'c' of 'x' as an unsigned integer that orders the
+  // same way the default comparator orders that component
+  private inline proc orderedBits(const ref x, c: int, param reverse: bool) {
+    param bits = componentBits(x.type);
+    var ubits: uint(bits);
+    if isHomogeneousTuple(x.type) {
+      const (_, part) = defaultComparator.keyPart(x(c), 0);
+      ubits = fixBits(x(c), part);
+    } else {
+      const (_, part) = defaultComparator.keyPart(x, 0);
+      ubits = fixBits(x, part);
+    }
+    if reverse then ubits = ~ubits;
+    return ubits;
+  }
+
+  // Adjusts the keyPart 'part' of 'x' so that it orders as unsigned, and
+  // so that the low bits of a real are zero in the key wherever they are
+  // zero in the real
+  private inline proc fixBits(x, part) {
+    param bits = numBits(part.type);
+    const one = 1:uint(bits);
+    var ubits = part:uint(bits);
+    if isInt(part) {
+      ubits ^= one << (bits - 1);
+    } else if (isReal(x) || isImag(x)) && (ubits >> (bits - 1)) == 0 {
+      // keyPart flips all the bits of a negative value, adding one makes
+      // that a negation. The largest negative key, -0.0, becomes the key of
+      // 0.0, which compares equal to it.
+      ubits += one;
+    }
+    return ubits;
+  }
+
+  // Returns the bin of 'x' for the pass sorting by 'digit', counting
+  // digits from the least significant one. Each component is offset by
+  // the smallest value it has in any element, from 'lows'.
+  private inline proc digitOf(const ref x, digit: int, param reverse: bool,
+                              const ref lows) {
+    param perComponent = digitsPerComponent(x.type);
+    param mask = (1 << digitBits(x.type)) - 1;
+    const c = numComponents(x.type) - 1 - digit / perComponent;
+    const shift = (digit % perComponent) * digitBits(x.type);
+    return (((orderedBits(x, c, reverse) - lows(c)) >> shift) & mask):int;
+  }
+
+  // Returns the smallest and largest value of each component of the keys
+  // of src[0..<n], and which bits of each component differ from the first
+  // key
+  private proc keyRange(src: c_ptr(?eltType), n: int, numTasks: int,
+                        param reverse: bool) {
+    param numComps = numComponents(eltType);
+    type rangeType = numComps*uint(componentBits(eltType));
+    var taskLows, taskHighs, taskVarying: [0..#numTasks] rangeType;
+    coforall tid in 0..#numTasks with (ref taskLows, ref taskHighs,
+                                       ref taskVarying) {
+      const (lo, hi) = taskBlock(n, numTasks, tid);
+      var lows, highs, varying, firsts: rangeType;
+      for param c in 0..<numComps {
+        lows(c) = max(lows(c).type);
+        firsts(c) = orderedBits(src[0], c, reverse);
+      }
+      for i in lo..<hi {
+        for param c in 0..<numComps {
+          const ubits = orderedBits(src[i], c, reverse);
+          lows(c) = min(lows(c), ubits);
+          highs(c) = max(highs(c), ubits);
+          varying(c) |= ubits ^ firsts(c);
+        }
+      }
+      taskLows[tid] = lows;
+      taskHighs[tid] = highs;
+      taskVarying[tid] = varying;
+    }
+    var lows = taskLows[0], highs = taskHighs[0], varying = taskVarying[0];
+    for tid in 1..<numTasks {
+      for param c in 0..<numComps {
+        lows(c) = min(lows(c), taskLows[tid](c));
+        highs(c) = max(highs(c), taskHighs[tid](c));
+        varying(c) |= taskVarying[tid](c);
+      }
+    }
+    return (lows, highs, varying);
+  }
+
+  // Returns which digits vary between keys with components in
+  // lows..highs. Bits below the lowest one in 'varying' are the same in
+  // every key, so they are zero in every offset from 'lows' and the digits
+  // made up of them need no pass.
+  private proc digitsToSort(type eltType, lows, highs, varying) {
+    param numDigits = numComponents(eltType) * digitsPerComponent(eltType);
+    param perComponent = digitsPerComponent(eltType);
+    var ret: numDigits*bool;
+    for param digit in 0..<numDigits {
+      const c = numComponents(eltType) - 1 - digit / perComponent;
+      const shift = (digit % perComponent) * digitBits(eltType);
+      const lowestVarying = varying(c) & (~varying(c) + 1);
+      ret(digit) = ((highs(c) - lows(c)) >> shift) != 0 &&
+                   (lowestVarying >> shift):uint <
+                     1:uint << digitBits(eltType);
+    }
+    return ret;
+  }
+
+  private proc numPasses(digits) {
+    var ret = 0;
+    for sortDigit in digits do
+      if sortDigit then ret += 1;
+    return ret;
+  }
+
+  /*
+    Sorts Data with a least-significant-digit radix sort. Each pass moves
+    the elements into bins by one digit of the key, in a single scratch
+    array reused by every pass. Elements are gathered in a small buffer
+    per bin so that they are written out a cache line at a time.
+
+    The keys are sorted by their offsets from the smallest key, so that
+    digits above the range of the keys don't need passes, nor do low
+    digits that are the same in every key, such as the unused low mantissa
+    bits of real keys. With one task,
+    a single pass counts the bins for every digit. With more, each pass
+    counts the bins in each task's block so that the tasks can write
+    their elements without coordinating.
+
+    Returns false, leaving Data unchanged, if the keys would need more
+    than lsbRadixSortMaxPasses passes.
+   */
+  proc lsbRadixSort(Data: [?Dom] ?eltType, comparator): bool {
+    param reverse = comparator.type != DefaultComparator;
+    param numDigits = numComponents(eltType) * digitsPerComponent(eltType);
+    param radix = 1 << digitBits(eltType);
+    param eltBytes = fixedWidth(eltType) / 8;
+    param bufElts = max(2, writeCombineBytes / eltBytes);
+
+    const n = Dom.size:int;
+    const numTasks = max(1, min(if dataParTasksPerLocale == 0
+                                then here.maxTaskPar
+                                else dataParTasksPerLocale,
+                                n / radix));
+
+    var src = c_ptrTo(Data[Dom.low]);
+
+    // If the first few keys already need too many passes, give up before
+    // reading the rest
+    {
+      const (lows, highs, varying) = keyRange(src, min(n, sampleSize), 1,
+                                              reverse);
+      const sampleDigits = digitsToSort(eltType, lows, highs, varying);
+      if numPasses(sampleDigits) > lsbRadixSortMaxPasses then
+        return false;
+    }
+
+    const (lows, highs, varying) = keyRange(src, n, numTasks, reverse);
+    const sortDigits = digitsToSort(eltType, lows, highs, varying);
+    if numPasses(sortDigits) > lsbRadixSortMaxPasses then
+      return false;
+
+    var Scratch: [0..#n] eltType = noinit;
+    var Buffers: [0..#numTasks*radix*bufElts] eltType = noinit;
+    var counts: [0..#numTasks, 0..#radix] int;
+    var dst = c_ptrTo(Scratch[0]);
+
+    // with one task, count every digit at once
+    var totals: [0..#numDigits, 0..#radix] int;
+    if numTasks == 1 {
+      for i in 0..#n {
+        for param digit in 0..<numDigits do
+          if sortDigits(digit) then
+            totals[digit, digitOf(src[i], digit, reverse, lows)] += 1;
+      }
+    }
+
+    for digit in 0..#numDigits {
+      if !sortDigits(digit) then continue;
+
+      if numTasks == 1 {
+        for bin in 0..#radix do
+          counts[0, bin] = totals[digit, bin];
+      } else {
+        // count the bins in each task's block
+        coforall tid in 0..#numTasks with (ref counts) {
+          const (lo, hi) = taskBlock(n, numTasks, tid);
+          const myCounts = c_ptrTo(counts[tid, 0]);
+          for bin in 0..#radix do
+            myCounts[bin] = 0;
+          for i in lo..<hi do
+            myCounts[digitOf(src[i], digit, reverse, lows)] += 1;
+        }
+      }
+
+      // turn the counts into where each task starts writing each bin
+      var total = 0;
+      for bin in 0..#radix {
+        for tid in 0..#numTasks {
+          const count = counts[tid, bin];
+          counts[tid, bin] = total;
+          total += count;
+        }
+      }
+
+      // move the elements, a buffer of each bin at a time
+      coforall tid in 0..#numTasks with (ref counts) {
+        const (lo, hi) = taskBlock(n, numTasks, tid);
+        const buf = c_ptrTo(Buffers[tid*radix*bufElts]);
+        const next = c_ptrTo(counts[tid, 0]);
+        var fill: c_array(int, radix);
+
+        for i in lo..<hi {
+          const bin = digitOf(src[i], digit, reverse, lows);
+          const f = fill[bin];
+          buf[bin*bufElts + f] = src[i];
+          if f == bufElts-1 {
+            c_memcpy(dst + next[bin], buf + bin*bufElts, bufElts*eltBytes);
+            next[bin] += bufElts;
+            fill[bin] = 0;
+          } else {
+            fill[bin] = f + 1;
+          }
+        }
+        for bin in 0..#radix {
+          if fill[bin] > 0 then
+            c_memcpy(dst + next[bin], buf + bin*bufElts,
+                     fill[bin]*eltBytes);
+        }
+      }
+
+      src <=> dst;
+    }
+
+    // an odd number of passes leaves the result in Scratch
+    if src != c_ptrTo(Data[Dom.low]) {
+      forall i in 0..#n do
+        dst[i] = src[i];
+    }
+    return true;
+  }
+
+  private inline proc taskBlock(n: int, numTasks: int, tid: int) {
+    return (n * tid / numTasks, n * (tid + 1) / numTasks);
+  }
+}
+
 /* Comparators */
 
 /* Default comparator used in sort functions.*/
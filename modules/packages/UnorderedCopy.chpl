@@ -71,15 +71,32 @@
 
    Generally speaking they are useful for when you have a large batch of remote
    assignments to perform and the order of those operations doesn't matter.
+   For example, a random-access gather from a distributed array can be written
+   as a single promoted call. Each task that the promotion runs on batches up
+   its own GETs:
+
+   .. code-block:: chapel
+
+     var Inds: [D] int = ...;   // indices into A, possibly remote
+     var Vals: [D] int;
+
+     unorderedCopy(Vals, A[Inds]);
+
+   The compiler also performs this transformation on its own for many foralls
+   whose last statement is an assignment, such as
+   ``forall i in D do Vals[i] = A[Inds[i]];``. See
+   ``--[no-]optimize-forall-unordered-ops``.
 
    .. note::
-     Currently, this is only optimized for ``CHPL_COMM=ugni``. Other
-     communication layers fall back to regular operations. Under ugni, GETs are
-     internally buffered. When the buffers are flushed, the operations are
-     performed all at once. Cray Linux Environment (CLE) 5.2.UP04 or newer is
-     required for best performance. In our experience, unordered copies can
-     achieve up to a 5X performance improvement over ordered copies for CLE
-     5.2UP04 or newer.
+     Currently, this is only optimized for ``CHPL_COMM=ugni`` and
+     ``CHPL_COMM=ofi``. Other communication layers fall back to regular
+     operations. Under ugni, GETs are internally buffered. Under ofi, both GETs
+     and PUTs of up to 1KiB are buffered per task. When the buffers are
+     flushed, the operations are all initiated together, so many of them are
+     in flight at once. For ugni, Cray Linux Environment (CLE) 5.2.UP04 or
+     newer is required for best performance. In our experience, unordered
+     copies can achieve up to a 5X performance improvement over ordered copies
+     for CLE 5.2UP04 or newer.
  */
 module UnorderedCopy {
   /*
@@ -195,12 +195,17 @@ module CommDiagnostics
     fields are those expected to have unpredictable values for multiple
     executions of the same code sequence.  Setting this to `true` causes
     such fields, if non-zero, to be included when a `commDiagnostics`
-    value is written.  At present the only unstable field is the `amo`
-    counter, whose instability is due to the use of atomic reads in spin
-    loops that wait for parallelism and on-statements to complete.
+    value is written.  The unstable fields are the `amo` counter, whose
+    instability is due to the use of atomic reads in spin loops that wait
+    for parallelism and on-statements to complete, and the `cache_wait_ns`
+    timer.
    */
   config param commDiagsPrintUnstable = false;
 
+  private proc isUnstableField(param name: string) param {
+    return name == "amo" || name == "cache_wait_ns";
+  }
+
   /* Aggregated communication operation counts.  This record type is
      defined in the same way by both the underlying comm layer(s) and
      this module, because we don't have a good way to inherit types back
@@ -258,6 +263,68 @@ module CommDiagnostics
     var cache_get_misses: uint(64);
     var cache_put_hits: uint(64);
     var cache_put_misses: uint(64);
+    /*
+      remote cache: prefetches issued for detected strided access streams
+     */
+    var cache_stride_prefetches: uint(64);
+    /*
+      remote cache: strided stream accesses satisfied by a stride prefetch
+     */
+    var cache_stride_hits: uint(64);
+    /*
+      remote cache: strided stream accesses that missed despite having
+      been prefetched
+     */
+    var cache_stride_misses: uint(64);
+    /*
+      remote cache: stride prefetches never used because the stream ended
+     */
+    var cache_stride_wasted: uint(64);
+    /*
+      remote cache: cache lines fetched by sequential readahead
+     */
+    var cache_readahead_issued: uint(64);
+    /*
+      remote cache: readahead cache lines later read by a get before being
+      evicted or invalidated
+     */
+    var cache_readahead_used: uint(64);
+    /*
+      remote cache: puts issued to write back dirty cached data
+     */
+    var cache_write_behind_puts: uint(64);
+    /*
+      remote cache: bytes written back by write-behind puts
+     */
+    var cache_write_behind_bytes: uint(64);
+    /*
+      remote cache: pages evicted from the Ain (first use) queue
+     */
+    var cache_evict_ain: uint(64);
+    /*
+      remote cache: page records dropped from the Aout (recently evicted)
+      queue
+     */
+    var cache_evict_aout: uint(64);
+    /*
+      remote cache: pages evicted from the Am (reused) queue
+     */
+    var cache_evict_am: uint(64);
+    /*
+      remote cache: acquire fences (e.g. from sync variables, atomics, and
+      joining tasks), each of which invalidates the task's cached data
+     */
+    var cache_acquire_invalidations: uint(64);
+    /*
+      remote cache: acquire fences at the start of a task or `on` statement
+      body, each of which invalidates the task's cached data
+     */
+    var cache_start_invalidations: uint(64);
+    /*
+      remote cache: nanoseconds spent waiting for pending cache operations
+      to complete (unstable)
+     */
+    var cache_wait_ns: uint(64);
 
     proc writeThis(c) throws {
       use Reflection;
@@ -268,7 +335,7 @@ module CommDiagnostics
         param name = getFieldName(chpl_commDiagnostics, i);
         const val = getField(this, i);
         if val != 0 {
-          if commDiagsPrintUnstable || name != 'amo' {
+          if commDiagsPrintUnstable || !isUnstableField(name) {
             if first then first = false; else c <~> ", ";
             c <~> name <~> " = " <~> val;
           }
@@ -441,8 +508,9 @@ module CommDiagnostics
         maxval = max(maxval, getField(CommDiags[locID], fieldID).safeCast(int));
 
       if printEmptyColumns || maxval != 0 {
-        const width = if commDiagsPrintUnstable == false && name == "amo"
-                        then -unstable.size
+        const width = if commDiagsPrintUnstable == false &&
+                         isUnstableField(name)
+                        then -max(name.size, unstable.size)
                         else max(name.size, ceil(log10(maxval+1)):int);
         fieldWidth[fieldID] = width;
 
@@ -455,7 +523,7 @@ module CommDiagnostics
     for param fieldID in 0..<nFields {
       const width = abs(fieldWidth[fieldID]);
       if width != 0 {
-        writef("| %.*s: ", width-1, "------------------");
+        writef("| %.*s: ", width-1, "------------------------------");
       }
     }
     writeln("|");
@@ -26,6 +26,10 @@
   setting the param formal `parSafe` to true in any map constructor. When
   constructed from another map, the new map will inherit the parallel safety
   mode of its originating map.
+
+  A parallel safe map guards all of its contents with a single lock. Maps that
+  are updated from many tasks at once, for example inside a ``forall`` loop,
+  may scale better as a :class:`~ConcurrentMap.ConcurrentMap`.
 */
 module Map {
   import ChapelLocks;
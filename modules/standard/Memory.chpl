@@ -20,7 +20,8 @@
 
 /*
   The :mod:`Memory` module provides submodules that contain operations
-  related to memory usage and memory initialization.
+  related to memory usage and memory initialization, and dedicated
+  allocation arenas.
 
   .. warning::
 
@@ -32,6 +33,7 @@
  */
 module Memory {
 
+include module Arenas;
 include module Diagnostics;
 
 pragma "insert line file info"
@@ -0,0 +1,151 @@
+/*
+ * Copyright 2020-2021 Hewlett Packard Enterprise Development LP
+ * Copyright 2004-2019 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ * 
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * 
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+  The :mod:`Arenas` module provides dedicated allocation arenas, for
+  temporary buffers that are all discarded together.
+
+  Allocating from an :record:`arena` is cheaper than allocating on the
+  regular heap: the allocation bypasses the per-thread caches and the
+  memory allocator's other bookkeeping, and nothing is freed piece by
+  piece.  Instead, all the memory allocated from an arena is released at
+  once when the arena is reset or destroyed.  This suits scratch buffers
+  with a shared lifetime, such as those used by one phase of a
+  computation:
+
+  .. code-block:: chapel
+
+    use Memory.Arenas;
+
+    var a = new arena();
+    for phase in 1..numPhases {
+      const buf = a.alloc(real, n);
+      // ... use buf[0..n-1] ...
+      a.reset();   // buf is gone
+    }
+
+  An arena belongs to the locale it was created on, and may only be
+  allocated from or reset there.  Several tasks on that locale may
+  allocate from it at the same time.  Memory allocated from an arena is
+  not reported by memory tracking (see :mod:`Diagnostics`).
+ */
+module Arenas {
+
+private use CPtr, SysCTypes;
+
+private extern proc chpl_mem_arena_create(): c_void_ptr;
+private extern proc chpl_mem_arena_alloc(arena: c_void_ptr, size: size_t,
+                                         alignment: size_t): c_void_ptr;
+private extern proc chpl_mem_arena_reset(arena: c_void_ptr);
+private extern proc chpl_mem_arena_destroy(arena: c_void_ptr);
+
+/*
+  A dedicated allocation arena.  The arena, and everything allocated from
+  it, is destroyed when the record that created it goes out of scope.
+  Copies of that record refer to the same arena but do not own it.
+ */
+record arena {
+  pragma "no doc"
+  var handle: c_void_ptr;
+  pragma "no doc"
+  var isowned: bool = false;
+  pragma "no doc"
+  var homeLocId: int;
+
+  /* Create a new, empty arena on the current locale. */
+  proc init() {
+    handle = chpl_mem_arena_create();
+    isowned = true;
+    homeLocId = here.id;
+  }
+
+  /* copy initializer */
+  pragma "no doc"
+  proc init=(a: arena) {
+    this.handle = a.handle;
+    this.isowned = false;
+    this.homeLocId = a.homeLocId;
+  }
+
+  pragma "no doc"
+  proc deinit() {
+    if isowned && handle != c_nil {
+      chpl_mem_arena_destroy(handle);
+    }
+  }
+
+  pragma "no doc"
+  proc checkLocale(what: string) {
+    if here.id != homeLocId then
+      halt("cannot ", what, " arena from locale ", homeLocId,
+           " on locale ", here.id);
+  }
+
+  /*
+    Allocate uninitialized space for `size` elements of type `eltType`.
+    The space remains valid until the arena is reset or destroyed.
+
+    :arg eltType: the type of the elements
+    :arg size: the number of elements
+    :arg alignment: the alignment of the space, in bytes.  It must be a
+                    power of 2.  The default, 0, gives an alignment
+                    suitable for any basic type.
+    :returns: a pointer to the space
+
+    Halts if called on a locale other than the arena's, or if the space
+    cannot be allocated.
+   */
+  proc alloc(type eltType, size: integral,
+             alignment: integral = 0): c_ptr(eltType) {
+    checkLocale("allocate from");
+    if size < 0 then
+      halt("cannot allocate a negative number of elements from an arena");
+    if alignment < 0 || (alignment & (alignment - 1)) != 0 then
+      halt("arena alignment must be 0 or a power of 2");
+    const p = chpl_mem_arena_alloc(handle,
+                                   size: size_t * c_sizeof(eltType),
+                                   alignment: size_t);
+    if p == c_nil then
+      halt("out of memory allocating from an arena");
+    return p: c_ptr(eltType);
+  }
+
+  /*
+    Release all the space allocated from the arena, which may then be used
+    for new allocations.  Any pointers returned by :proc:`alloc` become
+    invalid.  Halts if called on a locale other than the arena's.
+   */
+  proc reset() {
+    checkLocale("reset");
+    chpl_mem_arena_reset(handle);
+  }
+}
+
+pragma "no doc"
+proc =(ref lhs: arena, rhs: arena) {
+  if lhs.isowned && lhs.handle != c_nil {
+    chpl_mem_arena_destroy(lhs.handle);
+  }
+  lhs.handle = rhs.handle;
+  lhs.isowned = false;
+  lhs.homeLocId = rhs.homeLocId;
+}
+
+}
@@ -20,13 +20,14 @@
 
 /*
   The :mod:`Diagnostics` module provides procedures which report information
-  about memory usage.  With one exception, to use these procedures you
-  must enable memory tracking.  Do this by setting one or more of the
-  config vars below, using appropriate ``--configVarName=value`` or
+  about memory usage.  Except for :proc:`locale.physicalMemory` and the
+  NUMA locality diagnostics, to use these procedures you must enable
+  memory tracking.  Do this by setting one or more of the config vars
+  below, using appropriate ``--configVarName=value`` or
   ``-sconfigVarName=value`` command line options when you run the
-  program.  If memory tracking is not enabled, calling any procedure
-  described here, other than :proc:`locale.physicalMemory`, will cause
-  the program to halt with an error message.
+  program.  If memory tracking is not enabled, calling any of the
+  procedures that need it will cause the program to halt with an error
+  message.
 
   ``memTrack``: `bool`:
     Enable memory tracking.  This causes memory allocations and
@@ -249,4 +250,59 @@ proc stopVerboseMemHere() {
   chpl_stopVerboseMemHere();
 }
 
+/*
+  Start counting NUMA locality on all locales.  Continue counting until
+  :proc:`stopNumaDiagnostics` is called.
+
+  While counting is on, each chunk of a ``forall`` over a default
+  rectangular array samples the memory pages holding the elements it
+  will visit and counts them as local if they are on the NUMA domain
+  (sublocale) the chunk is running on and remote otherwise.  Pages that
+  have not been touched yet, and pages only partly covered by the
+  chunk, are not counted.  This only produces counts
+  with a locale model that has NUMA sublocales, such as ``numa``; with
+  ``flat`` the counts stay zero.
+
+  Like the other procedures here this does not need memory tracking.
+ */
+proc startNumaDiagnostics() {
+  extern proc chpl_topo_numaDiagsStart();
+  coforall loc in Locales do on loc do chpl_topo_numaDiagsStart();
+}
+
+/*
+  Stop counting NUMA locality on all locales.
+ */
+proc stopNumaDiagnostics() {
+  extern proc chpl_topo_numaDiagsStop();
+  coforall loc in Locales do on loc do chpl_topo_numaDiagsStop();
+}
+
+/*
+  Reset the NUMA locality counts on all locales to zero.
+ */
+proc resetNumaDiagnostics() {
+  extern proc chpl_topo_numaDiagsReset();
+  coforall loc in Locales do on loc do chpl_topo_numaDiagsReset();
+}
+
+/*
+  What fraction of the sampled accesses on this locale were to memory
+  on a different NUMA domain than the one doing the access?
+
+  :returns: The number of remote pages sampled divided by the total
+    number of pages sampled on the calling locale since the counts were
+    last reset, or 0.0 if nothing was sampled.
+  :rtype: `real`
+ */
+proc numaRemoteFraction(): real {
+  extern proc chpl_topo_numaDiagsGet(ref nLocal: uint(64),
+                                     ref nRemote: uint(64));
+  var nLocal, nRemote: uint(64);
+  chpl_topo_numaDiagsGet(nLocal, nRemote);
+  if nLocal + nRemote == 0 then
+    return 0.0;
+  return nRemote:real / (nLocal + nRemote):real;
+}
+
 }
@@ -52,6 +52,7 @@
 
      * :mod:`PCGRandom`
      * :mod:`NPBRandom`
+     * :mod:`PhiloxRandom`
 
    .. note::
 
@@ -64,17 +65,19 @@ module Random {
   public use RandomSupport;
   public use NPBRandom;
   public use PCGRandom;
+  public use PhiloxRandom;
   import Set.set;
   private use IO;
 
 
   /* Select between different supported RNG algorithms.
-     See :mod:`PCGRandom` and :mod:`NPBRandom` for details on
-     these algorithms.
+     See :mod:`PCGRandom`, :mod:`NPBRandom`, and :mod:`PhiloxRandom` for
+     details on these algorithms.
    */
   enum RNG {
     PCG = 1,
-    NPB = 2
+    NPB = 2,
+    Philox = 3
   }
 
   /* The default RNG. The current default is PCG - see :mod:`PCGRandom`. */
@@ -112,7 +115,8 @@ module Random {
 
     .. note::
       :mod:`NPBRandom` only supports `real(64)`, `imag(64)`, and `complex(128)`
-      numeric types. :mod:`PCGRandom` supports all primitive numeric types.
+      numeric types. :mod:`PCGRandom` and :mod:`PhiloxRandom` support all
+      primitive numeric types.
 
     :arg arr: The array to be filled, where T is a primitive numeric type. Only
       rectangular arrays are supported currently.
@@ -230,6 +234,10 @@ module Random {
       return new owned NPBRandomStream(seed=seed,
                                        parSafe=parSafe,
                                        eltType=eltType);
+    else if algorithm == RNG.Philox then
+      return new owned PhiloxRandomStream(seed=seed,
+                                          parSafe=parSafe,
+                                          eltType=eltType);
     else
       compilerError("Unknown random number generator");
   }
@@ -2897,6 +2905,719 @@ module Random {
 
   } // close module NPBRandom
 
+  /*
+     Philox Counter-Based Random Number Generator
+
+     This module provides the Philox4x32-10 random number generator from the
+     paper `Parallel Random Numbers: As Easy as 1, 2, 3` by J. K. Salmon,
+     M. A. Moraes, R. O. Dror, and D. E. Shaw (SC 2011).
+     See also https://www.deshawresearch.com/resources_random123.html
+
+     Philox is a counter-based RNG: the `n`-th block of random bits is a
+     keyed bijection of the counter `n`, so computing any value in the stream
+     takes the same constant time regardless of its position. This makes
+     skipping ahead free and lets every task of a parallel loop generate its
+     part of a stream independently, without communication.
+
+     Each evaluation of Philox4x32-10 produces 128 random bits, which are
+     split into four 32-bit values, two 64-bit values, or one 128-bit value
+     depending on the element type of the stream. Parallel iteration and
+     :proc:`PhiloxRandomStream.fillRandom` produce all of the values of a
+     block from one evaluation.
+
+     We have checked that this implementation matches the known-answer tests
+     of the Random123 reference implementation.
+
+     .. note::
+
+       The interface provided by this module is expected to change.
+
+  */
+  module PhiloxRandom {
+
+    use super.RandomSupport;
+    private use Random, IO;
+    use ChapelLocks;
+
+    /*
+      Models a stream of pseudorandom numbers generated by the Philox4x32-10
+      counter-based random number generator.  See the module-level notes for
+      :mod:`PhiloxRandom` for details on the PRNG used.
+
+      The seed is used as the 64-bit Philox key, and the position of a value
+      in the stream determines the counter used to generate it.
+
+      Generated reals are computed from a 64-bit (or, for `real(32)`, 32-bit)
+      unsigned integer multiplied by 2.0**-64 (2.0**-32), as
+      :class:`~PCGRandom.PCGRandomStream` does, so both 0.0 and 1.0 can be
+      generated.
+
+      Integers within particular bounds are generated by rejection sampling
+      from 64-bit values drawn from blocks reserved for that value, so that
+      the result only depends on the value's position in the stream.
+
+      While Philox passes the BigCrush suite of TestU01, it is not suitable
+      for generating key material for encryption.
+    */
+    class PhiloxRandomStream {
+      /*
+        Specifies the type of value generated by the PhiloxRandomStream.
+        All numeric types are supported: `int`, `uint`, `real`, `imag`,
+        `complex`, and `bool` types of all sizes.
+      */
+      type eltType;
+
+      /*
+        The seed value for the PRNG.
+      */
+      const seed: int(64);
+
+      /*
+        Indicates whether or not the PhiloxRandomStream needs to be
+        parallel-safe by default.  If multiple tasks interact with it in
+        an uncoordinated fashion, this must be set to `true`.  If it will
+        only be called from a single task, or if only one task will call
+        into it at a time, setting to `false` will reduce overhead related
+        to ensuring mutual exclusion.
+      */
+      param parSafe: bool = true;
+
+      /*
+        Creates a new stream of random numbers using the specified seed
+        and parallel safety.
+
+        :arg eltType: The element type to be generated.
+        :type eltType: `type`
+
+        :arg seed: The seed to use for the PRNG.  Defaults to
+          `currentTime` from :type:`RandomSupport.SeedGenerator`.
+          Can be any int(64) value.
+        :type seed: `int(64)`
+
+        :arg parSafe: The parallel safety setting.  Defaults to `true`.
+        :type parSafe: `bool`
+
+      */
+      proc init(type eltType,
+                seed: int(64) = SeedGenerator.currentTime,
+                param parSafe: bool = true) {
+        this.eltType = eltType;
+        this.seed = seed;
+        this.parSafe = parSafe;
+        this.complete();
+        PhiloxRandomStreamPrivate_count = 1;
+      }
+
+      pragma "no doc"
+      proc PhiloxRandomStreamPrivate_getNext_noLock(type resultType) {
+        checkSufficientBits(resultType, eltType);
+        param perBlock = valuesPerBlock(eltType);
+        const n = PhiloxRandomStreamPrivate_count - 1;
+        const block = n / perBlock;
+        PhiloxRandomStreamPrivate_count += 1;
+
+        // consecutive values usually share a block, so keep the last one
+        if block != PhiloxRandomStreamPrivate_blockNum {
+          PhiloxRandomStreamPrivate_block = philoxBlock(seed, block);
+          PhiloxRandomStreamPrivate_blockNum = block;
+        }
+        return wordsToValue(resultType, PhiloxRandomStreamPrivate_block,
+                            (n % perBlock):int * numWords(eltType));
+      }
+      pragma "no doc"
+      proc PhiloxRandomStreamPrivate_getNext_noLock(type resultType,
+                                                    min:resultType,
+                                                    max:resultType) {
+        PhiloxRandomStreamPrivate_count += 1;
+        return philoxBounded(resultType, eltType, seed,
+                             PhiloxRandomStreamPrivate_count-2, min, max);
+      }
+
+      /*
+        Returns the next value in the random stream.
+
+        Generated reals are in [0,1] - both 0.0 and 1.0 are possible values.
+        Imaginary numbers are analogously in [0i, 1i]. Complex numbers will
+        consist of a generated real and imaginary part, so 0.0+0.0i and 1.0+1.0i
+        are possible.
+
+        Generated integers cover the full value range of the integer.
+
+        :arg resultType: the type of the result. Defaults to :type:`eltType`.
+          `resultType` must be the same or a smaller size number.
+        :returns: The next value in the random stream as type `resultType`.
+       */
+      proc getNext(type resultType=eltType): resultType {
+        _lock();
+        const result = PhiloxRandomStreamPrivate_getNext_noLock(resultType);
+        _unlock();
+        return result;
+      }
+
+      /*
+        Return the next random value but within a particular range.
+        Returns a number in [`min`, `max`] (inclusive). Halts if checks are
+        enabled and ``min > max``.
+
+        For real numbers, this class generates a random value in [min, max]
+        by computing a random value in [0,1] and scaling and shifting that
+        value. Note that not all possible floating point values in
+        the interval [`min`, `max`] can be constructed in this way.
+       */
+      proc getNext(min: eltType, max:eltType): eltType {
+        use HaltWrappers;
+
+        _lock();
+        if boundsChecking && min > max then
+          HaltWrappers.boundsCheckHalt("Cannot generate random numbers within empty range: [" + min:string + ", " + max:string +  "]");
+
+        const result = PhiloxRandomStreamPrivate_getNext_noLock(eltType,min,max);
+        _unlock();
+        return result;
+      }
+
+      /*
+        As with getNext(min, max) but allows specifying the result type.
+       */
+      proc getNext(type resultType,
+                   min: resultType, max:resultType): resultType {
+        use HaltWrappers;
+
+        _lock();
+        if boundsChecking && min > max then
+          HaltWrappers.boundsCheckHalt("Cannot generate random numbers within empty range: [" + min:string + ", " + max:string + "]");
+
+        const result = PhiloxRandomStreamPrivate_getNext_noLock(resultType,min,max);
+        _unlock();
+        return result;
+      }
+
+      /*
+        Advances/rewinds the stream to the `n`-th value in the sequence.
+        The first value corresponds to n=0.  n must be >= 0, otherwise an
+        IllegalArgumentError is thrown.  This takes constant time.
+
+        :arg n: The position in the stream to skip to.  Must be >= 0.
+        :type n: `integral`
+
+        :throws IllegalArgumentError: When called with negative `n` value.
+       */
+      proc skipToNth(n: integral) throws {
+        if n < 0 then
+          throw new owned IllegalArgumentError("PhiloxRandomStream.skipToNth(n) called with negative 'n' value " + n:string);
+        _lock();
+        PhiloxRandomStreamPrivate_count = n+1;
+        _unlock();
+      }
+
+      /*
+        Advance/rewind the stream to the `n`-th value and return it
+        (advancing the stream by one).  n must be >= 0, otherwise an
+        IllegalArgumentError is thrown.  This is equivalent to
+        :proc:`skipToNth()` followed by :proc:`getNext()`.
+
+        :arg n: The position in the stream to skip to.  Must be >= 0.
+        :type n: `integral`
+
+        :returns: The `n`-th value in the random stream as type :type:`eltType`.
+        :throws IllegalArgumentError: When called with negative `n` value.
+       */
+      proc getNth(n: integral): eltType throws {
+        if (n < 0) then
+          throw new owned IllegalArgumentError("PhiloxRandomStream.getNth(n) called with negative 'n' value " + n:string);
+        _lock();
+        PhiloxRandomStreamPrivate_count = n+1;
+        const result = PhiloxRandomStreamPrivate_getNext_noLock(eltType);
+        _unlock();
+        return result;
+      }
+
+      /*
+        Fill the argument array with pseudorandom values.  This method is
+        identical to the standalone :proc:`~Random.fillRandom` procedure,
+        except that it consumes random values from the
+        :class:`PhiloxRandomStream` object on which it's invoked rather
+        than creating a new stream for the purpose of the call.
+
+        The values for each chunk of the array are computed by the task
+        that owns the chunk, so filling a distributed array does not
+        communicate.
+
+        :arg arr: The array to be filled
+        :type arr: [] :type:`eltType`
+      */
+      proc fillRandom(arr: [] eltType) {
+        if(!isRectangularArr(arr)) then
+          compilerError("fillRandom does not support non-rectangular arrays");
+
+        forall (x, r) in zip(arr, iterate(arr.domain, arr.eltType)) do
+          x = r;
+      }
+
+      pragma "no doc"
+      proc fillRandom(arr: []) {
+        compilerError("PhiloxRandomStream(eltType=", eltType:string,
+                      ") can only be used to fill arrays of ", eltType:string);
+      }
+
+      /*
+        Returns a random sample from a given 1-D array, ``x``.
+        See :proc:`PCGRandom.PCGRandomStream.choice` for the meaning of the
+        arguments.
+      */
+      proc choice(x: [?dom], size:?sizeType=none, replace=true, prob:?probType=none)
+        throws
+      {
+        var idx = _choice(this, dom, size=size, replace=replace, prob=prob);
+        return x[idx];
+      }
+
+      /*
+        Returns a random sample from a given bounded range, ``x``.
+        See :proc:`PCGRandom.PCGRandomStream.choice` for the meaning of the
+        arguments.
+      */
+      proc choice(x: range(stridable=?), size:?sizeType=none, replace=true, prob:?probType=none)
+        throws
+      {
+        var dom: domain(1,stridable=true);
+
+        if !isBoundedRange(x) {
+          throw new owned IllegalArgumentError('input range must be bounded');
+          dom = {1..2}; // this is a workaround for issue #15691
+        } else {
+          dom = {x};
+        }
+        return _choice(this, dom, size=size, replace=replace, prob=prob);
+      }
+
+      /*
+        Returns a random sample from a given 1-D domain, ``x``.
+        See :proc:`PCGRandom.PCGRandomStream.choice` for the meaning of the
+        arguments.
+      */
+      proc choice(x: domain, size:?sizeType=none, replace=true, prob:?probType=none)
+        throws
+      {
+        return _choice(this, x, size=size, replace=replace, prob=prob);
+      }
+
+      /* Randomly shuffle a 1-D array. */
+      proc shuffle(arr: [?D] ?eltType ) {
+
+        if(!isRectangularArr(arr)) then
+          compilerError("shuffle does not support non-rectangular arrays");
+
+        if D.rank != 1 then
+          compilerError("Shuffle requires 1-D array");
+
+        const low = D.alignedLow,
+              stride = abs(D.stride);
+
+        _lock();
+
+        const start = PhiloxRandomStreamPrivate_count - 1;
+
+        // Fisher-Yates shuffle
+        for (i, step) in zip(0..#D.size by -1, 0..) {
+          var k = philoxBounded(D.idxType, this.eltType, seed, start + step,
+                                0, i);
+
+          var j = i;
+
+          // Strided case
+          if stride > 1 {
+            k *= stride;
+            j *= stride;
+          }
+
+          // Alignment offsets
+          k += low;
+          j += low;
+
+          arr[k] <=> arr[j];
+        }
+
+        PhiloxRandomStreamPrivate_count += D.size;
+
+        _unlock();
+      }
+
+      /* Produce a random permutation, storing it in a 1-D array.
+         The resulting array will include each value from low..high
+         exactly once, where low and high refer to the array's domain.
+         */
+      proc permutation(arr: [] eltType) {
+
+        if(!isRectangularArr(arr)) then
+          compilerError("permutation does not support non-rectangular arrays");
+
+        var low = arr.domain.dim(0).low;
+        var high = arr.domain.dim(0).high;
+
+        if arr.domain.rank != 1 then
+          compilerError("Permutation requires 1-D array");
+
+        _lock();
+
+        const start = PhiloxRandomStreamPrivate_count - 1;
+
+        for i in low..high {
+          var j = philoxBounded(arr.domain.idxType, eltType, seed,
+                                start + (i - low), low, i);
+          arr[i] = arr[j];
+          arr[j] = i;
+        }
+
+        PhiloxRandomStreamPrivate_count += high-low;
+
+        _unlock();
+      }
+
+      /*
+
+         Returns an iterable expression for generating `D.size` random
+         numbers. The RNG state will be immediately advanced by `D.size`
+         before the iterable expression yields any values.
+
+         The returned iterable expression is useful in parallel contexts,
+         including standalone and zippered iteration. The domain will determine
+         the parallelization strategy.
+
+         :arg D: a domain
+         :arg resultType: the type of number to yield
+         :return: an iterable expression yielding random `resultType` values
+
+       */
+      pragma "fn returns iterator"
+      proc iterate(D: domain, type resultType=eltType) {
+        _lock();
+        const start = PhiloxRandomStreamPrivate_count - 1;
+        PhiloxRandomStreamPrivate_count += D.size.safeCast(int(64));
+        _unlock();
+        return PhiloxRandomPrivate_iterate(resultType, eltType, D, seed, start);
+      }
+
+      // Forward the leader iterator as well.
+      pragma "no doc"
+      pragma "fn returns iterator"
+      proc iterate(D: domain, type resultType=eltType, param tag)
+        where tag == iterKind.leader
+      {
+        // Note that proc iterate() for the serial case (i.e. the one above)
+        // is going to be invoked as well, so we should not be taking
+        // any actions here other than the forwarding.
+        const start = PhiloxRandomStreamPrivate_count - 1;
+        return PhiloxRandomPrivate_iterate(resultType, eltType, D, seed, start, tag);
+      }
+
+      pragma "no doc"
+      override proc writeThis(f) throws {
+        f <~> "PhiloxRandomStream(eltType=";
+        f <~> eltType:string;
+        f <~> ", parSafe=";
+        f <~> parSafe;
+        f <~> ", seed=";
+        f <~> seed;
+        f <~> ")";
+      }
+
+      ///////////////////////////////////////////////////////// CLASS PRIVATE //
+      //
+      // It is the intent that once Chapel supports the notion of
+      // 'private', everything in this class declared below this line will
+      // be made private to this class.
+      //
+
+      pragma "no doc"
+      var _l: if parSafe then chpl_LocalSpinlock else nothing;
+      pragma "no doc"
+      inline proc _lock() {
+        if parSafe then _l.lock();
+      }
+      pragma "no doc"
+      inline proc _unlock() {
+        if parSafe then _l.unlock();
+      }
+      pragma "no doc"
+      var PhiloxRandomStreamPrivate_count: int(64) = 1;
+      // the most recently generated block, for getNext()
+      pragma "no doc"
+      var PhiloxRandomStreamPrivate_block: 4*uint(32);
+      pragma "no doc"
+      var PhiloxRandomStreamPrivate_blockNum: int(64) = -1;
+    }
+
+
+    ////////////////////////////////////////////////////////// MODULE PRIVATE //
+    //
+    // It is the intent that once Chapel supports the notion of 'private',
+    // everything declared below this line will be made private to this
+    // module.
+    //
+
+    //
+    // Philox4x32 multipliers and Weyl sequence constants for the key schedule
+    //
+    private param philoxM0 = 0xD2511F53:uint(32),
+                  philoxM1 = 0xCD9E8D57:uint(32),
+                  philoxW0 = 0x9E3779B9:uint(32),
+                  philoxW1 = 0xBB67AE85:uint(32);
+
+    private param philoxRounds = 10;
+
+    //
+    // Philox4x32-10 bijection of 'ctr' keyed by 'key'
+    //
+    private inline
+    proc philox4x32(in ctr: 4*uint(32), in key: 2*uint(32)): 4*uint(32) {
+      for param r in 0..philoxRounds-1 {
+        if r > 0 {
+          key(0) += philoxW0;
+          key(1) += philoxW1;
+        }
+        const p0 = philoxM0:uint(64) * ctr(0):uint(64),
+              p1 = philoxM1:uint(64) * ctr(2):uint(64);
+        ctr = ((p1 >> 32):uint(32) ^ ctr(1) ^ key(0), p1:uint(32),
+               (p0 >> 32):uint(32) ^ ctr(3) ^ key(1), p0:uint(32));
+      }
+      return ctr;
+    }
+
+    //
+    // Returns the 'block'-th block of 128 random bits for 'seed'. The
+    // upper counter words distinguish the extra blocks used by bounded
+    // generation from the stream itself.
+    //
+    private inline
+    proc philoxBlock(seed: int(64), block: int(64),
+                     attempt: uint(32) = 0, slot: uint(32) = 0) {
+      const useed = seed:uint(64), ublock = block:uint(64);
+      return philox4x32((ublock:uint(32), (ublock >> 32):uint(32),
+                         attempt, slot),
+                        (useed:uint(32), (useed >> 32):uint(32)));
+    }
+
+    // How many 32-bit words make up a value of this type?
+    private
+    proc numWords(type t) param {
+      if isBoolType(t) then return 1;
+      else return (numBits(t)+31) / 32;
+    }
+
+    // How many values of this type does one block hold?
+    private
+    proc valuesPerBlock(type t) param {
+      return 4 / numWords(t);
+    }
+
+    private
+    proc checkSufficientBits(type resultType, type eltType) {
+      if numWords(resultType) > numWords(eltType) then
+        compilerError("PhiloxRandomStream cannot produce " +
+                      resultType:string +
+                      " (requiring " +
+                      (32*numWords(resultType)):string +
+                      " bits) from a stream configured for " +
+                      (32*numWords(eltType)):string +
+                      " bits of output");
+    }
+
+    // returns a random number in [0, 1]
+    // where the number is a multiple of 2**-64
+    private inline
+    proc randToReal64(x: uint(64)):real(64)
+    {
+      return ldexp(x:real(64), -64);
+    }
+
+    // returns a random number in [0, 1]
+    // where the number is a rounded multiple of 2**-24
+    private inline
+    proc randToReal32(x: uint(32))
+    {
+      return ldexp(x:real(32), -32);
+    }
+
+    private inline
+    proc words64(w: 4*uint(32), off: int): uint(64) {
+      return (w(off):uint(64) << 32) | w(off+1):uint(64);
+    }
+
+    //
+    // Convert the words of 'w' starting at 'off' into a resultType value
+    //
+    private inline
+    proc wordsToValue(type resultType, w: 4*uint(32), off: int) {
+      if resultType == complex(128) {
+        return (randToReal64(words64(w, off)),
+                randToReal64(words64(w, off+2))):complex(128);
+      } else if resultType == complex(64) {
+        return (randToReal32(w(off)),
+                randToReal32(w(off+1))):complex(64);
+      } else if resultType == imag(64) {
+        return _r2i(randToReal64(words64(w, off)));
+      } else if resultType == imag(32) {
+        return _r2i(randToReal32(w(off)));
+      } else if resultType == real(64) {
+        return randToReal64(words64(w, off));
+      } else if resultType == real(32) {
+        return randToReal32(w(off));
+      } else if resultType == uint(64) || resultType == int(64) {
+        return words64(w, off):resultType;
+      } else if resultType == uint(32) || resultType == int(32) {
+        return w(off):resultType;
+      } else if(resultType == uint(16) ||
+                resultType == int(16)) {
+        return (w(off) >> 16):resultType;
+      } else if(resultType == uint(8) ||
+                resultType == int(8)) {
+        return (w(off) >> 24):resultType;
+      } else if isBoolType(resultType) {
+        return (w(off) >> 31) != 0;
+      }
+    }
+
+    //
+    // Returns the value at 0-based position 'n' of the stream, in constant
+    // time
+    //
+    private inline
+    proc philoxValue(type resultType, type eltType, seed: int(64), n: int(64)) {
+      checkSufficientBits(resultType, eltType);
+      param perBlock = valuesPerBlock(eltType);
+      return wordsToValue(resultType, philoxBlock(seed, n / perBlock),
+                          (n % perBlock):int * numWords(eltType));
+    }
+
+    //
+    // Yields 'count' values starting at 0-based position 'start', computing
+    // each block of values once
+    //
+    private iter philoxValues(type resultType, type eltType, seed: int(64),
+                              start: int(64), count: int(64)) {
+      checkSufficientBits(resultType, eltType);
+      param words = numWords(eltType),
+            perBlock = valuesPerBlock(eltType);
+      const end = start + count;
+      var n = start;
+      while n < end {
+        const block = n / perBlock,
+              blockStart = block * perBlock;
+        const w = philoxBlock(seed, block);
+        for slot in (n - blockStart):int..<min(perBlock, end - blockStart):int do
+          yield wordsToValue(resultType, w, slot * words);
+        n = blockStart + perBlock;
+      }
+    }
+
+    //
+    // Returns the value at 0-based position 'n' of the stream, but within
+    // [min, max]. Integers are sampled without bias by rejecting 64-bit
+    // values from the blocks reserved for position 'n'.
+    //
+    private proc philoxBounded(type resultType, type eltType,
+                               seed: int(64), n: int(64), minVal, maxVal) {
+      if isBoolType(resultType) {
+        compilerError("bounded rand with boolean type");
+        return false;
+      } else if isIntegralType(resultType) {
+        param perBlock = valuesPerBlock(eltType);
+        const block = n / perBlock, slot = (n % perBlock):uint(32);
+        const bound = maxVal:uint(64) - minVal:uint(64);
+        var attempt = 1:uint(32);
+        var x = words64(philoxBlock(seed, block, attempt, slot), 0);
+        if bound != max(uint(64)) {
+          const numVals = bound + 1;
+          const threshold = (0:uint(64) - numVals) % numVals;
+          while x < threshold {
+            attempt += 1;
+            x = words64(philoxBlock(seed, block, attempt, slot), 0);
+          }
+          x %= numVals;
+        }
+        return (minVal:uint(64) + x):resultType;
+      } else {
+        const r = philoxValue(resultType, eltType, seed, n);
+        if isComplexType(resultType) then
+          return ((maxVal.re-minVal.re)*r.re + minVal.re,
+                  (maxVal.im-minVal.im)*r.im + minVal.im):resultType;
+        else if isImagType(resultType) then
+          return _r2i((_i2r(maxVal)-_i2r(minVal))*_i2r(r) + _i2r(minVal));
+        else
+          return (maxVal-minVal)*r + minVal;
+      }
+    }
+
+    //
+    // iterate over outer ranges in tuple of ranges
+    //
+    pragma "order independent yielding loops"
+    private iter outer(ranges, param dim: int = 0) {
+      if dim + 2 == ranges.size {
+        for i in ranges(dim) do
+          yield (i,);
+      } else if dim + 2 < ranges.size {
+        for i in ranges(dim) do
+          for j in outer(ranges, dim+1) do
+            yield (i, (...j));
+      } else {
+        yield 0; // 1D case is a noop
+      }
+    }
+
+    //
+    // PhiloxRandomStream iterator implementation
+    //
+    pragma "no doc"
+    pragma "not order independent yielding loops"
+    iter PhiloxRandomPrivate_iterate(type resultType, type eltType, D: domain,
+                                     seed: int(64), start: int(64)) {
+      for r in philoxValues(resultType, eltType, seed, start,
+                            D.size.safeCast(int(64))) do
+        yield r;
+    }
+
+    pragma "no doc"
+    iter PhiloxRandomPrivate_iterate(type resultType, type eltType, D: domain,
+                                     seed: int(64), start: int(64),
+                                     param tag: iterKind)
+          where tag == iterKind.leader {
+      for block in D.these(tag=iterKind.leader) do
+        yield block;
+    }
+
+    pragma "no doc"
+    pragma "not order independent yielding loops"
+    iter PhiloxRandomPrivate_iterate(type resultType, type eltType, D: domain,
+                                     seed: int(64), start: int(64),
+                                     param tag: iterKind, followThis)
+          where tag == iterKind.follower {
+      use DSIUtil;
+      const ZD = computeZeroBasedDomain(D);
+      const innerRange = followThis(ZD.rank-1);
+      for outer in outer(followThis) {
+        var myStart = start;
+        if ZD.rank > 1 then
+          myStart += ZD.indexOrder(((...outer), innerRange.low)).safeCast(int(64));
+        else
+          myStart += ZD.indexOrder(innerRange.low).safeCast(int(64));
+        if !innerRange.stridable || innerRange.stride == 1 {
+          for r in philoxValues(resultType, eltType, seed, myStart,
+                                innerRange.size.safeCast(int(64))) do
+            yield r;
+        } else {
+          myStart -= innerRange.low.safeCast(int(64));
+          for i in innerRange do
+            yield philoxValue(resultType, eltType, seed,
+                              myStart + i.safeCast(int(64)));
+        }
+      }
+    }
+
+  } // close module PhiloxRandom
+
+
 
 
 } // close module Random
@@ -25,9 +25,25 @@
 extern "C" {
 #endif
 
+// How many strided access streams does the cache track per task?
+#define CHPL_CACHE_STREAMS_PER_TASK 4
+
+// A strided access stream detected by the cache's stride prefetcher.
+typedef struct {
+  uintptr_t last_raddr;    // address of the last access (0 if unused)
+  intptr_t stride;         // distance between the last two accesses
+  uintptr_t prefetched_to; // furthest address prefetched along the stream
+  int32_t node;            // node the stream's accesses go to
+  int8_t confidence;       // how many times in a row the stride repeated
+  int8_t distance;         // how many strides ahead to prefetch
+} chpl_cache_stream_t;
+
 // This is the type of the task private data used by the cache
 typedef struct {
   int64_t last_acquire; // cache acquire barrier sets this
+  uint64_t shards_dirtied; // shared cache: shards written since last release
+  // strided streams, most recently used first
+  chpl_cache_stream_t streams[CHPL_CACHE_STREAMS_PER_TASK];
 } chpl_cache_taskPrvData_t;
 
 #ifdef __cplusplus
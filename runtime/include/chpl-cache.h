@@ -93,6 +93,16 @@ void chpl_cache_acquire(int ln, int32_t fn)
 {
   if (chpl_cache_enabled()) chpl_cache_fence(1, 0, ln, fn);
 }
+// "acquire" fence at the start of a task or 'on' statement body.
+// This is the same as chpl_cache_acquire but is counted separately
+// in the comm diagnostics.
+void chpl_cache_start_fence(int ln, int32_t fn);
+
+static inline
+void chpl_cache_start_acquire(int ln, int32_t fn)
+{
+  if (chpl_cache_enabled()) chpl_cache_start_fence(ln, fn);
+}
 // "release" barrier or fence -> complete pending PUTs
 static inline
 void chpl_cache_release(int ln, int32_t fn)
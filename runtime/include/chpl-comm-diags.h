@@ -58,7 +58,21 @@ extern int chpl_comm_diags_print_unstable;
   MACRO(cache_get_hits) \
   MACRO(cache_get_misses) \
   MACRO(cache_put_hits) \
-  MACRO(cache_put_misses)
+  MACRO(cache_put_misses) \
+  MACRO(cache_stride_prefetches) \
+  MACRO(cache_stride_hits) \
+  MACRO(cache_stride_misses) \
+  MACRO(cache_stride_wasted) \
+  MACRO(cache_readahead_issued) \
+  MACRO(cache_readahead_used) \
+  MACRO(cache_write_behind_puts) \
+  MACRO(cache_write_behind_bytes) \
+  MACRO(cache_evict_ain) \
+  MACRO(cache_evict_aout) \
+  MACRO(cache_evict_am) \
+  MACRO(cache_acquire_invalidations) \
+  MACRO(cache_start_invalidations) \
+  MACRO(cache_wait_ns)
 
 
 typedef struct _chpl_commDiagnostics {
@@ -188,6 +202,15 @@ int chpl_comm_diags_is_enabled(void) {
     }                                                                        \
   } while(0)
 
+#define chpl_comm_diags_add(_ctr, _val)                                      \
+  do {                                                                       \
+    if (chpl_comm_diagnostics && chpl_comm_diags_is_enabled()) {             \
+      atomic_uint_least64_t* ctrAddr = &chpl_comm_diags_counters._ctr;       \
+      (void) atomic_fetch_add_explicit_uint_least64_t(ctrAddr, (_val),       \
+                                                      memory_order_relaxed); \
+    }                                                                        \
+  } while(0)
+
 #ifdef __cplusplus
 }
 #endif
@@ -39,6 +39,13 @@ extern "C" {
 //
 wide_ptr_t* chpl_comm_broadcast_global_vars_helper(void);
 
+//
+// Support for the default collectives in chpl-comm-coll.c.  Comm layer
+// implementations must supply this.  It is called collectively, once,
+// during startup.  It must set all[i] to node i's value of 'mine'.
+//
+void chpl_comm_coll_allgather_addrs_helper(void* mine, void** all);
+
 //
 // These are runtime-private copies of chpl_private_broadcast_table[]
 // and chpl_private_broadcast_table_len, extended with a few more
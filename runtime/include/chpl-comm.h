@@ -392,6 +392,120 @@ void chpl_comm_broadcast_private(int id, size_t size);
 //
 void chpl_comm_barrier(const char *msg);
 
+//
+// Collective operations between all top-level locales.  Each of these
+// must be called by exactly one task on every node, and all the nodes
+// must make the same sequence of collective calls (including those made
+// by other collectives, such as chpl_comm_barrier()), with the same
+// root, counts, sizes, types and operations.  Like chpl_comm_barrier(),
+// these may be called from Chapel tasks and must yield while waiting for
+// the other nodes.
+//
+// Comm layers with native collectives may supply their own versions via
+// the CHPL_COMM_IMPL_COLL_*() macros.  Otherwise the defaults in
+// chpl-comm-coll.c are used, which implement them with PUTs, using
+// recursive doubling where the data can be combined.
+//
+typedef enum {
+  CHPL_COMM_COLL_INT32,
+  CHPL_COMM_COLL_INT64,
+  CHPL_COMM_COLL_UINT32,
+  CHPL_COMM_COLL_UINT64,
+  CHPL_COMM_COLL_REAL32,
+  CHPL_COMM_COLL_REAL64,
+} chpl_comm_coll_type_t;
+
+// the bitwise operations only apply to the integral types
+typedef enum {
+  CHPL_COMM_COLL_SUM,
+  CHPL_COMM_COLL_PROD,
+  CHPL_COMM_COLL_MIN,
+  CHPL_COMM_COLL_MAX,
+  CHPL_COMM_COLL_BAND,
+  CHPL_COMM_COLL_BOR,
+  CHPL_COMM_COLL_BXOR,
+} chpl_comm_coll_op_t;
+
+//
+// Set up for the default collectives.  This is called collectively
+// during startup, after chpl_comm_post_task_init().
+//
+void chpl_comm_coll_init(void);
+
+void chpl_comm_coll_dflt_broadcast(c_nodeid_t root, void* buf, size_t size);
+void chpl_comm_coll_dflt_allreduce(void* buf, size_t count,
+                                   chpl_comm_coll_type_t type,
+                                   chpl_comm_coll_op_t op);
+void chpl_comm_coll_dflt_allgather(const void* src, void* dst, size_t size);
+void chpl_comm_coll_dflt_alltoallv(const void* src, const size_t* srcCounts,
+                                   const size_t* srcDispls,
+                                   void* dst, const size_t* dstDispls);
+
+//
+// Copy 'size' bytes at 'buf' on node 'root' to 'buf' on every node.
+//
+#ifndef CHPL_COMM_IMPL_COLL_BROADCAST
+#define CHPL_COMM_IMPL_COLL_BROADCAST(root, buf, size) \
+        chpl_comm_coll_dflt_broadcast(root, buf, size)
+#endif
+static inline
+void chpl_comm_coll_broadcast(c_nodeid_t root, void* buf, size_t size) {
+  CHPL_COMM_IMPL_COLL_BROADCAST(root, buf, size);
+}
+
+//
+// Combine the 'count' elements of type 'type' at 'buf' across all the
+// nodes, elementwise, using 'op', and leave the result in 'buf' on every
+// node.  Floating point results may differ slightly between nodes if
+// the implementation combines the values in different orders on them.
+//
+#ifndef CHPL_COMM_IMPL_COLL_ALLREDUCE
+#define CHPL_COMM_IMPL_COLL_ALLREDUCE(buf, count, type, op) \
+        chpl_comm_coll_dflt_allreduce(buf, count, type, op)
+#endif
+static inline
+void chpl_comm_coll_allreduce(void* buf, size_t count,
+                              chpl_comm_coll_type_t type,
+                              chpl_comm_coll_op_t op) {
+  CHPL_COMM_IMPL_COLL_ALLREDUCE(buf, count, type, op);
+}
+
+//
+// Gather 'size' bytes at 'src' from every node into 'dst' on every node,
+// with node i's bytes at dst + i * size.
+//
+#ifndef CHPL_COMM_IMPL_COLL_ALLGATHER
+#define CHPL_COMM_IMPL_COLL_ALLGATHER(src, dst, size) \
+        chpl_comm_coll_dflt_allgather(src, dst, size)
+#endif
+static inline
+void chpl_comm_coll_allgather(const void* src, void* dst, size_t size) {
+  CHPL_COMM_IMPL_COLL_ALLGATHER(src, dst, size);
+}
+
+//
+// Personalized all-to-all exchange.  Node i sends srcCounts[j] bytes at
+// src + srcDispls[j] to node j, which stores them at dst + dstDispls[i].
+// All the data has arrived everywhere by the time any node returns.
+// chpl_comm_coll_alltoall() is the special case where every node sends
+// 'size' bytes to each node, in node order, and receives them in node
+// order.
+//
+#ifndef CHPL_COMM_IMPL_COLL_ALLTOALLV
+#define CHPL_COMM_IMPL_COLL_ALLTOALLV(src, srcCounts, srcDispls,         \
+                                      dst, dstDispls)                    \
+        chpl_comm_coll_dflt_alltoallv(src, srcCounts, srcDispls,         \
+                                      dst, dstDispls)
+#endif
+static inline
+void chpl_comm_coll_alltoallv(const void* src, const size_t* srcCounts,
+                              const size_t* srcDispls,
+                              void* dst, const size_t* dstDispls) {
+  CHPL_COMM_IMPL_COLL_ALLTOALLV(src, srcCounts, srcDispls, dst, dstDispls);
+}
+
+void chpl_comm_coll_alltoall(const void* src, void* dst, size_t size);
+
 //
 // Do exit processing that has to occur before the tasking layer is
 // shut down.  "The "all" parameter is true for normal, collective
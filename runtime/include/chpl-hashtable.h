@@ -0,0 +1,105 @@
+/*
+ * Copyright 2020-2021 Hewlett Packard Enterprise Development LP
+ * Copyright 2004-2019 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Group probing support for chpl__hashtable (modules/internal/
+// ChapelHashtable.chpl). The table keeps one control byte per slot, and
+// these functions compare the CHPL_HASHTABLE_GROUP_WIDTH control bytes
+// starting at 'ctrl' all at once. Each returns a mask with bit i set when
+// byte i matches.
+
+#ifndef _chpl_hashtable_h_
+#define _chpl_hashtable_h_
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CHPL_HASHTABLE_GROUP_WIDTH 16
+
+#if !defined(__SSE2__) && defined(__BYTE_ORDER__) && \
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+// Gathers the high bit of each byte of 'x' into the low 8 bits
+static inline uint32_t chpl_hashtable_word_mask(uint64_t x) {
+  return (uint32_t)((((x >> 7) & UINT64_C(0x0101010101010101)) *
+                     UINT64_C(0x0102040810204080)) >> 56);
+}
+
+// Sets the high bit of each byte of 'x' that is zero
+static inline uint64_t chpl_hashtable_word_zeros(uint64_t x) {
+  const uint64_t low7 = UINT64_C(0x7f7f7f7f7f7f7f7f);
+  return ~(((x & low7) + low7) | x | low7);
+}
+#endif
+
+// Returns the bytes equal to 'b'
+static inline uint32_t chpl_hashtable_match_byte(const uint8_t* ctrl,
+                                                 uint8_t b) {
+#if defined(__SSE2__)
+  __m128i group = _mm_loadu_si128((const __m128i*)ctrl);
+  __m128i match = _mm_cmpeq_epi8(group, _mm_set1_epi8((char)b));
+  return (uint32_t)_mm_movemask_epi8(match);
+#elif defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  const uint64_t pattern = UINT64_C(0x0101010101010101) * b;
+  uint64_t lo, hi;
+  memcpy(&lo, ctrl, sizeof(lo));
+  memcpy(&hi, ctrl + sizeof(lo), sizeof(hi));
+  return chpl_hashtable_word_mask(chpl_hashtable_word_zeros(lo ^ pattern)) |
+         chpl_hashtable_word_mask(chpl_hashtable_word_zeros(hi ^ pattern)) << 8;
+#else
+  uint32_t mask = 0;
+  int i;
+  for (i = 0; i < CHPL_HASHTABLE_GROUP_WIDTH; i++)
+    mask |= (uint32_t)(ctrl[i] == b) << i;
+  return mask;
+#endif
+}
+
+// Returns the bytes with their high bit clear
+static inline uint32_t chpl_hashtable_match_high_clear(const uint8_t* ctrl) {
+#if defined(__SSE2__)
+  __m128i group = _mm_loadu_si128((const __m128i*)ctrl);
+  return (uint32_t)_mm_movemask_epi8(group) ^ 0xffff;
+#elif defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  uint64_t lo, hi;
+  memcpy(&lo, ctrl, sizeof(lo));
+  memcpy(&hi, ctrl + sizeof(lo), sizeof(hi));
+  return (chpl_hashtable_word_mask(lo) |
+          chpl_hashtable_word_mask(hi) << 8) ^ 0xffff;
+#else
+  uint32_t mask = 0;
+  int i;
+  for (i = 0; i < CHPL_HASHTABLE_GROUP_WIDTH; i++)
+    mask |= (uint32_t)((ctrl[i] & 0x80) == 0) << i;
+  return mask;
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -31,6 +31,7 @@
 #include "chpl-mem-desc.h"
 #include "chpl-mem-hook.h"
 #include "chpl-topo.h"
+#include "chplsys.h"
 #include "chpltypes.h"
 #include "error.h"
 
@@ -50,6 +51,29 @@ chpl_bool chpl_mem_size_justifies_comm_alloc(size_t size) {
 }
 
 
+static inline
+void chpl_mem_array_localize(void* p, size_t size, c_sublocid_t subloc) {
+  //
+  // Set the NUMA policy for the pages of a freshly allocated array, so
+  // that whoever first-touches them the pages end up where the tasks
+  // iterating over them will run.  A specific sublocale gets the whole
+  // array.  For c_sublocid_all the pages are split evenly across the
+  // NUMA domains in order, which matches the way the DefaultRectangular
+  // leader iterator hands out its per-sublocale chunks.  Arrays smaller
+  // than a couple of pages aren't worth the system calls.
+  //
+  if (p == NULL || size < 2 * chpl_getHeapPageSize()) {
+    return;
+  }
+
+  if (subloc == c_sublocid_all) {
+    chpl_topo_setMemSubchunkLocality(p, size, true, NULL);
+  } else if (isActualSublocID(subloc)) {
+    chpl_topo_setMemLocality(p, size, true, subloc);
+  }
+}
+
+
 static inline
 void* chpl_mem_array_alloc(size_t nmemb, size_t eltSize,
                            c_sublocid_t subloc, chpl_bool* callPostAlloc,
@@ -82,6 +106,7 @@ void* chpl_mem_array_alloc(size_t nmemb, size_t eltSize,
 
   if (p == NULL) {
     p = chpl_malloc(nmemb * eltSize);
+    chpl_mem_array_localize(p, size, subloc);
   }
 
   chpl_memhook_malloc_post(p, nmemb, eltSize, CHPL_RT_MD_ARRAY_ELEMENTS,
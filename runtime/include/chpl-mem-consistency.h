@@ -78,6 +78,16 @@ void chpl_rmem_consist_acquire(int ln, int32_t fn)
 #endif
 }
 
+// Acquire fence at the start of a task or 'on' statement body
+// (see PRIM_START_RMEM_FENCE).
+static inline
+void chpl_rmem_consist_start_acquire(int ln, int32_t fn)
+{
+#ifdef HAS_CHPL_CACHE_FNS
+  chpl_cache_start_acquire(ln, fn);
+#endif
+}
+
 
 // These should just call chpl_cache_release or chpl_cache_acquire. They
 // exist so that we have a single place to put any required memory consistency 
@@ -192,6 +192,22 @@ void* chpl_mem_layerAlloc(size_t, int32_t lineno, int32_t filename);
 void* chpl_mem_layerRealloc(void*, size_t, int32_t lineno, int32_t filename);
 void chpl_mem_layerFree(void*, int32_t lineno, int32_t filename);
 
+//
+// Dedicated allocation arenas, for temporary buffers that share a
+// lifetime.  Everything allocated from an arena is released at once by
+// chpl_mem_arena_reset() or chpl_mem_arena_destroy(); there is no way to
+// free a single allocation.  These allocations are not seen by memory
+// tracking.  An arena may be used by several tasks at once, but only on
+// the locale that created it.  Each memory layer implements these.
+//
+typedef struct chpl_mem_arena_s* chpl_mem_arena_t;
+
+chpl_mem_arena_t chpl_mem_arena_create(void);
+// alignment 0 means the default alignment
+void* chpl_mem_arena_alloc(chpl_mem_arena_t, size_t size, size_t alignment);
+void chpl_mem_arena_reset(chpl_mem_arena_t);
+void chpl_mem_arena_destroy(chpl_mem_arena_t);
+
 #ifdef __cplusplus
 }
 #endif
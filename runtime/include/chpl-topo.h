@@ -61,7 +61,8 @@ int chpl_topo_getNumNumaDomains(void);
 void chpl_topo_setThreadLocality(c_sublocid_t);
 
 //
-// get the sublocale where the current thread is running
+// get the sublocale where the current thread is running, or
+// c_sublocid_any if it may run in more than one
 //
 c_sublocid_t chpl_topo_getThreadLocality(void);
 
@@ -110,6 +111,36 @@ void chpl_topo_touchMemFromSubloc(void*, size_t, chpl_bool, c_sublocid_t);
 //
 c_sublocid_t chpl_topo_getMemLocality(void*);
 
+//
+// NUMA locality diagnostics
+//
+// While these are enabled, chpl_topo_numaDiagsSample() looks at where
+// (a sample of) the pages wholly inside a block of memory live and
+// counts them as local or remote relative to a given sublocale.  If
+// that sublocale is not an actual one, the NUMA domain the calling
+// thread is bound to is used instead.  The counts are per top-level
+// locale.
+//
+void chpl_topo_numaDiagsStart(void);
+void chpl_topo_numaDiagsStop(void);
+void chpl_topo_numaDiagsReset(void);
+chpl_bool chpl_topo_numaDiagsEnabled(void);
+
+//
+// args:
+//   base address
+//   size (bytes)
+//   sublocale doing the accesses
+//
+void chpl_topo_numaDiagsSample(void*, size_t, c_sublocid_t);
+
+//
+// args:
+//   (out) number of sampled pages that were local
+//   (out) number of sampled pages that were remote
+//
+void chpl_topo_numaDiagsGet(uint64_t*, uint64_t*);
+
 
 #ifdef __cplusplus
 } // end extern "C"
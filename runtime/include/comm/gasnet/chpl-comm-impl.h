@@ -33,6 +33,18 @@ extern "C" {
     chpl_comm_impl_regMemHeapInfo(start_p, size_p)
 void chpl_comm_impl_regMemHeapInfo(void** start_p, size_t* size_p);
 
+//
+// Native collectives.  The type and op are chpl_comm_coll_type_t and
+// chpl_comm_coll_op_t values, which aren't declared yet here.
+//
+#define CHPL_COMM_IMPL_COLL_BROADCAST(root, buf, size) \
+        chpl_comm_impl_collBroadcast(root, buf, size)
+void chpl_comm_impl_collBroadcast(c_nodeid_t root, void* buf, size_t size);
+
+#define CHPL_COMM_IMPL_COLL_ALLREDUCE(buf, count, type, op) \
+        chpl_comm_impl_collAllreduce(buf, count, type, op)
+void chpl_comm_impl_collAllreduce(void* buf, size_t count, int type, int op);
+
 #ifdef __cplusplus
 }
 #endif
@@ -45,6 +45,10 @@ typedef struct {
 // The type of the communication handle.
 typedef void* chpl_comm_nb_handle_t;
 
+// GASNet nonblocking handles can only be synced by the thread that
+// created them, so the remote cache cannot share them across threads.
+#define CHPL_COMM_NB_HANDLES_THREAD_BOUND
+
 #ifdef __cplusplus
 }
 #endif
@@ -25,9 +25,16 @@
 
 #include <sys/types.h>
 #include <stdlib.h>
+#include <string.h>
 #include <inttypes.h>
 #include <wchar.h>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "utf8-decoder.h"
 
 #ifdef __cplusplus
@@ -200,10 +207,50 @@ int chpl_enc_decode_char_buf_wctype(int32_t* CHPL_ENC_RESTRICT chr,
 #endif
 }
 
+/*
+ * Returns the number of leading ASCII bytes in the char buffer, looking at no
+ * more than `buflen` bytes.  The widest vector instructions the target was
+ * compiled for are used to skip over runs of ASCII, with a portable 8-byte
+ * word loop for the rest.
+ */
+static inline
+ssize_t chpl_enc_ascii_prefix_len(const char* buf, ssize_t buflen) {
+  ssize_t i = 0;
+
+#if defined(__AVX2__)
+  for (; i + 32 <= buflen; i += 32) {
+    __m256i v = _mm256_loadu_si256((const __m256i*)(buf + i));
+    if (_mm256_movemask_epi8(v) != 0)
+      break;
+  }
+#endif
+
+#if defined(__SSE2__)
+  for (; i + 16 <= buflen; i += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i*)(buf + i));
+    if (_mm_movemask_epi8(v) != 0)
+      break;
+  }
+#endif
+
+  for (; i + 8 <= buflen; i += 8) {
+    uint64_t w;
+    memcpy(&w, buf + i, sizeof(w));
+    if ((w & UINT64_C(0x8080808080808080)) != 0)
+      break;
+  }
+
+  while (i < buflen && (unsigned char)buf[i] < 0x80)
+    i++;
+
+  return i;
+}
+
 /*
  * Check if the bytes in the char buffer form a valid UTF8 sequence
  *
  * :arg buflen: Upper limit for number of bytes to read
+ * :arg num_cp: An out argument that stores the number of codepoints read
  *
  * :returns: 0 if valid, -1 if illegal byte sequence
  */
@@ -212,18 +259,28 @@ int chpl_enc_validate_buf(const char *buf, ssize_t buflen, int64_t *num_cp) {
   int32_t cp;
   int nbytes;
 
-  int offset = 0;
-  *num_cp = 0;
+  ssize_t offset = 0;
+  int64_t count = 0;
   while (offset<buflen) {
+    // ASCII bytes are always valid and are one codepoint each
+    ssize_t nascii = chpl_enc_ascii_prefix_len(buf+offset, buflen-offset);
+    offset += nascii;
+    count += nascii;
+    if (offset >= buflen) {
+      break;
+    }
+
     // you can create a chapel string with a codepoint that represents an
     // escaped byte, so the last argument is true
     if (chpl_enc_decode_char_buf_utf8(&cp, &nbytes, buf+offset,
                                       buflen-offset, true) != 0) {
+      *num_cp = count;
       return -1;  // invalid : return EILSEQ
     }
     offset += nbytes;
-    *num_cp += 1;
+    count += 1;
   }
+  *num_cp = count;
   return 0;  // valid
 }
 
@@ -23,6 +23,7 @@
 #define _chpl_mem_impl_H_
 
 #include "chpl-mem-jemalloc-prefix.h"
+#include "chpl-thread-local-storage.h"
 
 #include "jemalloc/jemalloc.h"
 
@@ -57,6 +58,23 @@ static inline int CHPL_JE_MALLOCX_ARENA_FLAG(size_t size) {
 }
 
 
+// Bind the calling thread to an arena for its NUMA domain, if that hasn't
+// been done yet.  See the thread arenas in mem-jemalloc.c.  Without
+// thread-local storage we leave the choice of arena to jemalloc.
+#ifdef CHPL_TLS
+extern CHPL_TLS_DECL(chpl_bool, chpl_je_thread_arena_bound);
+void chpl_je_bind_thread_arena(void);
+
+static inline void chpl_je_check_thread_arena(void) {
+  if (!CHPL_TLS_GET(chpl_je_thread_arena_bound)) {
+    chpl_je_bind_thread_arena();
+  }
+}
+#else
+static inline void chpl_je_check_thread_arena(void) { }
+#endif
+
+
 // jemalloc extended API requires non-0 sized allocations and non-NULL frees.
 // Use a min size of 1 (instead of returning NULL) since our memory API
 // interprets a NULL return as an out-of-memory sentinel
@@ -69,20 +87,24 @@ static inline size_t minSize(size_t size) {
 
 static inline void* chpl_calloc(size_t n, size_t size) {
   size_t nSize = minSize(n*size);
+  chpl_je_check_thread_arena();
   return CHPL_JE_MALLOCX(nSize, MALLOCX_ZERO | CHPL_JE_MALLOCX_ARENA_FLAG(nSize));
 }
 
 static inline void* chpl_malloc(size_t size) {
   size = minSize(size);
+  chpl_je_check_thread_arena();
   return CHPL_JE_MALLOCX(size, CHPL_JE_MALLOCX_ARENA_FLAG(size));
 }
 
 static inline void* chpl_memalign(size_t boundary, size_t size) {
   size = minSize(size);
+  chpl_je_check_thread_arena();
   return CHPL_JE_MALLOCX(size, MALLOCX_ALIGN(boundary) | CHPL_JE_MALLOCX_ARENA_FLAG(size));
 }
 
 static inline void* chpl_realloc(void* ptr, size_t size) {
+  chpl_je_check_thread_arena();
   if (ptr == NULL) {
     size = minSize(size);
     return CHPL_JE_MALLOCX(size, CHPL_JE_MALLOCX_ARENA_FLAG(size));
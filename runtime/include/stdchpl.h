@@ -51,6 +51,7 @@
 #include "chpl-file-utils.h"
 #include <chplfp.h>
 #include "chplglob.h"
+#include "chpl-hashtable.h"
 #include "chplio.h"
 #include "chplmath.h"
 #include "chpl-init.h"
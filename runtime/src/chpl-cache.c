@@ -198,6 +198,14 @@ buffer.
 When processing GETs on adjacent memory locations, the cache triggers
 both synchronous and asynchronous read-ahead.
 
+Strided access (e.g. walking a column of a distributed 2D array) does not
+look sequential, so each task also tracks a few access streams. When a
+stream repeats the same stride (forward or backward), the cache prefetches
+a number of strides ahead of it. That distance adapts: it grows when the
+prefetched data is used and shrinks when the stream changes direction or
+stride and abandons what was prefetched. The stride prefetcher's results
+are reported in the cache_stride_* comm diagnostics counters.
+
 When processing a PUT, we similarly check for the requested cache page in the
 pointer tree and use an unused page if not. We find a unused 'dirty entry' to
 track the dirty bits of the cache page if the cache entry does not already have
@@ -255,6 +263,37 @@ would be to only move tasks between threads in situations that create full
 barriers anyway; notably a full barrier occurs on task start and sync variable
 use.
 
+When comm diagnostics are on, the cache also counts how well it is working:
+read-ahead lines issued and later used, write-behind puts and bytes,
+evictions from each 2Q queue, acquire fences (split into those at the start
+of a task or 'on' body and all others), and the time spent waiting for
+pending operations to complete.
+
+== Shared per-locale mode ==
+
+With one cache per pthread, a remote page read by every worker on a node is
+fetched once per worker, and each worker's cache holds only a fraction of the
+useful working set. Setting CHPL_RT_CACHE_SHARED=true at execution time
+switches to a single cache per locale that all workers use.
+
+The shared cache is split into shards, each of which is an ordinary cache
+structure as described above protected by its own lock. The shard for a
+remote address is selected by hashing the node and the address rounded down
+to a 'shard region' (a group of consecutive cache pages). Requests that span
+region boundaries are split, and readahead is clipped to the region it starts
+in, so any given cache page only ever lives in one shard. Readahead and
+write-behind are thus shared by all workers touching the same region.
+
+Sequence numbers come from a single per-locale counter in this mode, so a
+task's last acquire fence can be compared against entries in any shard. An
+acquire fence just takes a new sequence number. Each task records which
+shards it has written to since its last release fence, and a release fence
+cleans and waits only for those shards.
+
+Because a shard can be used by any thread, nonblocking comm handles must not
+be tied to the thread that started them. Comm layers where they are define
+CHPL_COMM_NB_HANDLES_THREAD_BOUND and fall back to per-pthread caches.
+
  */
 
 // ASSUMES THAT TASKS DO NOT MIGRATE BETWEEN PTHREADS
@@ -288,6 +327,7 @@ use.
 
 #include <string.h> // memcpy, memset, etc.
 #include <assert.h>
+#include <time.h> // clock_gettime
 
 
 #ifdef HAS_CHPL_CACHE_FNS
@@ -342,6 +382,17 @@ typedef int16_t entry_id_t;
 // readahead window size for sequential access.
 #define MAX_PAGES_PER_PREFETCH 2
 
+// In shared mode, how many shards may the per-locale cache have?
+// (this is limited by the width of the per-task shards_dirtied mask)
+#define MAX_SHARED_SHARDS 64
+
+// In shared mode, how many bytes of remote address space map to the
+// same shard? Must be a multiple of CACHEPAGE_SIZE so that a page lives
+// in exactly one shard. Here we set it to 64 pages.
+#define SHARD_REGION_BITS (CACHEPAGE_BITS + 6)
+#define SHARD_REGION_SIZE (1 << SHARD_REGION_BITS)
+#define SHARD_REGION_MASK (SHARD_REGION_SIZE-1)
+
 // Should we enable sequential readahead?
 // For sequential access If we're reading
 #define ENABLE_READAHEAD 1
@@ -351,6 +402,20 @@ typedef int16_t entry_id_t;
 
 #define MAX_SEQUENTIAL_READAHEAD_BYTES (MAX_PAGES_PER_PREFETCH*CACHEPAGE_SIZE)
 
+// Should we prefetch for constant-stride access streams?
+// Strides smaller than a cache line are left to sequential readahead,
+// and accesses further apart than MAX_STRIDE_BYTES are not considered
+// part of the same stream.
+#define ENABLE_STRIDE_PREFETCH 1
+#define MIN_STRIDE_BYTES CACHELINE_SIZE
+#define MAX_STRIDE_BYTES (64*CACHEPAGE_SIZE)
+// How many times must a stride repeat before we prefetch for it?
+#define STRIDE_CONFIDENCE 2
+// Prefetch distance bounds, in strides. The distance starts at the
+// minimum and adapts to how many of the prefetches get used.
+#define MIN_STRIDE_DISTANCE 2
+#define MAX_STRIDE_DISTANCE 16
+
 // These defines can enable different kinds of debugging output.
 
 //#define TIME
@@ -567,6 +632,9 @@ struct cache_entry_s {
   unsigned char* page;
   // Which of the cache lines have we done 'get's for?
   uint64_t valid_lines[CACHE_LINES_PER_PAGE_BITMASK_WORDS];
+  // Which of the valid lines were read ahead and have not been used yet?
+  // Only maintained for the comm diagnostics.
+  uint64_t readahead_lines[CACHE_LINES_PER_PAGE_BITMASK_WORDS];
   // dirty info if this cache page is dirty, NULL otherwise.
   struct dirty_entry_s* dirty;
   // What is the minimum sequence number stored in this cache entry?
@@ -605,6 +673,32 @@ static void unset_valid_lines(uint64_t* valid, uintptr_t skip, uintptr_t len)
   uint64_t myvalid[CACHE_LINES_PER_PAGE_BITMASK_WORDS];
   unset_valids_for_skip_len(valid, myvalid, skip, len, CACHE_LINES_PER_PAGE_BITMASK_WORDS);
 }
+// Clears the lines in skip..skip+len and returns how many were set.
+// Note skip/len are in line numbers, NOT byte offsets!
+static int take_lines(uint64_t* lines, uintptr_t skip, uintptr_t len)
+{
+  uint64_t mask[CACHE_LINES_PER_PAGE_BITMASK_WORDS];
+  int count = 0;
+  int i;
+  memset(mask, 0, sizeof(mask));
+  set_valids_for_skip_len(mask, skip, len, CACHE_LINES_PER_PAGE_BITMASK_WORDS);
+  for( i = 0; i < CACHE_LINES_PER_PAGE_BITMASK_WORDS; i++ ) {
+    count += chpl_bitops_popcount_64(lines[i] & mask[i]);
+    lines[i] &= ~mask[i];
+  }
+  return count;
+}
+
+// Returns the current time in nanoseconds if comm diagnostics are
+// being collected, and 0 otherwise (so the clock is only read when needed).
+static inline
+uint64_t cache_diags_time_ns(void)
+{
+  struct timespec t;
+  if( !chpl_comm_diagnostics || !chpl_comm_diags_is_enabled() ) return 0;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (uint64_t) t.tv_sec * 1000000000 + t.tv_nsec;
+}
 
 struct rdcache_s {
   // A 2Q cache.
@@ -612,6 +706,12 @@ struct rdcache_s {
   //      Replacement Algorithm"
   //    by Theodore Johnson and Dennis Sasha, Proc 20th VLDB conference, 1994.
 
+  // Is this cache a shard of the shared per-locale cache?
+  // If so, shard_id is its index and lock must be held to use it.
+  int shared;
+  int shard_id;
+  atomic_spinlock_t lock;
+
   // The next request number -- there is currently no request or cache
   // element with this sequence number.
   cache_seqn_t next_request_number;
@@ -711,6 +811,17 @@ struct rdcache_s {
 static void validate_cache(struct rdcache_s* tree,
                            chpl_cache_taskPrvData_t* task_local);
 
+// In shared mode, all shards draw sequence numbers from this per-locale
+// counter so that they can be compared with any task's last acquire.
+static atomic_int_least64_t shared_next_request_number;
+
+static inline
+cache_seqn_t next_sequence_number(struct rdcache_s* cache) {
+  if (cache->shared)
+    return atomic_fetch_add_int_least64_t(&shared_next_request_number, 1);
+  return cache->next_request_number++;
+}
+
 static inline
 uint32_t clear_offset_stolen_bits(uint32_t offset_with_bits) {
   uint32_t no_last_bit;
@@ -861,6 +972,10 @@ struct rdcache_s* cache_create(void) {
   }
 
   // Now fill in everything else.
+  c->shared = 0;
+  c->shard_id = 0;
+  atomic_init_spinlock_t(&c->lock);
+
   c->next_request_number = 1;
   c->completed_request_number = 0;
 
@@ -952,6 +1067,7 @@ struct rdcache_s* cache_create(void) {
 
 static
 void cache_destroy(struct rdcache_s *cache) {
+  atomic_destroy_spinlock_t(&cache->lock);
   chpl_free(cache);
 }
 
@@ -1319,6 +1435,7 @@ void aout_evict(struct rdcache_s* cache)
   // Remove the tail element from Aout
   DOUBLE_REMOVE_TAIL(cache, aout);
   cache->aout_current--;
+  chpl_comm_diags_incr(cache_evict_aout);
 
   // Remove entry (which we are kicking off of Aout) from the tree
   tree_remove(cache, z);
@@ -1376,6 +1493,7 @@ void ain_evict(struct rdcache_s* cache,
 
     DOUBLE_REMOVE_TAIL(cache, ain);
     cache->ain_current--;
+    chpl_comm_diags_incr(cache_evict_ain);
 
     y->queue = QUEUE_AOUT;
 
@@ -1436,6 +1554,7 @@ void am_evict(struct rdcache_s *cache,
 
     DOUBLE_REMOVE_TAIL(cache, am_lru);
     cache->am_current--;
+    chpl_comm_diags_incr(cache_evict_am);
 
     // Remove this entry in Am from the pointer tree.
     tree_remove(cache, y);
@@ -1617,8 +1736,7 @@ cache_seqn_t pending_push(struct rdcache_s* cache, chpl_comm_nb_handle_t handle)
     wait_for(cache, wait_sn);
   }
 
-  sn = cache->next_request_number;
-  cache->next_request_number++;
+  sn = next_sequence_number(cache);
 
   fifo_circleb_push(&cache->pending_first_entry, &cache->pending_last_entry, cache->pending_len);
   index = cache->pending_last_entry;
@@ -1896,6 +2014,7 @@ void do_wait_for(struct rdcache_s* cache, cache_seqn_t sn)
   while (1) {
     int index;
     int last;
+    uint64_t wait_start;
 
     index = cache->pending_first_entry;
     if (index == -1) break;
@@ -1910,7 +2029,10 @@ void do_wait_for(struct rdcache_s* cache, cache_seqn_t sn)
 
       // Wait for some requests to complete.
       // (this could cause a different task body to run)
+      wait_start = cache_diags_time_ns();
       chpl_comm_wait_nb_some(&cache->pending[index], last - index + 1);
+      if (wait_start != 0)
+        chpl_comm_diags_add(cache_wait_ns, cache_diags_time_ns() - wait_start);
 
       if (EXTRA_YIELDS) {
         TRACE_YIELD_PRINT(("%d: task %d cache %p yielding in do_wait_for "
@@ -2068,6 +2190,9 @@ void flush_entry(struct rdcache_s* cache,
                                chpl_nodeID, (int) chpl_task_getId(), cache));
           }
 
+          chpl_comm_diags_incr(cache_write_behind_puts);
+          chpl_comm_diags_add(cache_write_behind_bytes, got_len);
+
           // Save the handle in the list of pending requests.
           entry->max_put_sequence_number = pending_push(cache, handle);
 
@@ -2109,8 +2234,10 @@ void flush_entry(struct rdcache_s* cache,
       entry->max_put_sequence_number = NO_SEQUENCE_NUMBER;
       entry->max_prefetch_sequence_number = NO_SEQUENCE_NUMBER;
       memset(entry->valid_lines, 0, CACHE_LINES_PER_PAGE_BITMASK_WORDS*sizeof(uint64_t));
+      memset(entry->readahead_lines, 0, CACHE_LINES_PER_PAGE_BITMASK_WORDS*sizeof(uint64_t));
     } else {
       unset_valid_lines(entry->valid_lines, skip_lines, num_lines);
+      unset_valid_lines(entry->readahead_lines, skip_lines, num_lines);
     }
   }
 
@@ -2204,6 +2331,7 @@ struct cache_entry_s* make_entry(struct rdcache_s* tree,
     bottom_match->page = page;
     // Clear the valid lines
     memset(&bottom_match->valid_lines, 0, sizeof(uint64_t)*CACHE_LINES_PER_PAGE_BITMASK_WORDS);
+    memset(&bottom_match->readahead_lines, 0, sizeof(uint64_t)*CACHE_LINES_PER_PAGE_BITMASK_WORDS);
     // Clear the dirty pointer and sequence numbers.
     bottom_match->dirty = NULL;
     bottom_match->min_sequence_number = NO_SEQUENCE_NUMBER;
@@ -2233,6 +2361,7 @@ struct cache_entry_s* make_entry(struct rdcache_s* tree,
     bottom_tmp->prev = NULL;
     bottom_tmp->page = page;
     memset(&bottom_tmp->valid_lines, 0, sizeof(uint64_t)*CACHE_LINES_PER_PAGE_BITMASK_WORDS);
+    memset(&bottom_tmp->readahead_lines, 0, sizeof(uint64_t)*CACHE_LINES_PER_PAGE_BITMASK_WORDS);
     bottom_tmp->dirty = NULL;
     bottom_tmp->min_sequence_number = NO_SEQUENCE_NUMBER;
     bottom_tmp->max_put_sequence_number = NO_SEQUENCE_NUMBER;
@@ -2486,8 +2615,7 @@ int cache_put_in_page(struct rdcache_s* cache,
   // Op will be started for this in flush_entry for a dirty page.
 
   // This will increment next request number so cache events are recorded.
-  sn = cache->next_request_number;
-  cache->next_request_number++;
+  sn = next_sequence_number(cache);
   // Set the minimum sequence number so an acquire fence before
   // the next read will cause this write to be disregarded.
   entry->min_sequence_number = seqn_min(entry->min_sequence_number, sn);
@@ -2677,6 +2805,14 @@ void cache_get_trigger_readahead(struct rdcache_s* cache,
       }
     }
 
+    // A shard of the shared cache only holds pages from its own region,
+    // so don't read ahead past the region containing this page.
+    if( cache->shared ) {
+      raddr_t region = round_down_to_mask(page_raddr, SHARD_REGION_MASK);
+      prefetch_start = raddr_max(prefetch_start, region);
+      prefetch_end = raddr_min(prefetch_end, region + SHARD_REGION_SIZE);
+    }
+
     //printf("C ok %i prefetch_start %p prefetch_end %p\n",
     //       ok, (void*) prefetch_start, (void*) prefetch_end);
 
@@ -2911,6 +3047,11 @@ int cache_get_in_page(struct rdcache_s* cache,
       // Copy the data out.
       chpl_memcpy(addr, entry->page + (raddr-ra_page), size);
 
+      chpl_comm_diags_add(cache_readahead_used,
+                          take_lines(entry->readahead_lines,
+                                     (ra_line - ra_page) >> CACHELINE_BITS,
+                                     (ra_line_end - ra_line) >> CACHELINE_BITS));
+
 #ifdef DUMP
       {
         // printing out gotten data for debug
@@ -3012,10 +3153,39 @@ int cache_get_in_page(struct rdcache_s* cache,
                   (ra_line - ra_page) >> CACHELINE_BITS,
                   (ra_line_end - ra_line) >> CACHELINE_BITS);
 
+  // For the comm diagnostics, note which of these lines were read ahead:
+  // all of them for a readahead, or those beyond the requested ones when
+  // a get was extended to the rest of the page.
+  if( ENABLE_READAHEAD && chpl_comm_diagnostics ) {
+    raddr_t req_line = ra_line;
+    raddr_t req_line_end = ra_line;
+    uintptr_t ra_count;
+    if( sequential_readahead_length == 0 && !isprefetch ) {
+      req_line = round_down_to_mask(raddr, CACHELINE_MASK);
+      req_line_end = round_down_to_mask(raddr+size-1, CACHELINE_MASK) +
+                     CACHELINE_SIZE;
+    }
+    if( sequential_readahead_length != 0 || !isprefetch ) {
+      take_lines(entry->readahead_lines,
+                 (ra_line - ra_page) >> CACHELINE_BITS,
+                 (ra_line_end - ra_line) >> CACHELINE_BITS);
+      ra_count = ((req_line - ra_line) + (ra_line_end - req_line_end))
+                 >> CACHELINE_BITS;
+      if( ra_count > 0 ) {
+        set_valid_lines(entry->readahead_lines,
+                        (ra_line - ra_page) >> CACHELINE_BITS,
+                        (req_line - ra_line) >> CACHELINE_BITS);
+        set_valid_lines(entry->readahead_lines,
+                        (req_line_end - ra_page) >> CACHELINE_BITS,
+                        (ra_line_end - req_line_end) >> CACHELINE_BITS);
+        chpl_comm_diags_add(cache_readahead_issued, ra_count);
+      }
+    }
+  }
+
   if (!isprefetch) {
     // This will increment next request number so cache events are recorded.
-    sn = cache->next_request_number;
-    cache->next_request_number++;
+    sn = next_sequence_number(cache);
   } else {
     // For a prefetch, store sequence number and record operation handle.
 
@@ -3383,8 +3553,7 @@ int mock_get(struct rdcache_s* cache,
 
     {
       // This will increment next request number so cache events are recorded.
-      sn = cache->next_request_number;
-      cache->next_request_number++;
+      sn = next_sequence_number(cache);
     }
 
     // Set the minimum sequence number
@@ -3565,6 +3734,13 @@ static struct rdcache_s* cache_create(void);
 CHPL_TLS_DECL(struct rdcache_s*,cache_remote_data);
 static pthread_key_t pthread_cache_info_key; // stores struct rdcache_s*
 
+// In shared mode (CHPL_RT_CACHE_SHARED), these are the shards of the
+// per-locale cache. They are created in chpl_cache_init and not
+// changed after that.
+static int cache_shared = 0;
+static int cache_num_shards = 0; // always a power of 2
+static struct rdcache_s** cache_shards = NULL;
+
 static
 struct rdcache_s* tls_cache_remote_data(void) {
   struct rdcache_s *cache = CHPL_TLS_GET(cache_remote_data);
@@ -3576,6 +3752,43 @@ struct rdcache_s* tls_cache_remote_data(void) {
   return cache;
 }
 
+static inline
+int shard_for_raddr(c_nodeid_t node, raddr_t raddr) {
+  uint64_t val = raddr >> SHARD_REGION_BITS;
+  val ^= ((uint64_t) node) * 0x9e3779b97f4a7c15ULL;
+  val ^= val >> 29;
+  return (int) (val & (cache_num_shards - 1));
+}
+
+// Returns the cache to use for node:raddr, locking it if it is a shard
+// of the shared cache. Callers must call cache_unlock when done with it.
+static inline
+struct rdcache_s* cache_lock_for(c_nodeid_t node, raddr_t raddr) {
+  struct rdcache_s* cache;
+  if( ! cache_shared ) return tls_cache_remote_data();
+
+  cache = cache_shards[shard_for_raddr(node, raddr)];
+  // This lock yields while it waits, so a task holding it can
+  // safely yield (e.g. in chpl_comm_wait_nb_some).
+  atomic_lock_spinlock_t(&cache->lock);
+  return cache;
+}
+
+static inline
+void cache_unlock(struct rdcache_s* cache) {
+  if( cache->shared ) atomic_unlock_spinlock_t(&cache->lock);
+}
+
+// How many bytes starting at raddr can be handled by a single cache?
+// In shared mode, requests have to be split at shard region boundaries.
+static inline
+size_t cache_chunk_len(raddr_t raddr, size_t size) {
+  raddr_t region_end;
+  if( ! cache_shared ) return size;
+  region_end = round_down_to_mask(raddr, SHARD_REGION_MASK) + SHARD_REGION_SIZE;
+  return raddr_min(size, region_end - raddr);
+}
+
 static
 chpl_cache_taskPrvData_t* task_private_cache_data(void)
 {
@@ -3584,6 +3797,15 @@ chpl_cache_taskPrvData_t* task_private_cache_data(void)
   return &infoRuntime->comm_data.cache_data;
 }
 
+// Record that this task has written to a shard of the shared cache,
+// so that its next release fence flushes that shard.
+static inline
+void note_shard_dirtied(chpl_cache_taskPrvData_t* task_local,
+                        struct rdcache_s* cache) {
+  if( cache->shared )
+    task_local->shards_dirtied |= ((uint64_t) 1) << cache->shard_id;
+}
+
 static
 void destroy_pthread_local_cache(void* arg)
 {
@@ -3591,6 +3813,29 @@ void destroy_pthread_local_cache(void* arg)
   cache_destroy(s);
 }
 
+static
+void shared_cache_create(void)
+{
+  int want = chpl_task_getMaxPar();
+  int i;
+
+  cache_num_shards = 1;
+  while( cache_num_shards < want && cache_num_shards < MAX_SHARED_SHARDS )
+    cache_num_shards *= 2;
+
+  atomic_init_int_least64_t(&shared_next_request_number, 1);
+
+  cache_shards = chpl_mem_allocMany(cache_num_shards,
+                                    sizeof(struct rdcache_s*),
+                                    CHPL_RT_MD_COMM_PER_LOC_INFO, 0, 0);
+  for( i = 0; i < cache_num_shards; i++ ) {
+    cache_shards[i] = cache_create();
+    cache_shards[i]->shared = 1;
+    cache_shards[i]->shard_id = i;
+  }
+  cache_shared = 1;
+}
+
 static
 void chpl_cache_do_init(void)
 {
@@ -3605,6 +3850,16 @@ void chpl_cache_do_init(void)
     // The second key we never read but create so that we
     // can free the cache when the thread exits.
     pthread_key_create(&pthread_cache_info_key, &destroy_pthread_local_cache);
+
+    if( chpl_env_rt_get_bool("CACHE_SHARED", false) ) {
+#ifdef CHPL_COMM_NB_HANDLES_THREAD_BOUND
+      if( chpl_nodeID == 0 )
+        chpl_warning("CHPL_RT_CACHE_SHARED is not supported by this comm "
+                     "layer; using a remote cache per thread", 0, 0);
+#else
+      shared_cache_create();
+#endif
+    }
     inited = 1;
   }
 }
@@ -3625,14 +3880,117 @@ void chpl_cache_init(void) {
 
 void chpl_cache_exit(void)
 {
+  int i;
+
+  if( cache_shared ) {
+    for( i = 0; i < cache_num_shards; i++ )
+      cache_destroy(cache_shards[i]);
+    chpl_mem_free(cache_shards, 0, 0);
+    cache_shards = NULL;
+    cache_shared = 0;
+  }
+
   CHPL_TLS_DELETE(cache_remote_data);
 }
 
 
-void chpl_cache_fence(int acquire, int release, int ln, int32_t fn)
+//
+// Stride prefetcher.
+//
+// Each task tracks a few access streams (see chpl_cache_stream_t). A get
+// that lands within MAX_STRIDE_BYTES of a stream's last access continues
+// that stream; once the same stride (positive or negative) has repeated
+// STRIDE_CONFIDENCE times, we prefetch 'distance' strides ahead of the
+// access. The distance grows when prefetched data is used (and faster when
+// it arrived too late to be used) and shrinks when the stride changes and
+// prefetched data is abandoned.
+//
+
+static inline
+int stream_is_ahead(chpl_cache_stream_t* s, raddr_t a, raddr_t b)
+{
+  return (s->stride > 0) ? (a > b) : (a < b);
+}
+
+// How many prefetched elements of this stream have not been used yet?
+static
+uint64_t stream_unused_prefetches(chpl_cache_stream_t* s)
+{
+  if (s->confidence < STRIDE_CONFIDENCE ||
+      !stream_is_ahead(s, s->prefetched_to, s->last_raddr))
+    return 0;
+  return ((intptr_t) (s->prefetched_to - s->last_raddr)) / s->stride;
+}
+
+// After an acquire fence, anything this task's stride prefetcher fetched
+// ahead can no longer be used, so restart each stream's prefetching from
+// its last access.
+static
+void stride_prefetch_acquire(chpl_cache_taskPrvData_t* task_local)
+{
+  int i;
+  for (i = 0; i < CHPL_CACHE_STREAMS_PER_TASK; i++) {
+    chpl_cache_stream_t* s = &task_local->streams[i];
+    if (s->last_raddr == 0) continue;
+    chpl_comm_diags_add(cache_stride_wasted, stream_unused_prefetches(s));
+    s->prefetched_to = s->last_raddr;
+  }
+}
+
+// Completes this task's pending puts in the shared cache.
+static
+void shared_cache_release(chpl_cache_taskPrvData_t* task_local)
+{
+  uint64_t shards = task_local->shards_dirtied;
+  int i;
+
+  task_local->shards_dirtied = 0;
+  for( i = 0; shards != 0; i++, shards >>= 1 ) {
+    if( shards & 1 ) {
+      struct rdcache_s* cache = cache_shards[i];
+      atomic_lock_spinlock_t(&cache->lock);
+      cache_clean_dirty(cache, task_local);
+      wait_all(cache);
+      atomic_unlock_spinlock_t(&cache->lock);
+    }
+  }
+}
+
+// Counts an acquire fence in the comm diagnostics. Each acquire
+// invalidates everything this task has cached, so these counts say
+// how often a task has to start over with a cold cache.
+static inline
+void count_acquire(int task_start)
+{
+  if( task_start ) chpl_comm_diags_incr(cache_start_invalidations);
+  else chpl_comm_diags_incr(cache_acquire_invalidations);
+}
+
+// task_start is set for the acquire at the start of a task or 'on'
+// statement body; it only affects which diagnostic counter is updated.
+static
+void cache_fence(int acquire, int release, int task_start, int ln, int32_t fn)
 {
   if( acquire == 0 && release == 0 ) return;
-  if( chpl_cache_enabled() ) {
+  if( chpl_cache_enabled() && cache_shared ) {
+    chpl_cache_taskPrvData_t* task_local = task_private_cache_data();
+
+    TRACE_FENCE_PRINT(("%d: task %d in chpl_cache_fence(acquire=%i,release=%i)"
+                       " on shared cache from %s:%d\n",
+                       chpl_nodeID, (int) chpl_task_getId(), acquire, release,
+                       chpl_lookupFilename(fn), ln));
+
+    if( acquire ) {
+      count_acquire(task_start);
+      task_local->last_acquire =
+        atomic_fetch_add_int_least64_t(&shared_next_request_number, 1);
+      if( ENABLE_STRIDE_PREFETCH ) stride_prefetch_acquire(task_local);
+    }
+
+    if( release ) {
+      shared_cache_release(task_local);
+    }
+  } else if( chpl_cache_enabled() ) {
     struct rdcache_s* cache = tls_cache_remote_data();
     chpl_cache_taskPrvData_t* task_local = task_private_cache_data();
 
@@ -3649,8 +4007,10 @@ void chpl_cache_fence(int acquire, int release, int ln, int32_t fn)
 #endif
 
     if( acquire ) {
+      count_acquire(task_start);
       task_local->last_acquire = cache->next_request_number;
       cache->next_request_number++;
+      if( ENABLE_STRIDE_PREFETCH ) stride_prefetch_acquire(task_local);
     }
 
     if( release ) {
@@ -3665,10 +4025,34 @@ void chpl_cache_fence(int acquire, int release, int ln, int32_t fn)
   // Do nothing if cache is not enabled.
 }
 
+void chpl_cache_fence(int acquire, int release, int ln, int32_t fn)
+{
+  cache_fence(acquire, release, 0, ln, fn);
+}
+
+void chpl_cache_start_fence(int ln, int32_t fn)
+{
+  cache_fence(1, 0, 1, ln, fn);
+}
+
+// Invalidates node:raddr..raddr+size in whichever cache(s) hold it.
+static
+void cache_invalidate_any(chpl_cache_taskPrvData_t* task_local,
+                          c_nodeid_t node, raddr_t raddr, size_t size)
+{
+  while( size > 0 ) {
+    size_t len = cache_chunk_len(raddr, size);
+    struct rdcache_s* cache = cache_lock_for(node, raddr);
+    cache_invalidate(cache, task_local, node, raddr, len);
+    cache_unlock(cache);
+    raddr += len;
+    size -= len;
+  }
+}
+
 void chpl_cache_invalidate(c_nodeid_t node, void* raddr, size_t size,
                            int ln, int32_t fn)
 {
-  struct rdcache_s* cache = tls_cache_remote_data();
   chpl_cache_taskPrvData_t* task_local = task_private_cache_data();
 
 
@@ -3677,7 +4061,7 @@ void chpl_cache_invalidate(c_nodeid_t node, void* raddr, size_t size,
                chpl_lookupFilename(fn), ln,
                (int)size, node, raddr, addr));
 
-  cache_invalidate(cache, task_local, node, (raddr_t)raddr, size);
+  cache_invalidate_any(task_local, node, (raddr_t)raddr, size);
 }
 
 // If a transfer is large enough we should directly initiate it to avoid
@@ -3685,29 +4069,163 @@ void chpl_cache_invalidate(c_nodeid_t node, void* raddr, size_t size,
 //
 // This is not allowed to modify the cache
 static inline
-int size_merits_direct_comm(const struct rdcache_s* cache, size_t size)
+int size_merits_direct_comm(size_t size)
 {
   return size >= CACHEPAGE_SIZE;
 }
 
+// Moves streams[i] to the front of the (most recently used first) list.
+static
+chpl_cache_stream_t* stream_use(chpl_cache_taskPrvData_t* task_local, int i)
+{
+  chpl_cache_stream_t tmp = task_local->streams[i];
+  memmove(&task_local->streams[1], &task_local->streams[0],
+          i * sizeof(chpl_cache_stream_t));
+  task_local->streams[0] = tmp;
+  return &task_local->streams[0];
+}
+
+static
+void stride_prefetch_issue(chpl_cache_taskPrvData_t* task_local,
+                           chpl_cache_stream_t* s,
+                           size_t size,
+                           int32_t commID, int ln, int32_t fn)
+{
+  raddr_t target = s->last_raddr + s->stride * s->distance;
+  raddr_t ra;
+
+  if (stream_is_ahead(s, s->prefetched_to, s->last_raddr))
+    ra = s->prefetched_to + s->stride;
+  else
+    ra = s->last_raddr + s->stride;
+
+  for ( ; !stream_is_ahead(s, ra, target); ra += s->stride) {
+    struct rdcache_s* cache;
+
+    // Don't prefetch memory we can't be sure is there.
+    if (chpl_task_guardPagesInUse() ||
+        !chpl_comm_addr_gettable(s->node, (void*) ra, size))
+      break;
+
+    cache = cache_lock_for(s->node, ra);
+    if (is_congested(cache)) {
+      cache_unlock(cache);
+      break;
+    }
+    TRACE_READAHEAD_PRINT(("%d: task %d stride prefetch %d:%p stride %ld\n",
+                           chpl_nodeID, (int)chpl_task_getId(),
+                           (int) s->node, (void*) ra, (long) s->stride));
+    cache_get(cache, task_local,
+              /* addr */ NULL, s->node, ra,
+              cache_chunk_len(ra, size),
+              /* sequential_readahead_length */ 0,
+              commID, ln, fn);
+    cache_unlock(cache);
+
+    s->prefetched_to = ra;
+    chpl_comm_diags_incr(cache_stride_prefetches);
+  }
+}
+
+// Called after each cached get with whether or not it was all hits.
+static
+void stride_prefetch_observe(chpl_cache_taskPrvData_t* task_local,
+                             c_nodeid_t node, raddr_t raddr, size_t size,
+                             int hit,
+                             int32_t commID, int ln, int32_t fn)
+{
+  chpl_cache_stream_t* s;
+  int found = -1;
+  int i;
+
+  // Find the stream this access continues, preferring one whose stride
+  // predicted it exactly over one that is merely nearby.
+  for (i = 0; i < CHPL_CACHE_STREAMS_PER_TASK; i++) {
+    chpl_cache_stream_t* cur = &task_local->streams[i];
+    intptr_t delta = (intptr_t) (raddr - cur->last_raddr);
+    if (cur->last_raddr == 0 || cur->node != node)
+      continue;
+    if (delta == cur->stride) {
+      found = i;
+      break;
+    }
+    if (found < 0 && delta != 0 &&
+        delta <= MAX_STRIDE_BYTES && delta >= -MAX_STRIDE_BYTES)
+      found = i;
+  }
+
+  if (found < 0) {
+    // Start a new stream, replacing the least recently used one.
+    s = stream_use(task_local, CHPL_CACHE_STREAMS_PER_TASK - 1);
+    if (s->last_raddr != 0)
+      chpl_comm_diags_add(cache_stride_wasted, stream_unused_prefetches(s));
+    s->last_raddr = raddr;
+    s->stride = 0;
+    s->prefetched_to = raddr;
+    s->node = node;
+    s->confidence = 0;
+    s->distance = MIN_STRIDE_DISTANCE;
+    return;
+  }
+
+  s = stream_use(task_local, found);
+
+  if ((intptr_t) (raddr - s->last_raddr) == s->stride) {
+    if (s->confidence >= STRIDE_CONFIDENCE &&
+        !stream_is_ahead(s, raddr, s->prefetched_to)) {
+      // We prefetched this access.
+      if (hit) {
+        chpl_comm_diags_incr(cache_stride_hits);
+        if (s->distance < MAX_STRIDE_DISTANCE) s->distance++;
+      } else {
+        // The prefetch was too late (or was invalidated); look further ahead.
+        chpl_comm_diags_incr(cache_stride_misses);
+        s->distance = 2 * s->distance;
+        if (s->distance > MAX_STRIDE_DISTANCE)
+          s->distance = MAX_STRIDE_DISTANCE;
+      }
+    }
+    if (s->confidence < STRIDE_CONFIDENCE) s->confidence++;
+  } else {
+    // The stride changed, so whatever we prefetched ahead is wasted.
+    uint64_t unused = stream_unused_prefetches(s);
+    if (unused > 0) {
+      chpl_comm_diags_add(cache_stride_wasted, unused);
+      s->distance = s->distance / 2;
+      if (s->distance < MIN_STRIDE_DISTANCE)
+        s->distance = MIN_STRIDE_DISTANCE;
+    }
+    s->stride = (intptr_t) (raddr - s->last_raddr);
+    s->prefetched_to = raddr;
+    s->confidence = 0;
+  }
+  s->last_raddr = raddr;
+
+  if (s->confidence >= STRIDE_CONFIDENCE &&
+      (s->stride >= MIN_STRIDE_BYTES || s->stride <= -MIN_STRIDE_BYTES))
+    stride_prefetch_issue(task_local, s, size, commID, ln, fn);
+}
+
 void chpl_cache_comm_put(void* addr, c_nodeid_t node, void* raddr,
                          size_t size, int32_t commID, int ln, int32_t fn)
 {
-  struct rdcache_s* cache = tls_cache_remote_data();
   chpl_cache_taskPrvData_t* task_local = task_private_cache_data();
-  int all_hits;
+  int all_hits = 1;
+  raddr_t ra = (raddr_t)raddr;
+  unsigned char* a = (unsigned char*)addr;
+  size_t remaining = size;
 
-  if (size_merits_direct_comm(cache, size)) {
-    cache_invalidate(cache, task_local, node, (raddr_t)raddr, size);
+  if (size_merits_direct_comm(size)) {
+    cache_invalidate_any(task_local, node, (raddr_t)raddr, size);
     chpl_comm_put(addr, node, raddr, size, commID, ln, fn);
     if (EXTRA_YIELDS) {
-      TRACE_YIELD_PRINT(("%d: task %d cache %p yielding for chpl_comm_put\n",
-                         chpl_nodeID, (int) chpl_task_getId(), cache));
+      TRACE_YIELD_PRINT(("%d: task %d yielding for chpl_comm_put\n",
+                         chpl_nodeID, (int) chpl_task_getId()));
 
       chpl_task_yield();
 
-      TRACE_YIELD_PRINT(("%d: task %d cache %p back from chpl_comm_put\n",
-                         chpl_nodeID, (int) chpl_task_getId(), cache));
+      TRACE_YIELD_PRINT(("%d: task %d back from chpl_comm_put\n",
+                         chpl_nodeID, (int) chpl_task_getId()));
     }
     return;
   }
@@ -3721,9 +4239,19 @@ void chpl_cache_comm_put(void* addr, c_nodeid_t node, void* raddr,
   chpl_cache_print();
 #endif
 
-  all_hits = cache_put(cache, task_local,
-                       addr, node, (raddr_t)raddr, size,
-                       commID, ln, fn);
+  while (remaining > 0) {
+    size_t len = cache_chunk_len(ra, remaining);
+    struct rdcache_s* cache = cache_lock_for(node, ra);
+    int hit = cache_put(cache, task_local,
+                        a, node, ra, len,
+                        commID, ln, fn);
+    note_shard_dirtied(task_local, cache);
+    cache_unlock(cache);
+    all_hits = all_hits && hit;
+    ra += len;
+    a += len;
+    remaining -= len;
+  }
 
   if (size != 0) {
     if (all_hits)
@@ -3739,21 +4267,23 @@ void chpl_cache_comm_get(void *addr, c_nodeid_t node, void* raddr,
                          size_t size, int32_t commID, int ln, int32_t fn)
 {
   //printf("get len %d node %d raddr %p\n", (int) len * elemSize, node, raddr);
-  struct rdcache_s* cache = tls_cache_remote_data();
   chpl_cache_taskPrvData_t* task_local = task_private_cache_data();
-  int all_hits;
+  int all_hits = 1;
+  raddr_t ra = (raddr_t)raddr;
+  unsigned char* a = (unsigned char*)addr;
+  size_t remaining = size;
 
-  if (size_merits_direct_comm(cache, size)) {
-    cache_invalidate(cache, task_local, node, (raddr_t)raddr, size);
+  if (size_merits_direct_comm(size)) {
+    cache_invalidate_any(task_local, node, (raddr_t)raddr, size);
     chpl_comm_get(addr, node, raddr, size, commID, ln, fn);
     if (EXTRA_YIELDS) {
-      TRACE_YIELD_PRINT(("%d: task %d cache %p yielding for chpl_comm_get\n",
-                         chpl_nodeID, (int) chpl_task_getId(), cache));
+      TRACE_YIELD_PRINT(("%d: task %d yielding for chpl_comm_get\n",
+                         chpl_nodeID, (int) chpl_task_getId()));
 
       chpl_task_yield();
 
-      TRACE_YIELD_PRINT(("%d: task %d cache %p back from chpl_comm_get\n",
-                         chpl_nodeID, (int) chpl_task_getId(), cache));
+      TRACE_YIELD_PRINT(("%d: task %d back from chpl_comm_get\n",
+                         chpl_nodeID, (int) chpl_task_getId()));
     }
     return;
   }
@@ -3767,15 +4297,28 @@ void chpl_cache_comm_get(void *addr, c_nodeid_t node, void* raddr,
   chpl_cache_print();
 #endif
 
-  all_hits = cache_get(cache, task_local,
-                       addr, node, (raddr_t)raddr, size,
-                       0, commID, ln, fn);
+  while (remaining > 0) {
+    size_t len = cache_chunk_len(ra, remaining);
+    struct rdcache_s* cache = cache_lock_for(node, ra);
+    int hit = cache_get(cache, task_local,
+                        a, node, ra, len,
+                        0, commID, ln, fn);
+    cache_unlock(cache);
+    all_hits = all_hits && hit;
+    ra += len;
+    a += len;
+    remaining -= len;
+  }
 
   if (size != 0) {
     if (all_hits)
       chpl_comm_diags_incr(cache_get_hits);
     else
       chpl_comm_diags_incr(cache_get_misses);
+
+    if (ENABLE_STRIDE_PREFETCH)
+      stride_prefetch_observe(task_local, node, (raddr_t)raddr, size,
+                              all_hits, commID, ln, fn);
   }
 
   return;
@@ -3784,24 +4327,30 @@ void chpl_cache_comm_get(void *addr, c_nodeid_t node, void* raddr,
 void chpl_cache_comm_prefetch(c_nodeid_t node, void* raddr,
                               size_t size, int32_t commID, int ln, int32_t fn)
 {
-  struct rdcache_s* cache = tls_cache_remote_data();
   chpl_cache_taskPrvData_t* task_local = task_private_cache_data();
+  raddr_t ra = (raddr_t)raddr;
 
   TRACE_PRINT(("%d: in chpl_cache_comm_prefetch\n", chpl_nodeID));
 
   chpl_comm_diags_verbose_rdma("prefetch", node, size, ln, fn, commID);
 
   // Always use the cache for prefetches.
-  cache_get(cache, task_local,
-            /* addr */ NULL, node, (raddr_t)raddr, size,
-            /* sequential_readahead_length */ 0,
-            CHPL_COMM_UNKNOWN_ID, ln, fn);
+  while (size > 0) {
+    size_t len = cache_chunk_len(ra, size);
+    struct rdcache_s* cache = cache_lock_for(node, ra);
+    cache_get(cache, task_local,
+              /* addr */ NULL, node, ra, len,
+              /* sequential_readahead_length */ 0,
+              CHPL_COMM_UNKNOWN_ID, ln, fn);
+    cache_unlock(cache);
+    ra += len;
+    size -= len;
+  }
 
   // TODO: record prefetches somewhere in diagnostic counters
 }
 
 struct cache_strd_callback_ctx {
-  struct rdcache_s* cache;
   chpl_cache_taskPrvData_t* task_local;
 };
 
@@ -3818,10 +4367,9 @@ void strd_invalidate_fn(void* addr,
 
   struct cache_strd_callback_ctx* ctx = (struct cache_strd_callback_ctx*) ctxv;
 
-  struct rdcache_s* cache = ctx->cache;
   chpl_cache_taskPrvData_t* task_local = ctx->task_local;
 
-  cache_invalidate(cache, task_local, node, (raddr_t)raddr, size);
+  cache_invalidate_any(task_local, node, (raddr_t)raddr, size);
 }
 
 static
@@ -3830,11 +4378,9 @@ void strd_invalidate(void *addr, void *dststr, c_nodeid_t node,
                      int32_t strlevels, size_t elemSize,
                      int32_t commID, int ln, int32_t fn) {
 
-  struct rdcache_s* cache = tls_cache_remote_data();
   chpl_cache_taskPrvData_t* task_local = task_private_cache_data();
 
   struct cache_strd_callback_ctx ctx;
-  ctx.cache = cache;
   ctx.task_local = task_local;
   strd_common_call(addr, dststr, node,
                    raddr, srcstr, count, strlevels, elemSize,
@@ -3868,16 +4414,13 @@ void chpl_cache_comm_get_strd(void *addr, void *dststr, c_nodeid_t node,
   chpl_comm_get_strd(addr, dststr, node, raddr, srcstr, count, strlevels,
                      elemSize, commID, ln, fn);
   if (EXTRA_YIELDS) {
-#ifdef TRACE_YIELDS
-    struct rdcache_s* cache = tls_cache_remote_data();
-#endif
-    TRACE_YIELD_PRINT(("%d: task %d cache %p yielding for chpl_comm_get_strd\n",
-                      chpl_nodeID, (int) chpl_task_getId(), cache));
+    TRACE_YIELD_PRINT(("%d: task %d yielding for chpl_comm_get_strd\n",
+                      chpl_nodeID, (int) chpl_task_getId()));
 
     chpl_task_yield();
 
-    TRACE_YIELD_PRINT(("%d: task %d cache %p back from chpl_comm_get_strd\n",
-                       chpl_nodeID, (int) chpl_task_getId(), cache));
+    TRACE_YIELD_PRINT(("%d: task %d back from chpl_comm_get_strd\n",
+                       chpl_nodeID, (int) chpl_task_getId()));
   }
 }
 void chpl_cache_comm_put_strd(void *addr, void *dststr, c_nodeid_t node,
@@ -3905,16 +4448,13 @@ void chpl_cache_comm_put_strd(void *addr, void *dststr, c_nodeid_t node,
   chpl_comm_put_strd(addr, dststr, node, raddr, srcstr, count, strlevels,
                      elemSize, commID, ln, fn);
   if (EXTRA_YIELDS) {
-#ifdef TRACE_YIELDS
-    struct rdcache_s* cache = tls_cache_remote_data();
-#endif
-    TRACE_YIELD_PRINT(("%d: task %d cache %p yielding for chpl_comm_put_strd\n",
-                       chpl_nodeID, (int) chpl_task_getId(), cache));
+    TRACE_YIELD_PRINT(("%d: task %d yielding for chpl_comm_put_strd\n",
+                       chpl_nodeID, (int) chpl_task_getId()));
 
     chpl_task_yield();
 
-    TRACE_YIELD_PRINT(("%d: task %d cache %p back from chpl_comm_put_strd\n",
-                       chpl_nodeID, (int) chpl_task_getId(), cache));
+    TRACE_YIELD_PRINT(("%d: task %d back from chpl_comm_put_strd\n",
+                       chpl_nodeID, (int) chpl_task_getId()));
   }
 }
 
@@ -3925,36 +4465,34 @@ void chpl_cache_comm_put_strd(void *addr, void *dststr, c_nodeid_t node,
 void chpl_cache_comm_put_unordered(void* addr, c_nodeid_t node, void* raddr,
                                    size_t size, int32_t commID, int ln, int32_t fn)
 {
-  struct rdcache_s* cache = tls_cache_remote_data();
   chpl_cache_taskPrvData_t* task_local = task_private_cache_data();
-  cache_invalidate(cache, task_local, node, (raddr_t)raddr, size);
+  cache_invalidate_any(task_local, node, (raddr_t)raddr, size);
   chpl_comm_put_unordered(addr, node, raddr, size, commID, ln, fn);
   if (EXTRA_YIELDS) {
-    TRACE_YIELD_PRINT(("%d: task %d cache %p yielding for put_unordered\n",
-                      chpl_nodeID, (int) chpl_task_getId(), cache));
+    TRACE_YIELD_PRINT(("%d: task %d yielding for put_unordered\n",
+                      chpl_nodeID, (int) chpl_task_getId()));
 
     chpl_task_yield();
 
-    TRACE_YIELD_PRINT(("%d: task %d cache %p back from put_unordered\n",
-                      chpl_nodeID, (int) chpl_task_getId(), cache));
+    TRACE_YIELD_PRINT(("%d: task %d back from put_unordered\n",
+                      chpl_nodeID, (int) chpl_task_getId()));
   }
 }
 
 void chpl_cache_comm_get_unordered(void *addr, c_nodeid_t node, void* raddr,
                                    size_t size, int32_t commID, int ln, int32_t fn)
 {
-  struct rdcache_s* cache = tls_cache_remote_data();
   chpl_cache_taskPrvData_t* task_local = task_private_cache_data();
-  cache_invalidate(cache, task_local, node, (raddr_t)raddr, size);
+  cache_invalidate_any(task_local, node, (raddr_t)raddr, size);
   chpl_comm_get_unordered(addr, node, raddr, size, commID, ln, fn);
   if (EXTRA_YIELDS) {
-    TRACE_YIELD_PRINT(("%d: task %d cache %p yielding for get_unordered\n",
-                       chpl_nodeID, (int) chpl_task_getId(), cache));
+    TRACE_YIELD_PRINT(("%d: task %d yielding for get_unordered\n",
+                       chpl_nodeID, (int) chpl_task_getId()));
 
     chpl_task_yield();
 
-    TRACE_YIELD_PRINT(("%d: task %d cache %p back from put_unordered\n",
-                      chpl_nodeID, (int) chpl_task_getId(), cache));
+    TRACE_YIELD_PRINT(("%d: task %d back from put_unordered\n",
+                      chpl_nodeID, (int) chpl_task_getId()));
   }
 }
 
@@ -3964,19 +4502,18 @@ void chpl_cache_comm_getput_unordered(c_nodeid_t dstnode, void* dstaddr,
                                       size_t size, int32_t commID,
                                       int ln, int32_t fn)
 {
-  struct rdcache_s* cache = tls_cache_remote_data();
   chpl_cache_taskPrvData_t* task_local = task_private_cache_data();
-  cache_invalidate(cache, task_local, srcnode, (raddr_t)srcaddr, size);
-  cache_invalidate(cache, task_local, dstnode, (raddr_t)dstaddr, size);
+  cache_invalidate_any(task_local, srcnode, (raddr_t)srcaddr, size);
+  cache_invalidate_any(task_local, dstnode, (raddr_t)dstaddr, size);
   chpl_comm_getput_unordered(dstnode, dstaddr, srcnode, srcaddr, size, commID, ln, fn);
   if (EXTRA_YIELDS) {
-    TRACE_YIELD_PRINT(("%d: task %d cache %p yielding for getput_unordered\n",
-                       chpl_nodeID, (int) chpl_task_getId(), cache));
+    TRACE_YIELD_PRINT(("%d: task %d yielding for getput_unordered\n",
+                       chpl_nodeID, (int) chpl_task_getId()));
 
     chpl_task_yield();
 
-    TRACE_YIELD_PRINT(("%d: task %d cache %p back from put_unordered\n",
-                      chpl_nodeID, (int) chpl_task_getId(), cache));
+    TRACE_YIELD_PRINT(("%d: task %d back from put_unordered\n",
+                      chpl_nodeID, (int) chpl_task_getId()));
   }
 }
 
@@ -3988,16 +4525,22 @@ void chpl_cache_comm_getput_unordered_task_fence(void)
 // This is for debugging.
 void chpl_cache_print(void)
 {
-  struct rdcache_s* cache = tls_cache_remote_data();
   chpl_cache_taskPrvData_t* task_local = task_private_cache_data();
   printf("%d: cache dump last acquire %i\n", chpl_nodeID, (int) task_local->last_acquire);
-  rdcache_print(cache);
+  if( cache_shared ) {
+    int i;
+    for( i = 0; i < cache_num_shards; i++ ) {
+      printf("%d: shard %i\n", chpl_nodeID, i);
+      rdcache_print(cache_shards[i]);
+    }
+  } else {
+    rdcache_print(tls_cache_remote_data());
+  }
 }
 
-// This is for debugging.
-void chpl_cache_assert_released(void)
+static
+void cache_assert_released(struct rdcache_s* cache)
 {
-  struct rdcache_s* cache = tls_cache_remote_data();
   struct dirty_entry_s* cur;
   cache_seqn_t sn;
   int index;
@@ -4015,9 +4558,20 @@ void chpl_cache_assert_released(void)
   }
 }
 
-// This is for debugging
-void chpl_cache_print_stats(void) {
-  struct rdcache_s* cache = tls_cache_remote_data();
+// This is for debugging.
+void chpl_cache_assert_released(void)
+{
+  if( cache_shared ) {
+    int i;
+    for( i = 0; i < cache_num_shards; i++ )
+      cache_assert_released(cache_shards[i]);
+  } else {
+    cache_assert_released(tls_cache_remote_data());
+  }
+}
+
+static
+void cache_print_stats(struct rdcache_s* cache) {
   int n_used_slots = 0;
   int n_full_slots = 0;
   int n_bottom_entries = 0;
@@ -4055,12 +4609,13 @@ void chpl_cache_print_stats(void) {
     n_full_subslots += full_entries_this_slot;
   }
 
-  printf("%d: task %d cache statistics "
+  printf("%d: task %d cache%s %i statistics "
          "ain=%i/%i "
          "aout=%i/%i am=%i "
          "table=(%i lists/%i full/%i used/%i slots and %i/%i sub-slots) "
          "entries=%i/%i\n",
          chpl_nodeID, (int) chpl_task_getId(),
+         cache->shared ? " shard" : "", cache->shard_id,
          cache->ain_current, cache->ain_max,
          cache->aout_current, cache->aout_max,
          cache->am_current,
@@ -4069,10 +4624,24 @@ void chpl_cache_print_stats(void) {
          n_bottom_entries, cache->max_entries);
 }
 
+// This is for debugging
+void chpl_cache_print_stats(void) {
+  if( cache_shared ) {
+    int i;
+    for( i = 0; i < cache_num_shards; i++ ) {
+      atomic_lock_spinlock_t(&cache_shards[i]->lock);
+      cache_print_stats(cache_shards[i]);
+      atomic_unlock_spinlock_t(&cache_shards[i]->lock);
+    }
+  } else {
+    cache_print_stats(tls_cache_remote_data());
+  }
+}
+
 // Returns 1 if the data was already cached
 int chpl_cache_mock_get(c_nodeid_t node, uint64_t raddr, size_t size)
 {
-  struct rdcache_s* cache = tls_cache_remote_data();
+  struct rdcache_s* cache;
   int ret;
 
   if (!chpl_cache_enabled())
@@ -4086,9 +4655,15 @@ int chpl_cache_mock_get(c_nodeid_t node, uint64_t raddr, size_t size)
   chpl_cache_print();
 #endif
 
+  // mock_get does not split requests, so in shared mode
+  // it can only be used within a single shard region.
+  assert(cache_chunk_len((raddr_t)raddr, size) == size);
+
+  cache = cache_lock_for(node, (raddr_t)raddr);
   ret = mock_get(cache, task_local, node, (raddr_t)raddr, size,
                  task_local->last_acquire,
                  0, 0, 0, 0);
+  cache_unlock(cache);
 
   return ret;
 }
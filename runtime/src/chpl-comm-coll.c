@@ -0,0 +1,446 @@
+/*
+ * Copyright 2020-2021 Hewlett Packard Enterprise Development LP
+ * Copyright 2004-2019 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ * 
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * 
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//
+// Default implementations of the collective operations, for comm layers
+// that don't supply native ones.  See chpl-comm.h for the interface.
+//
+// Each node has a scratch area in communicable memory, made up of slots
+// that other nodes PUT data into, followed by a flag saying which
+// collective the data belongs to.  Most of the collectives are built on
+// a recursive doubling exchange between the nodes in the largest power
+// of 2 that fits, with each of the remaining nodes first folding its
+// data into a partner in that set and then getting the result back.
+// Each exchange is one "epoch", and uses the slots for the parity of its
+// epoch.  An exchange can't finish anywhere until every node has entered
+// it, so no node can get two epochs ahead of another and reuse a slot
+// that hasn't been read yet.
+//
+// The receiver knows the data in a slot is complete once the flag
+// arrives, because chpl_comm_put() doesn't return until its data is
+// visible at the target, and the flag is PUT after the data.
+//
+
+#include "chplrt.h"
+#include "chpl-atomics.h"
+#include "chpl-comm.h"
+#include "chpl-comm-compiler-macros.h"
+#include "chpl-comm-internal.h"
+#include "chpl-mem.h"
+#include "chpl-tasks.h"
+#include "error.h"
+
+// Don't get warning macros for chpl_comm_get etc.
+#include "chpl-comm-no-warning-macros.h"
+
+#include <stdint.h>
+#include <string.h>
+
+
+// bytes in front of the data in each slot, holding the epoch flag
+#define SLOT_HDR_SIZE 64
+
+// minimum data bytes in each slot
+#define SLOT_MIN_DATA_SIZE ((size_t) 16 * 1024)
+
+static c_nodeid_t p2Nodes;        // largest power of 2 <= chpl_numNodes
+static int numRounds;             // slots per epoch parity
+static size_t slotDataSize;
+static size_t slotSize;
+static size_t bitmapSize;         // bytes for a bit per node, in words
+
+static char* scratch;             // my scratch area
+static void** scratchAddrs;       // every node's scratch area
+static char* stateBuf;            // staging space, slotDataSize bytes
+
+// Only one task per node runs a collective at a time, so this needs no
+// synchronization.
+static uint64_t collEpoch;
+
+
+void chpl_comm_coll_init(void) {
+  c_nodeid_t n;
+  int lgP2;
+
+  if (chpl_numNodes == 1) {
+    return;
+  }
+
+  for (n = 1, lgP2 = 0; 2 * n <= chpl_numNodes; n *= 2, lgP2++)
+    ;
+  p2Nodes = n;
+
+  // a fold-in round, the recursive doubling rounds, and a fold-out round
+  numRounds = lgP2 + 2;
+
+  // leave room for at least 64 bytes per node in an allgather
+  bitmapSize = ((chpl_numNodes + 63) / 64) * sizeof(uint64_t);
+  slotDataSize = bitmapSize + (size_t) chpl_numNodes * 64;
+  if (slotDataSize < SLOT_MIN_DATA_SIZE) {
+    slotDataSize = SLOT_MIN_DATA_SIZE;
+  }
+  slotSize = SLOT_HDR_SIZE + slotDataSize;
+
+  scratch = chpl_mem_allocManyZero(2 * numRounds, slotSize,
+                                   CHPL_RT_MD_COMM_UTIL, 0, 0);
+  stateBuf = chpl_mem_alloc(slotDataSize, CHPL_RT_MD_COMM_UTIL, 0, 0);
+  scratchAddrs = chpl_mem_allocMany(chpl_numNodes, sizeof(scratchAddrs[0]),
+                                    CHPL_RT_MD_COMM_PER_LOC_INFO, 0, 0);
+  chpl_comm_coll_allgather_addrs_helper(scratch, scratchAddrs);
+}
+
+
+static inline
+size_t slotOffset(uint64_t epoch, int round) {
+  return ((epoch & 1) * numRounds + round) * slotSize;
+}
+
+
+static
+void putSlot(c_nodeid_t node, uint64_t epoch, int round,
+             const void* data, size_t nbytes) {
+  char* rslot = (char*) scratchAddrs[node] + slotOffset(epoch, round);
+  uint64_t flag = epoch;
+
+  if (nbytes > 0) {
+    chpl_comm_put((void*) data, node, rslot + SLOT_HDR_SIZE, nbytes,
+                  CHPL_COMM_UNKNOWN_ID, 0, -1);
+  }
+  chpl_comm_put(&flag, node, rslot, sizeof(flag),
+                CHPL_COMM_UNKNOWN_ID, 0, -1);
+}
+
+
+static
+const void* waitSlot(uint64_t epoch, int round) {
+  char* slot = scratch + slotOffset(epoch, round);
+  volatile uint64_t* flag = (volatile uint64_t*) slot;
+
+  while (*flag != epoch) {
+    chpl_task_yield();
+  }
+  chpl_atomic_thread_fence(memory_order_acquire);
+  return slot + SLOT_HDR_SIZE;
+}
+
+
+//
+// Combine the 'nbytes' of state at 'state' across all the nodes.  The
+// merge function must be commutative, so that both partners in each
+// round get the same result.
+//
+typedef void (*mergeFn_t)(void* state, const void* in, void* arg);
+
+static
+void rdExchange(void* state, size_t nbytes, mergeFn_t merge, void* arg) {
+  const c_nodeid_t me = chpl_nodeID;
+  const c_nodeid_t numExtra = chpl_numNodes - p2Nodes;
+  const uint64_t epoch = ++collEpoch;
+  c_nodeid_t mask;
+  int round;
+
+  if (me >= p2Nodes) {
+    putSlot(me - p2Nodes, epoch, 0, state, nbytes);
+    memcpy(state, waitSlot(epoch, numRounds - 1), nbytes);
+    return;
+  }
+
+  if (me < numExtra) {
+    merge(state, waitSlot(epoch, 0), arg);
+  }
+
+  for (mask = 1, round = 1; mask < p2Nodes; mask <<= 1, round++) {
+    putSlot(me ^ mask, epoch, round, state, nbytes);
+    merge(state, waitSlot(epoch, round), arg);
+  }
+
+  if (me < numExtra) {
+    putSlot(me + p2Nodes, epoch, numRounds - 1, state, nbytes);
+  }
+}
+
+
+//
+// Broadcast
+//
+// The state is a word saying whether the node has the data yet,
+// followed by the data.
+//
+typedef struct {
+  size_t size;
+} bcastArg_t;
+
+static
+void bcastMerge(void* state, const void* in, void* arg) {
+  size_t size = ((bcastArg_t*) arg)->size;
+
+  if (*(uint64_t*) state == 0 && *(const uint64_t*) in != 0) {
+    memcpy(state, in, sizeof(uint64_t) + size);
+  }
+}
+
+void chpl_comm_coll_dflt_broadcast(c_nodeid_t root, void* buf, size_t size) {
+  const size_t chunkSize = slotDataSize - sizeof(uint64_t);
+  size_t off;
+
+  if (chpl_numNodes == 1) {
+    return;
+  }
+
+  for (off = 0; off < size; off += chunkSize) {
+    bcastArg_t arg = { size - off < chunkSize ? size - off : chunkSize };
+    uint64_t* have = (uint64_t*) stateBuf;
+    char* data = stateBuf + sizeof(uint64_t);
+
+    *have = (chpl_nodeID == root);
+    if (*have) {
+      memcpy(data, (char*) buf + off, arg.size);
+    }
+    rdExchange(stateBuf, sizeof(uint64_t) + arg.size, bcastMerge, &arg);
+    if (chpl_nodeID != root) {
+      memcpy((char*) buf + off, data, arg.size);
+    }
+  }
+}
+
+
+//
+// Allreduce
+//
+typedef struct {
+  size_t count;
+  chpl_comm_coll_type_t type;
+  chpl_comm_coll_op_t op;
+} reduceArg_t;
+
+static
+size_t collTypeSize(chpl_comm_coll_type_t type) {
+  switch (type) {
+  case CHPL_COMM_COLL_INT32:  return sizeof(int32_t);
+  case CHPL_COMM_COLL_INT64:  return sizeof(int64_t);
+  case CHPL_COMM_COLL_UINT32: return sizeof(uint32_t);
+  case CHPL_COMM_COLL_UINT64: return sizeof(uint64_t);
+  case CHPL_COMM_COLL_REAL32: return sizeof(float);
+  case CHPL_COMM_COLL_REAL64: return sizeof(double);
+  }
+  chpl_internal_error("unknown collective data type");
+  return 0;
+}
+
+#define ELTWISE(T, EXPR)                                                \
+  do {                                                                  \
+    T* a = (T*) state;                                                  \
+    const T* b = (const T*) in;                                         \
+    for (size_t i = 0; i < ra->count; i++) {                            \
+      a[i] = (EXPR);                                                    \
+    }                                                                   \
+  } while (0)
+
+#define ARITH_CASES(T)                                                  \
+  case CHPL_COMM_COLL_SUM:  ELTWISE(T, a[i] + b[i]); return;            \
+  case CHPL_COMM_COLL_PROD: ELTWISE(T, a[i] * b[i]); return;            \
+  case CHPL_COMM_COLL_MIN:  ELTWISE(T, b[i] < a[i] ? b[i] : a[i]); return; \
+  case CHPL_COMM_COLL_MAX:  ELTWISE(T, b[i] > a[i] ? b[i] : a[i]); return
+
+#define INT_CASES(T)                                                    \
+  switch (ra->op) {                                                     \
+  ARITH_CASES(T);                                                       \
+  case CHPL_COMM_COLL_BAND: ELTWISE(T, a[i] & b[i]); return;            \
+  case CHPL_COMM_COLL_BOR:  ELTWISE(T, a[i] | b[i]); return;            \
+  case CHPL_COMM_COLL_BXOR: ELTWISE(T, a[i] ^ b[i]); return;            \
+  }                                                                     \
+  break
+
+#define REAL_CASES(T)                                                   \
+  switch (ra->op) {                                                     \
+  ARITH_CASES(T);                                                       \
+  default: break;                                                       \
+  }                                                                     \
+  break
+
+static
+void reduceMerge(void* state, const void* in, void* arg) {
+  reduceArg_t* ra = (reduceArg_t*) arg;
+
+  switch (ra->type) {
+  case CHPL_COMM_COLL_INT32:  INT_CASES(int32_t);
+  case CHPL_COMM_COLL_INT64:  INT_CASES(int64_t);
+  case CHPL_COMM_COLL_UINT32: INT_CASES(uint32_t);
+  case CHPL_COMM_COLL_UINT64: INT_CASES(uint64_t);
+  case CHPL_COMM_COLL_REAL32: REAL_CASES(float);
+  case CHPL_COMM_COLL_REAL64: REAL_CASES(double);
+  }
+  chpl_internal_error("unsupported collective reduction");
+}
+
+#undef REAL_CASES
+#undef INT_CASES
+#undef ARITH_CASES
+#undef ELTWISE
+
+void chpl_comm_coll_dflt_allreduce(void* buf, size_t count,
+                                   chpl_comm_coll_type_t type,
+                                   chpl_comm_coll_op_t op) {
+  const size_t eltSize = collTypeSize(type);
+  const size_t chunkCount = slotDataSize / eltSize;
+  size_t off;
+
+  if (chpl_numNodes == 1) {
+    return;
+  }
+
+  for (off = 0; off < count; off += chunkCount) {
+    reduceArg_t arg = { count - off < chunkCount ? count - off : chunkCount,
+                        type, op };
+    rdExchange((char*) buf + off * eltSize, arg.count * eltSize,
+               reduceMerge, &arg);
+  }
+}
+
+
+//
+// Allgather
+//
+// The state is a bitmap of the nodes whose data is present, followed by
+// a piece of each node's data, in node order.  Large contributions are
+// gathered a piece at a time.
+//
+typedef struct {
+  size_t pieceSize;
+} gatherArg_t;
+
+static
+void gatherMerge(void* state, const void* in, void* arg) {
+  size_t pieceSize = ((gatherArg_t*) arg)->pieceSize;
+  uint64_t* have = (uint64_t*) state;
+  const uint64_t* inHave = (const uint64_t*) in;
+  char* data = (char*) state + bitmapSize;
+  const char* inData = (const char*) in + bitmapSize;
+  c_nodeid_t node;
+
+  for (node = 0; node < chpl_numNodes; node++) {
+    uint64_t bit = (uint64_t) 1 << (node % 64);
+    if ((have[node / 64] & bit) == 0 && (inHave[node / 64] & bit) != 0) {
+      memcpy(data + node * pieceSize, inData + node * pieceSize, pieceSize);
+      have[node / 64] |= bit;
+    }
+  }
+}
+
+void chpl_comm_coll_dflt_allgather(const void* src, void* dst, size_t size) {
+  const size_t maxPieceSize = (slotDataSize - bitmapSize) / chpl_numNodes;
+  char* data = stateBuf + bitmapSize;
+  size_t off;
+  c_nodeid_t node;
+
+  if (chpl_numNodes == 1) {
+    memmove(dst, src, size);
+    return;
+  }
+
+  for (off = 0; off < size; off += maxPieceSize) {
+    gatherArg_t arg = { size - off < maxPieceSize ? size - off
+                                                  : maxPieceSize };
+    memset(stateBuf, 0, bitmapSize);
+    ((uint64_t*) stateBuf)[chpl_nodeID / 64] =
+      (uint64_t) 1 << (chpl_nodeID % 64);
+    memcpy(data + chpl_nodeID * arg.pieceSize, (const char*) src + off,
+           arg.pieceSize);
+    rdExchange(stateBuf, bitmapSize + chpl_numNodes * arg.pieceSize,
+               gatherMerge, &arg);
+    for (node = 0; node < chpl_numNodes; node++) {
+      memcpy((char*) dst + node * size + off, data + node * arg.pieceSize,
+             arg.pieceSize);
+    }
+  }
+}
+
+
+//
+// Alltoall(v)
+//
+// After gathering the addresses of everyone's destination buffer and
+// displacements, each node GETs its displacement on each other node and
+// PUTs its data straight there, starting with its successor to spread
+// out the traffic.  A barrier then tells everyone the data has arrived.
+//
+typedef struct {
+  void* dst;
+  const size_t* dstDispls;
+} a2aAddrs_t;
+
+void chpl_comm_coll_dflt_alltoallv(const void* src, const size_t* srcCounts,
+                                   const size_t* srcDispls,
+                                   void* dst, const size_t* dstDispls) {
+  const c_nodeid_t me = chpl_nodeID;
+  a2aAddrs_t mine = { dst, dstDispls };
+  a2aAddrs_t* all;
+  c_nodeid_t k;
+
+  if (srcCounts[me] > 0) {
+    memmove((char*) dst + dstDispls[me], (const char*) src + srcDispls[me],
+            srcCounts[me]);
+  }
+
+  if (chpl_numNodes == 1) {
+    return;
+  }
+
+  all = chpl_mem_allocMany(chpl_numNodes, sizeof(all[0]),
+                           CHPL_RT_MD_COMM_PER_LOC_INFO, 0, 0);
+  chpl_comm_coll_allgather(&mine, all, sizeof(mine));
+
+  for (k = 1; k < chpl_numNodes; k++) {
+    c_nodeid_t node = (me + k) % chpl_numNodes;
+    size_t displ;
+
+    if (srcCounts[node] == 0) {
+      continue;
+    }
+    chpl_comm_get(&displ, node, (void*) &all[node].dstDispls[me],
+                  sizeof(displ), CHPL_COMM_UNKNOWN_ID, 0, -1);
+    chpl_comm_put((char*) src + srcDispls[node], node,
+                  (char*) all[node].dst + displ, srcCounts[node],
+                  CHPL_COMM_UNKNOWN_ID, 0, -1);
+  }
+
+  chpl_comm_barrier("coll alltoallv");
+  chpl_mem_free(all, 0, 0);
+}
+
+void chpl_comm_coll_alltoall(const void* src, void* dst, size_t size) {
+  size_t* counts;
+  size_t* displs;
+  c_nodeid_t node;
+
+  counts = chpl_mem_allocMany(chpl_numNodes, sizeof(counts[0]),
+                              CHPL_RT_MD_COMM_UTIL, 0, 0);
+  displs = chpl_mem_allocMany(chpl_numNodes, sizeof(displs[0]),
+                              CHPL_RT_MD_COMM_UTIL, 0, 0);
+  for (node = 0; node < chpl_numNodes; node++) {
+    counts[node] = size;
+    displs[node] = node * size;
+  }
+
+  chpl_comm_coll_alltoallv(src, counts, displs, dst, displs);
+
+  chpl_mem_free(displs, 0, 0);
+  chpl_mem_free(counts, 0, 0);
+}
@@ -227,6 +227,7 @@ void chpl_rt_init(int argc, char* argv[]) {
   // tasking layer is initialized.
   //
   chpl_comm_post_task_init();
+  chpl_comm_coll_init();
 #ifdef HAS_CHPL_CACHE_FNS
   chpl_cache_init();
 #endif
@@ -21,6 +21,7 @@
 #include "chplrt.h"
 
 #include "chplmemtrack.h"
+#include "chpl-atomics.h"
 #include "chpl-mem.h"
 #include "chpl-mem-desc.h"
 #include "chpl-mem-sys.h"  // mem layer not initialized yet, need system alloc
@@ -75,16 +76,58 @@ typedef struct memTableEntry_struct { /* table entry */
   struct memTableEntry_struct* nextInBucket;
 } memTableEntry;
 
-#define NUM_HASH_SIZE_INDICES 20
+#define NUM_HASH_SIZE_INDICES 24
 
-static int hashSizes[NUM_HASH_SIZE_INDICES] = { 1543, 3079, 6151, 12289, 24593, 49157, 98317,
+static int hashSizes[NUM_HASH_SIZE_INDICES] = { 97, 193, 389, 769,
+                                                1543, 3079, 6151, 12289, 24593, 49157, 98317,
                                                 196613, 393241, 786433, 1572869, 3145739,
                                                 6291469, 12582917, 25165843, 50331653,
                                                 100663319, 201326611, 402653189, 805306457 };
-static int hashSizeIndex = 0;
-static int hashSize = 0;
 
-static memTableEntry** memTable = NULL;
+//
+// The memory table is split into shards, each with its own lock, hash
+// table, and allocation/free sums, so that tasks allocating and freeing
+// on different threads don't serialize on a single lock.  An entry
+// lives in the shard selected by its address, so a free finds the entry
+// no matter which thread made the allocation.  The reporting functions
+// merge the shards.
+//
+// Two quantities can't be kept per shard: the memory allocated right now
+// has to be known as a whole to enforce memMax, and so does its high
+// water mark.  Those are atomics shared by all the shards.
+//
+// We can't use a sync var for concurrency control here.  The Qthreads
+// internal memory allocator shim references this memory tracking code
+// via the Chapel runtime public memory layer interface.  Referring to a
+// sync var here when exiting (to report memTrack results, say), after
+// the tasking layer is shut down, ends up trying to create a qthread in
+// the terminated Qthreads library.  Chaos results.  So, the shard locks
+// are pthread mutexes, as are the runtime atomics when they are
+// implemented with locks.  Note that this is only safe if we cannot
+// switch tasks on a pthread while holding a mutex and then try to lock
+// it recursively.  Currently that is the case, since we do not yield
+// while holding one.
+//
+#define MEMTRACK_SHARD_BITS 6
+#define NUM_MEMTRACK_SHARDS (1 << MEMTRACK_SHARD_BITS)
+
+typedef struct memTrackShard_struct {
+  pthread_mutex_t lock;
+  memTableEntry** memTable;
+  int hashSizeIndex;
+  int hashSize;
+  size_t totalAllocated;      /* total memory allocated in this shard */
+  size_t totalFreed;          /* total memory freed in this shard */
+  size_t totalEntries;        /* number of entries in the hash table */
+} memTrackShard;
+
+// keep each shard on its own cache line(s)
+typedef union {
+  memTrackShard shard;
+  char pad[((sizeof(memTrackShard) + 63) / 64) * 64];
+} paddedMemTrackShard;
+
+static paddedMemTrackShard memTrackShards[NUM_MEMTRACK_SHARDS];
 
 static _Bool memStats = false;
 static _Bool memLeaksByType = false;
@@ -96,35 +139,31 @@ static c_string memLog = NULL;
 static FILE* memLogFile = NULL;
 static c_string memLeaksLog = NULL;
 
-static size_t totalMem = 0;       /* total memory currently allocated */
-static size_t maxMem = 0;         /* maximum total memory during run  */
-static size_t totalAllocated = 0; /* total memory allocated */
-static size_t totalFreed = 0;     /* total memory freed */
-static size_t totalEntries = 0;     /* number of entries in hash table */
+static atomic_uint_least64_t totalMem; /* total memory currently allocated */
+static atomic_uint_least64_t maxMem;   /* maximum total memory during run  */
 
 
-// We can't use a sync var for concurrency control here.  The Qthreads
-// internal memory allocator shim references this memory tracking code
-// via the Chapel runtime public memory layer interface.  Referring to a
-// sync var here when exiting (to report memTrack results, say), after
-// the tasking layer is shut down, ends up trying to create a qthread in
-// the terminated Qthreads library.  Chaos results.  We also cannot use
-// an atomic var, because with CHPL_ATOMICS=locks those are implemented
-// by means of sync vars.  So, we use a pthread mutex.  Note that this
-// is only safe if we cannot switch tasks on a pthread while holding the
-// mutex and then try to lock it recursively.  Currently that is the
-// case, since we do not yield while holding the mutex.
-// 
-static pthread_mutex_t memTrack_lockVar = PTHREAD_MUTEX_INITIALIZER;
+static inline
+memTrackShard* getShard(int i) {
+  return &memTrackShards[i].shard;
+}
 
+// Select the shard by a multiplicative hash of the address, using bits
+// that the per-shard bucket hash doesn't depend on so much.
 static inline
-void memTrack_lock(void) {
-  (void) pthread_mutex_lock(&memTrack_lockVar);
+memTrackShard* shardFor(void* memAlloc) {
+  uint64_t h = ((uint64_t)(uintptr_t) memAlloc >> 4) * 0x9e3779b97f4a7c15ULL;
+  return getShard((int)(h >> (64 - MEMTRACK_SHARD_BITS)));
 }
 
 static inline
-void memTrack_unlock(void) {
-  (void) pthread_mutex_unlock(&memTrack_lockVar);
+void memTrack_lock(memTrackShard* shard) {
+  (void) pthread_mutex_lock(&shard->lock);
+}
+
+static inline
+void memTrack_unlock(memTrackShard* shard) {
+  (void) pthread_mutex_unlock(&shard->lock);
 }
 
 
@@ -180,9 +219,15 @@ void chpl_setMemFlags(void) {
   }
 
   if (chpl_memTrack) {
-    hashSizeIndex = 0;
-    hashSize = hashSizes[hashSizeIndex];
-    memTable = sys_calloc(hashSize, sizeof(memTableEntry*));
+    atomic_init_uint_least64_t(&totalMem, 0);
+    atomic_init_uint_least64_t(&maxMem, 0);
+    for (int i = 0; i < NUM_MEMTRACK_SHARDS; i++) {
+      memTrackShard* shard = getShard(i);
+      (void) pthread_mutex_init(&shard->lock, NULL);
+      shard->hashSizeIndex = 0;
+      shard->hashSize = hashSizes[shard->hashSizeIndex];
+      shard->memTable = sys_calloc(shard->hashSize, sizeof(memTableEntry*));
+    }
   }
 }
 
@@ -199,37 +244,50 @@ static unsigned hash(void* memAlloc, int hashSize) {
 }
 
 
-static void increaseMemStat(size_t chunk, int32_t lineno, int32_t filename) {
-  totalMem += chunk;
-  totalAllocated += chunk;
-  if (memMax && (totalMem > memMax)) {
+static void increaseMemStat(memTrackShard* shard, size_t chunk,
+                            int32_t lineno, int32_t filename) {
+  uint_least64_t newTotal;
+  uint_least64_t curMax;
+
+  newTotal = atomic_fetch_add_explicit_uint_least64_t(&totalMem, chunk,
+                                                      memory_order_relaxed)
+             + chunk;
+  shard->totalAllocated += chunk;
+  if (memMax && (newTotal > memMax)) {
     chpl_error("Exceeded memory limit", lineno, filename);
   }
-  if (totalMem > maxMem)
-    maxMem = totalMem;
+  curMax = atomic_load_explicit_uint_least64_t(&maxMem, memory_order_relaxed);
+  while (newTotal > curMax &&
+         !atomic_compare_exchange_weak_explicit_uint_least64_t(
+                                                 &maxMem, &curMax, newTotal,
+                                                 memory_order_relaxed,
+                                                 memory_order_relaxed)) {
+    // curMax was updated by the failed exchange, try again
+  }
 }
 
 
-static void decreaseMemStat(size_t chunk) {
-  totalMem -= chunk; // > totalMem ? 0 : totalMem - chunk;
-  totalFreed += chunk;
+static void decreaseMemStat(memTrackShard* shard, size_t chunk) {
+  (void) atomic_fetch_sub_explicit_uint_least64_t(&totalMem, chunk,
+                                                  memory_order_relaxed);
+  shard->totalFreed += chunk;
 }
 
 
 static void
-resizeTable(int direction) {
+resizeTable(memTrackShard* shard, int direction) {
   memTableEntry** newMemTable = NULL;
   int newHashSizeIndex, newHashSize, newHashValue;
   int i;
   memTableEntry* me;
   memTableEntry* next;
 
-  newHashSizeIndex = hashSizeIndex + direction;
+  newHashSizeIndex = shard->hashSizeIndex + direction;
   newHashSize = hashSizes[newHashSizeIndex];
   newMemTable = sys_calloc(newHashSize, sizeof(memTableEntry*));
 
-  for (i = 0; i < hashSize; i++) {
-    for (me = memTable[i]; me != NULL; me = next) {
+  for (i = 0; i < shard->hashSize; i++) {
+    for (me = shard->memTable[i]; me != NULL; me = next) {
       next = me->nextInBucket;
       newHashValue = hash(me->memAlloc, newHashSize);
       me->nextInBucket = newMemTable[newHashValue];
@@ -237,20 +295,22 @@ resizeTable(int direction) {
     }
   }
 
-  sys_free(memTable);
-  memTable = newMemTable;
-  hashSize = newHashSize;
-  hashSizeIndex = newHashSizeIndex;
+  sys_free(shard->memTable);
+  shard->memTable = newMemTable;
+  shard->hashSize = newHashSize;
+  shard->hashSizeIndex = newHashSizeIndex;
 }
 
-static void addMemTableEntry(void *memAlloc, size_t number, size_t size,
+static void addMemTableEntry(memTrackShard* shard,
+                             void *memAlloc, size_t number, size_t size,
                              chpl_mem_descInt_t description, int32_t lineno,
                              int32_t filename) {
   unsigned hashValue;
   memTableEntry* memEntry;
 
-  if ((totalEntries+1)*2 > hashSize && hashSizeIndex < NUM_HASH_SIZE_INDICES-1)
-    resizeTable(1);
+  if ((shard->totalEntries+1)*2 > shard->hashSize &&
+      shard->hashSizeIndex < NUM_HASH_SIZE_INDICES-1)
+    resizeTable(shard, 1);
 
   memEntry = (memTableEntry*) sys_calloc(1, sizeof(memTableEntry));
   if (!memEntry) {
@@ -258,33 +318,34 @@ static void addMemTableEntry(void *memAlloc, size_t number, size_t size,
                lineno, filename);
   }
 
-  hashValue = hash(memAlloc, hashSize);
-  memEntry->nextInBucket = memTable[hashValue];
-  memTable[hashValue] = memEntry;
+  hashValue = hash(memAlloc, shard->hashSize);
+  memEntry->nextInBucket = shard->memTable[hashValue];
+  shard->memTable[hashValue] = memEntry;
   memEntry->description = description;
   memEntry->memAlloc = memAlloc;
   memEntry->lineno = lineno;
   memEntry->filename = filename;
   memEntry->number = number;
   memEntry->size = size;
-  increaseMemStat(number*size, lineno, filename);
-  totalEntries += 1;
+  increaseMemStat(shard, number*size, lineno, filename);
+  shard->totalEntries += 1;
 }
 
 
-static memTableEntry* removeMemTableEntry(void* address) {
-  unsigned hashValue = hash(address, hashSize);
-  memTableEntry* thisBucketEntry = memTable[hashValue];
+static memTableEntry* removeMemTableEntry(memTrackShard* shard,
+                                          void* address) {
+  unsigned hashValue = hash(address, shard->hashSize);
+  memTableEntry* thisBucketEntry = shard->memTable[hashValue];
   memTableEntry* deletedBucket = NULL;
 
   if (!thisBucketEntry)
     return NULL;
 
   if (thisBucketEntry->memAlloc == address) {
-    memTable[hashValue] = thisBucketEntry->nextInBucket;
+    shard->memTable[hashValue] = thisBucketEntry->nextInBucket;
     deletedBucket = thisBucketEntry;
   } else {
-    for (thisBucketEntry = memTable[hashValue];
+    for (thisBucketEntry = shard->memTable[hashValue];
          thisBucketEntry != NULL;
          thisBucketEntry = thisBucketEntry->nextInBucket) {
 
@@ -297,10 +358,10 @@ static memTableEntry* removeMemTableEntry(void* address) {
     }
   }
   if (deletedBucket) {
-    decreaseMemStat(deletedBucket->number * deletedBucket->size);
-    totalEntries -= 1;
-    if (totalEntries*8 < hashSize && hashSizeIndex > 0)
-      resizeTable(-1);
+    decreaseMemStat(shard, deletedBucket->number * deletedBucket->size);
+    shard->totalEntries -= 1;
+    if (shard->totalEntries*8 < shard->hashSize && shard->hashSizeIndex > 0)
+      resizeTable(shard, -1);
   }
   return deletedBucket;
 }
@@ -313,7 +374,21 @@ uint64_t chpl_memoryUsed(int32_t lineno, int32_t filename) {
     return 0;
   }
 
-  return (uint64_t)totalMem;
+  return (uint64_t)atomic_load_uint_least64_t(&totalMem);
+}
+
+
+// Sum the allocations and frees across the shards.
+static void sumAllocsAndFrees(size_t* allocated, size_t* freed) {
+  *allocated = 0;
+  *freed = 0;
+  for (int i = 0; i < NUM_MEMTRACK_SHARDS; i++) {
+    memTrackShard* shard = getShard(i);
+    memTrack_lock(shard);
+    *allocated += shard->totalAllocated;
+    *freed += shard->totalFreed;
+    memTrack_unlock(shard);
+  }
 }
 
 
@@ -345,17 +420,21 @@ void chpl_printMemAllocStats(int32_t lineno, int32_t filename) {
   }
 
   //
-  // Take a pre-run through the descriptions and values to figure
-  // out how long each line will need to be.
+  // Merge the shards' values into a snapshot, then take a pre-run
+  // through the descriptions and values to figure out how long each
+  // line will need to be.
   //
-  static const struct {
+  size_t totalAllocated, totalFreed;
+  sumAllocsAndFrees(&totalAllocated, &totalFreed);
+
+  const struct {
     const char* desc;
-    size_t* val;
+    size_t val;
   } descsVals[] = {
-    { "Allocated Now:", &totalMem },
-    { "Allocation High Water Mark:", &maxMem },
-    { "Sum of Allocations:", &totalAllocated },
-    { "Sum of Frees:", &totalFreed },
+    { "Allocated Now:", atomic_load_uint_least64_t(&totalMem) },
+    { "Allocation High Water Mark:", atomic_load_uint_least64_t(&maxMem) },
+    { "Sum of Allocations:", totalAllocated },
+    { "Sum of Frees:", totalFreed },
   };
   const int nDescsVals = sizeof(descsVals) / sizeof(descsVals[0]);
 
@@ -367,9 +446,9 @@ void chpl_printMemAllocStats(int32_t lineno, int32_t filename) {
     if (thisDescWidth > descWidth)
       descWidth = thisDescWidth;
     const int thisMemWidth =
-                (*descsVals[i].val == 0)
+                (descsVals[i].val == 0)
                 ? 1
-                : (int) lrint(ceil(log10((double) *descsVals[i].val)));
+                : (int) lrint(ceil(log10((double) descsVals[i].val)));
     if (thisMemWidth > memWidth)
       memWidth = thisMemWidth;
   }
@@ -381,19 +460,15 @@ void chpl_printMemAllocStats(int32_t lineno, int32_t filename) {
   char buf[4 * (strlen(prefixBuf) + 1 + descWidth + 1 + memWidth + 1) + 1];
   size_t len;
 
-  memTrack_lock();
-
   len = 0;
   for (int i = 0; i < nDescsVals; i++) {
     len += snprintf(buf + len, sizeof(buf) - len,
                     "%s %-*s %*zd\n",
                     prefixBuf,
                     descWidth, descsVals[i].desc,
-                    memWidth, *descsVals[i].val);
+                    memWidth, descsVals[i].val);
   }
 
-  memTrack_unlock();
-
   fputs(buf, memLogFile);
 }
 
@@ -421,12 +496,17 @@ static void printMemAllocsByType(_Bool forLeaks,
 
   table = (size_t*)sys_calloc(numEntries, 3*sizeof(size_t));
 
-  for (i = 0; i < hashSize; i++) {
-    for (me = memTable[i]; me != NULL; me = me->nextInBucket) {
-      table[3*me->description] += me->number*me->size;
-      table[3*me->description+1] += 1;
-      table[3*me->description+2] = me->description;
+  for (int s = 0; s < NUM_MEMTRACK_SHARDS; s++) {
+    memTrackShard* shard = getShard(s);
+    memTrack_lock(shard);
+    for (i = 0; i < shard->hashSize; i++) {
+      for (me = shard->memTable[i]; me != NULL; me = me->nextInBucket) {
+        table[3*me->description] += me->number*me->size;
+        table[3*me->description+1] += 1;
+        table[3*me->description+2] = me->description;
+      }
     }
+    memTrack_unlock(shard);
   }
 
   qsort(table, numEntries, 3*sizeof(size_t), memTableEntryCmp);
@@ -490,8 +570,8 @@ void chpl_printMemAllocsByDesc(const char* descString, int64_t threshold,
 
 
 static int descCmp(const void* p1, const void* p2) {
-  memTableEntry* m1 = *(memTableEntry**)p1;
-  memTableEntry* m2 = *(memTableEntry**)p2;
+  const memTableEntry* m1 = (const memTableEntry*)p1;
+  const memTableEntry* m2 = (const memTableEntry*)p2;
   c_string m1Filename;
   c_string m2Filename;
 
@@ -507,6 +587,48 @@ static int descCmp(const void* p1, const void* p2) {
 }
 
 
+// Copy the entries of all the shards that match description (or all of them,
+// if it is -1) and are at least threshold bytes.  The copies stay valid while
+// other tasks keep allocating and freeing.
+static memTableEntry*
+snapshotMemTable(chpl_mem_descInt_t description, int64_t threshold, int* num,
+                 int32_t lineno, int32_t filename) {
+  memTableEntry* table = NULL;
+  memTableEntry* memEntry;
+  int n = 0;
+  int capacity = 0;
+
+  for (int s = 0; s < NUM_MEMTRACK_SHARDS; s++) {
+    memTrackShard* shard = getShard(s);
+    memTrack_lock(shard);
+    for (int i = 0; i < shard->hashSize; i++) {
+      for (memEntry = shard->memTable[i];
+           memEntry != NULL;
+           memEntry = memEntry->nextInBucket) {
+        size_t chunk = memEntry->number * memEntry->size;
+        if (chunk < threshold)
+          continue;
+        if (description != -1 && memEntry->description != description)
+          continue;
+        if (n == capacity) {
+          capacity = (capacity == 0) ? 1024 : 2 * capacity;
+          table = (memTableEntry*)sys_realloc(table,
+                                              capacity*sizeof(memTableEntry));
+          if (!table)
+            chpl_error("out of memory printing memory table",
+                       lineno, filename);
+        }
+        table[n++] = *memEntry;
+      }
+    }
+    memTrack_unlock(shard);
+  }
+
+  *num = n;
+  return table;
+}
+
+
 // If description is -1, print all entries; otherwise print only those with the
 // matching CHPL_RT_MD_ descriptor.
 // Print only those entries exceeding threshold.
@@ -529,7 +651,7 @@ printMemAllocs(chpl_mem_descInt_t description, int64_t threshold,
   c_string memEntryFilename;
   int n, i;
   char* loc;
-  memTableEntry** table;
+  memTableEntry* table;
 
   if (!chpl_memTrack) {
     chpl_warning("invalid call to printMemAllocs(); rerun with --memTrack",
@@ -537,22 +659,16 @@ printMemAllocs(chpl_mem_descInt_t description, int64_t threshold,
     return;
   }
 
-  n = 0;
+  table = snapshotMemTable(description, threshold, &n, lineno, filename);
+
   filenameWidth = strlen("Allocated Memory (Bytes)");
-  for (i = 0; i < hashSize; i++) {
-    for (memEntry = memTable[i]; memEntry != NULL; memEntry = memEntry->nextInBucket) {
-      size_t chunk = memEntry->number * memEntry->size;
-      if (chunk < threshold)
-        continue;
-      if (description != -1 && memEntry->description != description)
-        continue;
-      n += 1;
-      if (memEntry->filename) {
-        memEntryFilename = chpl_lookupFilename(memEntry->filename);
-        filenameLength = strlen(memEntryFilename);
-        if (filenameLength > filenameWidth)
-          filenameWidth = filenameLength;
-      }
+  for (i = 0; i < n; i++) {
+    memEntry = &table[i];
+    if (memEntry->filename) {
+      memEntryFilename = chpl_lookupFilename(memEntry->filename);
+      filenameLength = strlen(memEntryFilename);
+      if (filenameLength > filenameWidth)
+        filenameWidth = filenameLength;
     }
   }
 
@@ -579,27 +695,12 @@ printMemAllocs(chpl_mem_descInt_t description, int64_t threshold,
     fprintf(memLogFile, "=");
   fprintf(memLogFile, "\n");
 
-  table = (memTableEntry**)sys_malloc(n*sizeof(memTableEntry*));
-  if (!table)
-    chpl_error("out of memory printing memory table", lineno, filename);
-
-  n = 0;
-  for (i = 0; i < hashSize; i++) {
-    for (memEntry = memTable[i]; memEntry != NULL; memEntry = memEntry->nextInBucket) {
-      size_t chunk = memEntry->number * memEntry->size;
-      if (chunk < threshold)
-        continue;
-      if (description != -1 && memEntry->description != description)
-        continue;
-      table[n++] = memEntry;
-    }
-  }
-  qsort(table, n, sizeof(memTableEntry*), descCmp);
+  qsort(table, n, sizeof(memTableEntry), descCmp);
 
   loc = (char*)sys_malloc((filenameWidth+numberWidth+1)*sizeof(char));
 
   for (i = 0; i < n; i++) {
-    memEntry = table[i];
+    memEntry = &table[i];
     if (memEntry->filename) {
       memEntryFilename = chpl_lookupFilename(memEntry->filename);
       sprintf(loc, "%s:%" PRId32, memEntryFilename, memEntry->lineno);
@@ -630,19 +731,19 @@ void chpl_reportMemInfo() {
     chpl_printMemAllocStats(0, 0);
   }
   if (memLeaksByType) {
-    if (totalMem) {
+    if (atomic_load_uint_least64_t(&totalMem)) {
       fprintf(memLogFile, "\n");
       printMemAllocsByType(true /* forLeaks */, 0, 0);
     }
   }
   if (memLeaksByDesc && strcmp(memLeaksByDesc, "")) {
-    if (totalMem) {
+    if (atomic_load_uint_least64_t(&totalMem)) {
       fprintf(memLogFile, "\n");
       chpl_printMemAllocsByDesc(memLeaksByDesc, memThreshold, 0, 0);
     }
   }
   if (memLeaks) {
-    if (totalMem) {
+    if (atomic_load_uint_least64_t(&totalMem)) {
       fprintf(memLogFile, "\n");
       printMemAllocs(-1, memThreshold, 0, 0);
     }
@@ -666,9 +767,11 @@ void chpl_track_malloc(void* memAlloc, size_t number, size_t size,
                        int32_t lineno, int32_t filename) {
   if (number * size > memThreshold) {
     if (chpl_memTrack && chpl_mem_descTrack(description)) {
-      memTrack_lock();
-      addMemTableEntry(memAlloc, number, size, description, lineno, filename);
-      memTrack_unlock();
+      memTrackShard* shard = shardFor(memAlloc);
+      memTrack_lock(shard);
+      addMemTableEntry(shard, memAlloc, number, size, description,
+                       lineno, filename);
+      memTrack_unlock(shard);
     }
     if (chpl_verbose_mem) {
       fprintf(memLogFile, "%" PRI_c_nodeid_t ": %s:%" PRId32
@@ -684,8 +787,10 @@ void chpl_track_malloc(void* memAlloc, size_t number, size_t size,
 void chpl_track_free(void* memAlloc, int32_t lineno, int32_t filename) {
   memTableEntry* memEntry = NULL;
   if (chpl_memTrack) {
-    memTrack_lock();
-    memEntry = removeMemTableEntry(memAlloc);
+    memTrackShard* shard = shardFor(memAlloc);
+    memTrack_lock(shard);
+    memEntry = removeMemTableEntry(shard, memAlloc);
+    memTrack_unlock(shard);
     if (memEntry) {
       if (chpl_verbose_mem) {
         fprintf(memLogFile, "%" PRI_c_nodeid_t ": %s:%" PRId32
@@ -696,7 +801,6 @@ void chpl_track_free(void* memAlloc, int32_t lineno, int32_t filename) {
       }
       sys_free(memEntry);
     }
-    memTrack_unlock();
   } else if (chpl_verbose_mem && !memEntry) {
     fprintf(memLogFile, "%" PRI_c_nodeid_t ": %s:%" PRId32 ": free at %p\n",
             chpl_nodeID, (filename ? chpl_lookupFilename(filename) : "--"),
@@ -711,13 +815,14 @@ void chpl_track_realloc_pre(void* memAlloc, size_t size,
   memTableEntry* memEntry = NULL;
 
   if (chpl_memTrack && size > memThreshold) {
-    memTrack_lock();
     if (memAlloc) {
-      memEntry = removeMemTableEntry(memAlloc);
+      memTrackShard* shard = shardFor(memAlloc);
+      memTrack_lock(shard);
+      memEntry = removeMemTableEntry(shard, memAlloc);
+      memTrack_unlock(shard);
       if (memEntry)
         sys_free(memEntry);
     }
-    memTrack_unlock();
   }
 }
 
@@ -728,9 +833,11 @@ void chpl_track_realloc_post(void* moreMemAlloc,
                          int32_t lineno, int32_t filename) {
   if (size > memThreshold) {
     if (chpl_memTrack && chpl_mem_descTrack(description)) {
-      memTrack_lock();
-      addMemTableEntry(moreMemAlloc, 1, size, description, lineno, filename);
-      memTrack_unlock();
+      memTrackShard* shard = shardFor(moreMemAlloc);
+      memTrack_lock(shard);
+      addMemTableEntry(shard, moreMemAlloc, 1, size, description,
+                       lineno, filename);
+      memTrack_unlock(shard);
     }
     if (chpl_verbose_mem) {
       fprintf(memLogFile, "%" PRI_c_nodeid_t ": %s:%" PRId32
@@ -1050,6 +1050,93 @@ void chpl_comm_barrier(const char *msg) {
   GASNET_Safe_Retval(gasnet_barrier_try(id, 0), retval);
 }
 
+//
+// Native collectives.  GASNet-EX has broadcast and reductions; the
+// other collectives use the defaults in chpl-comm-coll.c.
+//
+static gex_TM_t coll_team(void) {
+  gex_TM_t tm;
+  gasnet_QueryGexObjects(NULL, NULL, &tm, NULL);
+  return tm;
+}
+
+static void coll_wait(gex_Event_t ev) {
+  // yield while waiting, for the same reasons as in chpl_comm_barrier()
+  while (gex_Event_Test(ev) == GASNET_ERR_NOT_READY) {
+    chpl_task_yield();
+  }
+}
+
+void chpl_comm_impl_collBroadcast(c_nodeid_t root, void* buf, size_t size) {
+  if (chpl_numNodes == 1 || size == 0)
+    return;
+  coll_wait(gex_Coll_BroadcastNB(coll_team(), root, buf, buf, size, 0));
+}
+
+void chpl_comm_impl_collAllreduce(void* buf, size_t count, int type, int op) {
+  gex_DT_t dt = 0;
+  size_t dt_sz = 0;
+  gex_OP_t gop = 0;
+  chpl_bool isReal = false;
+
+  switch ((chpl_comm_coll_type_t) type) {
+  case CHPL_COMM_COLL_INT32:  dt = GEX_DT_I32; dt_sz = 4; break;
+  case CHPL_COMM_COLL_INT64:  dt = GEX_DT_I64; dt_sz = 8; break;
+  case CHPL_COMM_COLL_UINT32: dt = GEX_DT_U32; dt_sz = 4; break;
+  case CHPL_COMM_COLL_UINT64: dt = GEX_DT_U64; dt_sz = 8; break;
+  case CHPL_COMM_COLL_REAL32: dt = GEX_DT_FLT; dt_sz = 4; isReal = true; break;
+  case CHPL_COMM_COLL_REAL64: dt = GEX_DT_DBL; dt_sz = 8; isReal = true; break;
+  default:
+    chpl_internal_error("unknown collective data type");
+  }
+
+  switch ((chpl_comm_coll_op_t) op) {
+  case CHPL_COMM_COLL_SUM:  gop = GEX_OP_ADD;  break;
+  case CHPL_COMM_COLL_PROD: gop = GEX_OP_MULT; break;
+  case CHPL_COMM_COLL_MIN:  gop = GEX_OP_MIN;  break;
+  case CHPL_COMM_COLL_MAX:  gop = GEX_OP_MAX;  break;
+  case CHPL_COMM_COLL_BAND: gop = GEX_OP_AND;  break;
+  case CHPL_COMM_COLL_BOR:  gop = GEX_OP_OR;   break;
+  case CHPL_COMM_COLL_BXOR: gop = GEX_OP_XOR;  break;
+  default:
+    chpl_internal_error("unknown collective reduction");
+  }
+
+  if (isReal
+      && (gop == GEX_OP_AND || gop == GEX_OP_OR || gop == GEX_OP_XOR)) {
+    chpl_internal_error("unsupported collective reduction");
+  }
+
+  if (chpl_numNodes == 1 || count == 0)
+    return;
+  coll_wait(gex_Coll_ReduceToAllNB(coll_team(), buf, buf, dt, dt_sz, count,
+                                   gop, NULL, NULL, 0));
+}
+
+void chpl_comm_coll_allgather_addrs_helper(void* mine, void** all) {
+  uint64_t* contrib;
+  uint64_t* result;
+  int node;
+
+  //
+  // There's no native allgather, so OR together vectors that are zero
+  // except for each node's own address.
+  //
+  contrib = chpl_mem_allocManyZero(chpl_numNodes, sizeof(*contrib),
+                                   CHPL_RT_MD_COMM_PER_LOC_INFO, 0, 0);
+  result = chpl_mem_allocMany(chpl_numNodes, sizeof(*result),
+                              CHPL_RT_MD_COMM_PER_LOC_INFO, 0, 0);
+  contrib[chpl_nodeID] = (uint64_t) (uintptr_t) mine;
+  coll_wait(gex_Coll_ReduceToAllNB(coll_team(), result, contrib,
+                                   GEX_DT_U64, sizeof(*contrib),
+                                   chpl_numNodes, GEX_OP_OR, NULL, NULL, 0));
+  for (node = 0; node < chpl_numNodes; node++) {
+    all[node] = (void*) (uintptr_t) result[node];
+  }
+  chpl_mem_free(result, 0, 0);
+  chpl_mem_free(contrib, 0, 0);
+}
+
 void chpl_comm_pre_task_exit(int all) {
   if (all) {
 
@@ -150,6 +150,10 @@ void chpl_comm_rollcall(void) {
 
 wide_ptr_t* chpl_comm_broadcast_global_vars_helper(void) { return NULL; }
 
+void chpl_comm_coll_allgather_addrs_helper(void* mine, void** all) {
+  all[0] = mine;
+}
+
 void chpl_comm_broadcast_private(int id, size_t size) { }
 
 void chpl_comm_barrier(const char *msg) { }
@@ -2149,6 +2149,13 @@ wide_ptr_t* chpl_comm_broadcast_global_vars_helper(void) {
 }
 
 
+void chpl_comm_coll_allgather_addrs_helper(void* mine, void** all) {
+  DBG_PRINTF(DBG_IFACE_SETUP, "%s()", __func__);
+
+  chpl_comm_ofi_oob_allgather(&mine, all, sizeof(mine));
+}
+
+
 static void*** chplPrivBcastTabMap;
 
 static
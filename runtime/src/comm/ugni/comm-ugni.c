@@ -3885,6 +3885,32 @@ wide_ptr_t* chpl_comm_broadcast_global_vars_helper() {
 }
 
 
+void chpl_comm_coll_allgather_addrs_helper(void* mine, void** all) {
+  //
+  // PMI_Allgather() yields unordered results, so gather (locale, addr)
+  // pairs and scatter the addresses by locale.
+  //
+  typedef struct {
+    c_nodeid_t nodeID;
+    void* addr;
+  } gdata_t;
+
+  gdata_t  my_gdata = { chpl_nodeID, mine };
+  gdata_t* gdata;
+
+  gdata = (gdata_t*) chpl_mem_allocMany(chpl_numNodes, sizeof(gdata[0]),
+                                        CHPL_RT_MD_COMM_PER_LOC_INFO, 0, 0);
+  if (PMI_Allgather(&my_gdata, gdata, sizeof(gdata[0])) != PMI_SUCCESS)
+    CHPL_INTERNAL_ERROR("PMI_Allgather(collective scratch addrs) failed");
+
+  for (int i = 0; i < chpl_numNodes; i++) {
+    all[gdata[i].nodeID] = gdata[i].addr;
+  }
+
+  chpl_mem_free(gdata, 0, 0);
+}
+
+
 void chpl_comm_broadcast_private(int id, size_t size)
 {
   int i;
@@ -20,6 +20,7 @@
 
 #include "chplrt.h"
 
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
@@ -27,6 +28,7 @@
 
 #include "chpl-comm.h"
 #include "chpl-mem.h"
+#include "chpl-mem-sys.h"
 #include "chplmemtrack.h"
 #include "chpltypes.h"
 #include "error.h"
@@ -45,3 +47,109 @@ void chpl_mem_layerInit(void) {
 
 
 void chpl_mem_layerExit(void) { }
+
+
+//
+// Dedicated arenas.  The system allocator has no arenas of its own, so
+// here an arena is a list of large blocks that allocations are carved
+// from in order, and resetting it frees the blocks.
+//
+#define ARENA_BLOCK_SIZE ((size_t) 1 << 20)
+#define ARENA_MIN_ALIGNMENT ((size_t) 16)
+
+typedef struct arenaBlock_s {
+  struct arenaBlock_s* next;
+  size_t size;  // usable bytes, following the header
+  size_t used;
+} arenaBlock;
+
+// keep the start of each block's space at the minimum alignment
+#define ARENA_HEADER_SIZE \
+  ((sizeof(arenaBlock) + ARENA_MIN_ALIGNMENT - 1) & ~(ARENA_MIN_ALIGNMENT - 1))
+
+struct chpl_mem_arena_s {
+  pthread_mutex_t lock;
+  arenaBlock* blocks;  // the block in use first
+};
+
+chpl_mem_arena_t chpl_mem_arena_create(void) {
+  struct chpl_mem_arena_s* arena;
+
+  if ((arena = sys_malloc(sizeof(*arena))) == NULL) {
+    chpl_internal_error("could not allocate a dedicated arena descriptor");
+  }
+  (void) pthread_mutex_init(&arena->lock, NULL);
+  arena->blocks = NULL;
+  return arena;
+}
+
+// Find aligned space in the block in use, or return NULL.
+static void* arenaBlockAlloc(arenaBlock* block, size_t size,
+                             size_t alignment) {
+  uintptr_t start;
+  uintptr_t p;
+
+  if (block == NULL) {
+    return NULL;
+  }
+  start = (uintptr_t) block + ARENA_HEADER_SIZE;
+  p = (start + block->used + alignment - 1) & ~(alignment - 1);
+  if (p + size > start + block->size) {
+    return NULL;
+  }
+  block->used = p + size - start;
+  return (void*) p;
+}
+
+void* chpl_mem_arena_alloc(chpl_mem_arena_t arena, size_t size,
+                           size_t alignment) {
+  void* p;
+
+  if (size == 0) {
+    size = 1;
+  }
+  if (alignment < ARENA_MIN_ALIGNMENT) {
+    alignment = ARENA_MIN_ALIGNMENT;
+  }
+
+  (void) pthread_mutex_lock(&arena->lock);
+
+  if ((p = arenaBlockAlloc(arena->blocks, size, alignment)) == NULL) {
+    // start a new block, big enough for this even at its alignment
+    arenaBlock* block;
+    size_t blockSize = size + alignment;
+    if (blockSize < ARENA_BLOCK_SIZE) {
+      blockSize = ARENA_BLOCK_SIZE;
+    }
+    if ((block = sys_malloc(ARENA_HEADER_SIZE + blockSize)) != NULL) {
+      block->next = arena->blocks;
+      block->size = blockSize;
+      block->used = 0;
+      arena->blocks = block;
+      p = arenaBlockAlloc(block, size, alignment);
+    }
+  }
+
+  (void) pthread_mutex_unlock(&arena->lock);
+
+  return p;
+}
+
+void chpl_mem_arena_reset(chpl_mem_arena_t arena) {
+  arenaBlock* block;
+  arenaBlock* next;
+
+  (void) pthread_mutex_lock(&arena->lock);
+  for (block = arena->blocks; block != NULL; block = next) {
+    next = block->next;
+    sys_free(block);
+  }
+  arena->blocks = NULL;
+  (void) pthread_mutex_unlock(&arena->lock);
+}
+
+void chpl_mem_arena_destroy(chpl_mem_arena_t arena) {
+  chpl_mem_arena_reset(arena);
+  (void) pthread_mutex_destroy(&arena->lock);
+  sys_free(arena);
+}
@@ -26,10 +26,13 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "chpl-atomics.h"
 #include "chpl-comm.h"
 #include "chpl-linefile-support.h"
 #include "chpl-mem.h"
 #include "chpl-mem-desc.h"
+#include "chpl-mem-sys.h"
+#include "chpl-topo.h"
 #include "chplmemtrack.h"
 #include "chpltypes.h"
 #include "error.h"
@@ -241,15 +244,12 @@ static void initialize_arenas(void) {
 }
 
 
-// replace the chunk hooks for each arena with the hooks we provided above
-static void replaceChunkHooks(void) {
+// replace the chunk hooks for an arena with the hooks we provided above
+static void setChunkHooks(unsigned arena) {
 
 // we can't use chunk hooks for older versions of jemalloc
 #ifdef USE_JE_CHUNK_HOOKS
 
-  unsigned narenas;
-  unsigned arena;
-
   // set the pointers for the new_hooks to our above functions
   chunk_hooks_t new_hooks = {
     chunk_alloc,
@@ -261,14 +261,10 @@ static void replaceChunkHooks(void) {
     null_merge
   };
 
-  // for each arena, change the chunk hooks
-  narenas = get_num_arenas();
-  for (arena=0; arena<narenas; arena++) {
-    char path[128];
-    snprintf(path, sizeof(path), "arena.%u.chunk_hooks", arena);
-    if (CHPL_JE_MALLCTL(path, NULL, NULL, &new_hooks, sizeof(chunk_hooks_t)) != 0) {
-      chpl_internal_error("could not update the chunk hooks");
-    }
+  char path[128];
+  snprintf(path, sizeof(path), "arena.%u.chunk_hooks", arena);
+  if (CHPL_JE_MALLCTL(path, NULL, NULL, &new_hooks, sizeof(chunk_hooks_t)) != 0) {
+    chpl_internal_error("could not update the chunk hooks");
   }
 #else
     chpl_internal_error("cannot init multi-locale heap: please rebuild with jemalloc >= 4.1");
@@ -276,6 +272,17 @@ static void replaceChunkHooks(void) {
 
 }
 
+// replace the chunk hooks for each arena
+static void replaceChunkHooks(void) {
+  unsigned narenas;
+  unsigned arena;
+
+  narenas = get_num_arenas();
+  for (arena=0; arena<narenas; arena++) {
+    setChunkHooks(arena);
+  }
+}
+
 // helper routines to get the number of size classes
 static unsigned get_num_small_classes(void) {
   return get_unsigned_mallctl_value("arenas.nbins");
@@ -371,6 +378,160 @@ static void initializeSharedHeap(void) {
 // minimize contention for large allocations)
 unsigned CHPL_JE_LG_ARENA;
 
+
+//
+// Thread arenas.  The automatic arenas other than the large allocation
+// one are divided evenly into a group for each NUMA domain, and each
+// thread is bound round-robin to an arena in the group for the domain it
+// runs on.  This keeps the arena metadata a thread touches local to it
+// and spreads the threads of a domain over that domain's arenas, rather
+// than leaving the arena choice to jemalloc, which doesn't know about
+// NUMA domains.  Threads that aren't confined to one NUMA domain, such
+// as the main thread or comm threads, are bound round-robin to any of
+// the thread arenas.  Threads are bound lazily, on their first
+// allocation after the memory layer is initialized.
+//
+static chpl_bool threadArenasReady = false;
+static unsigned numThreadArenas;
+static unsigned numArenaGroups;
+static unsigned arenasPerGroup;
+static atomic_uint_least32_t* nextArenaInGroup;
+static atomic_uint_least32_t nextArena;
+
+#ifdef CHPL_TLS
+CHPL_TLS_DECL_INIT(chpl_bool, chpl_je_thread_arena_bound);
+
+void chpl_je_bind_thread_arena(void) {
+  c_sublocid_t subloc;
+  unsigned arena;
+
+  if (!threadArenasReady) {
+    return;
+  }
+
+  // mark the thread as bound first, in case binding it allocates
+  CHPL_TLS_SET(chpl_je_thread_arena_bound, true);
+
+  // this is c_sublocid_any unless the thread runs in exactly one domain
+  subloc = (numArenaGroups > 1) ? chpl_topo_getThreadLocality()
+                                : c_sublocid_any;
+  if (subloc >= 0 && subloc < numArenaGroups) {
+    arena = subloc * arenasPerGroup
+            + (atomic_fetch_add_uint_least32_t(&nextArenaInGroup[subloc], 1)
+               % arenasPerGroup);
+  } else {
+    arena = atomic_fetch_add_uint_least32_t(&nextArena, 1) % numThreadArenas;
+  }
+  set_arena(arena);
+}
+#endif
+
+static void initializeThreadArenas(void) {
+#ifdef CHPL_TLS
+  unsigned group;
+
+  // leave out the large allocation arena
+  numThreadArenas = get_num_arenas() - 1;
+  if (numThreadArenas < 2) {
+    return;
+  }
+
+  numArenaGroups = chpl_topo_getNumNumaDomains();
+  if (numArenaGroups < 1 || numArenaGroups > numThreadArenas) {
+    numArenaGroups = 1;
+  }
+  arenasPerGroup = numThreadArenas / numArenaGroups;
+
+  nextArenaInGroup = sys_malloc(numArenaGroups * sizeof(*nextArenaInGroup));
+  if (nextArenaInGroup == NULL) {
+    chpl_internal_error("cannot allocate the arena group counters");
+  }
+  for (group = 0; group < numArenaGroups; group++) {
+    atomic_init_uint_least32_t(&nextArenaInGroup[group], 0);
+  }
+  atomic_init_uint_least32_t(&nextArena, 0);
+
+  threadArenasReady = true;
+#endif
+}
+
+
+//
+// Dedicated arenas, for the chpl_mem_arena_*() interface.  These are
+// arenas created with arenas.extend, so that arena.<i>.reset can discard
+// everything allocated from them at once.  jemalloc can't destroy arenas,
+// so destroyed ones are kept on a list and reused.  Allocations bypass the
+// thread caches, which would otherwise hold on to memory the reset frees.
+//
+struct chpl_mem_arena_s {
+  unsigned ind;
+  struct chpl_mem_arena_s* next;
+};
+
+static struct chpl_mem_arena_s* freeDedicatedArenas = NULL;
+static pthread_mutex_t dedicatedArenasLock = PTHREAD_MUTEX_INITIALIZER;
+
+chpl_mem_arena_t chpl_mem_arena_create(void) {
+  struct chpl_mem_arena_s* arena;
+
+  (void) pthread_mutex_lock(&dedicatedArenasLock);
+  arena = freeDedicatedArenas;
+  if (arena != NULL) {
+    freeDedicatedArenas = arena->next;
+  }
+  (void) pthread_mutex_unlock(&dedicatedArenasLock);
+
+  if (arena == NULL) {
+    unsigned ind;
+    size_t sz = sizeof(ind);
+
+    if (CHPL_JE_MALLCTL("arenas.extend", &ind, &sz, NULL, 0) != 0) {
+      chpl_internal_error("could not create a dedicated arena");
+    }
+
+    // nothing has been allocated from the new arena yet, so it's safe to
+    // point it at the shared heap now
+    if (heap.type != NONE) {
+      setChunkHooks(ind);
+    }
+
+    if ((arena = sys_malloc(sizeof(*arena))) == NULL) {
+      chpl_internal_error("could not allocate a dedicated arena descriptor");
+    }
+    arena->ind = ind;
+  }
+
+  arena->next = NULL;
+  return arena;
+}
+
+void* chpl_mem_arena_alloc(chpl_mem_arena_t arena, size_t size,
+                           size_t alignment) {
+  int flags = MALLOCX_ARENA(arena->ind) | MALLOCX_TCACHE_NONE;
+  if (alignment > 0) {
+    flags |= MALLOCX_ALIGN(alignment);
+  }
+  return CHPL_JE_MALLOCX(minSize(size), flags);
+}
+
+void chpl_mem_arena_reset(chpl_mem_arena_t arena) {
+  char path[128];
+  snprintf(path, sizeof(path), "arena.%u.reset", arena->ind);
+  if (CHPL_JE_MALLCTL(path, NULL, NULL, NULL, 0) != 0) {
+    chpl_internal_error("could not reset a dedicated arena");
+  }
+}
+
+void chpl_mem_arena_destroy(chpl_mem_arena_t arena) {
+  chpl_mem_arena_reset(arena);
+
+  (void) pthread_mutex_lock(&dedicatedArenasLock);
+  arena->next = freeDedicatedArenas;
+  freeDedicatedArenas = arena;
+  (void) pthread_mutex_unlock(&dedicatedArenasLock);
+}
+
+
 void chpl_mem_layerInit(void) {
   void* heap_base;
   size_t heap_size;
@@ -408,6 +569,8 @@ void chpl_mem_layerInit(void) {
     CHPL_JE_DALLOCX(p, MALLOCX_NO_FLAGS);
   }
   CHPL_JE_LG_ARENA = get_num_arenas()-1;
+
+  initializeThreadArenas();
 }
 
 
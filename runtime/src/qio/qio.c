@@ -3079,11 +3079,13 @@ qioerr _qio_channel_flush_qio_unlocked(qio_channel_t* ch)
   }
 
   // If there was an error saved earlier, report it now.
-  // We don't report EILSEQ, EEOF, or EFORMAT on a flush.
+  // We don't report EILSEQ, EEOF, EFORMAT, or ERANGE (a number read
+  // out of range) on a flush.
   saved_err = qio_channel_error(ch);
   errcode = qio_err_to_int(saved_err);
   if( !err &&
-      !(errcode == EILSEQ || errcode == EEOF || errcode == EFORMAT) ) {
+      !(errcode == EILSEQ || errcode == EEOF || errcode == EFORMAT ||
+        errcode == ERANGE) ) {
     err = saved_err;
   }
   return err;
@@ -2659,6 +2659,150 @@ error:
 }
 
 
+// "00" "01" ... "99"; used to convert decimal numbers two digits at a time.
+static const char _qio_digit_pairs[201] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+
+// Converts the digits in [p, end) in the given base (2..36) into *num.
+// Unlike strtoull, this does not depend on the locale, does not need
+// a terminating '\0', and does not accept whitespace, signs or prefixes
+// (those were already consumed by _peek_number_unlocked).
+// Returns a pointer to the first character that is not a digit.
+// Sets *overflow to 1 if the value does not fit in 64 bits.
+static inline
+const char* _qio_parse_uint(const char* p, const char* end, int base,
+                            uint64_t* num, int* overflow)
+{
+  uint64_t n = 0;
+  uint64_t cutoff = UINT64_MAX / base;
+  unsigned cutlim = UINT64_MAX % base;
+  unsigned digit;
+
+  *overflow = 0;
+
+  if( base == 10 ) {
+    // 19 decimal digits always fit in 64 bits, so the common case
+    // needs no overflow checks at all.
+    const char* fast_end = (end - p > 19) ? p + 19 : end;
+    while( p < fast_end && (digit = (unsigned char) *p - '0') < 10 ) {
+      n = n * 10 + digit;
+      p++;
+    }
+  }
+
+  for( ; p < end; p++ ) {
+    unsigned char c = *p;
+    if( '0' <= c && c <= '9' ) digit = c - '0';
+    else if( 'a' <= c && c <= 'z' ) digit = c - 'a' + 10;
+    else if( 'A' <= c && c <= 'Z' ) digit = c - 'A' + 10;
+    else break;
+    if( digit >= (unsigned) base ) break;
+    if( n > cutoff || (n == cutoff && digit > cutlim) ) *overflow = 1;
+    n = n * base + digit;
+  }
+
+  *num = n;
+  return p;
+}
+
+// Exactly representable powers of 10.
+static const double _qio_exact_pow10[] = {
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// Tries to convert the decimal floating point number in [p, end) (which
+// starts with the digits, just after any sign) without calling strtod.
+// This only handles the cases where the result can be computed exactly
+// with one IEEE multiply or divide (Clinger's fast path): at most
+// 2^53 for the significant digits and a power of 10 that is itself
+// exact. Those cover the vast majority of numbers seen in practice.
+// Returns true and sets *out on success; returns false if the caller
+// needs to fall back to the general (strtod) conversion.
+static
+bool _qio_decimal_to_double_fast(const char* p, const char* end,
+                                 const number_reading_state_t* st,
+                                 double* out)
+{
+  uint64_t mant = 0;
+  int ndigits = 0;
+  int64_t exp10 = 0;
+  int64_t e = 0;
+  int eneg = 0;
+  unsigned digit;
+  double d;
+
+  // integer part
+  for( ; p < end && (digit = (unsigned char) *p - '0') < 10; p++ ) {
+    if( mant == 0 && digit == 0 ) continue; // leading zero
+    if( ++ndigits > 19 ) return false;
+    mant = mant * 10 + digit;
+  }
+
+  // fractional part
+  if( p < end && tolower(*p) == st->point_char ) {
+    for( p++; p < end && (digit = (unsigned char) *p - '0') < 10; p++ ) {
+      exp10--;
+      if( mant == 0 && digit == 0 ) continue; // leading zero
+      if( ++ndigits > 19 ) return false;
+      mant = mant * 10 + digit;
+    }
+  }
+
+  // exponent
+  if( p < end && tolower(*p) == st->exponent_char ) {
+    p++;
+    if( p < end && tolower(*p) == st->negative_char ) {
+      eneg = 1;
+      p++;
+    } else if( p < end && tolower(*p) == st->positive_char ) {
+      p++;
+    }
+    for( ; p < end && (digit = (unsigned char) *p - '0') < 10; p++ ) {
+      if( e > 100000 ) return false;
+      e = e * 10 + digit;
+    }
+    exp10 += eneg ? -e : e;
+  }
+
+  if( mant == 0 ) {
+    d = 0.0;
+  } else {
+    if( mant > ((uint64_t) 1 << DBL_MANT_DIG) ) return false;
+
+    if( exp10 > 22 && exp10 <= 22 + 15 ) {
+      // Move some of the exponent into the mantissa if that
+      // keeps it exact, e.g. 1e30.
+      while( exp10 > 22 ) {
+        mant *= 10;
+        exp10--;
+        if( mant > ((uint64_t) 1 << DBL_MANT_DIG) ) return false;
+      }
+    }
+
+    d = (double) mant;
+    if( 0 <= exp10 && exp10 <= 22 ) {
+      d *= _qio_exact_pow10[exp10];
+    } else if( -22 <= exp10 && exp10 < 0 ) {
+      d /= _qio_exact_pow10[-exp10];
+    } else {
+      return false;
+    }
+  }
+
+  *out = (st->sign < 0) ? -d : d;
+  return true;
+}
+
 qioerr qio_channel_scan_int(const int threadsafe, qio_channel_t* restrict ch, void* restrict out, size_t len, int issigned)
 {
   unsigned long long int num = 0;
@@ -2668,7 +2812,9 @@ qioerr qio_channel_scan_int(const int threadsafe, qio_channel_t* restrict ch, vo
   number_reading_state_t st;
   int64_t amount;
   int64_t start;
-  char* end;
+  const char* digits;
+  const char* end;
+  int overflow = 0;
   char* buf = NULL;
   char buf_onstack[MAX_ON_STACK];
   qioerr err;
@@ -2701,19 +2847,27 @@ qioerr qio_channel_scan_int(const int threadsafe, qio_channel_t* restrict ch, vo
   if( qio_err_to_int(err) == EEOF && st.end > 0 ) err = 0; // we tolerate EOF if there's data.
   if( err ) goto error;
 
-  MAYBE_STACK_ALLOC(char, amount + 1, buf, buf_onstack);
-  if( ! buf ) {
-    err = QIO_ENOMEM;
-    goto error;
-  }
-  buf[amount] = '\0';
-
   start = qio_channel_offset_unlocked(ch);
 
-  err = qio_channel_read_amt(false, ch, buf, amount);
-  if( err ) goto error;
+  if( qio_space_in_ptr_diff(amount, ch->cached_end, ch->cached_cur) ) {
+    // The whole number is in the buffer; convert it in place.
+    digits = (const char*) ch->cached_cur;
+    ch->cached_cur = qio_ptr_add(ch->cached_cur, amount);
+  } else {
+    MAYBE_STACK_ALLOC(char, amount + 1, buf, buf_onstack);
+    if( ! buf ) {
+      err = QIO_ENOMEM;
+      goto error;
+    }
+    buf[amount] = '\0';
+
+    err = qio_channel_read_amt(false, ch, buf, amount);
+    if( err ) goto error;
+
+    digits = buf;
+  }
 
-  // Now we have the number we're converting in buf.
+  // Now we have the number we're converting in digits[0..amount).
 
   // Read a sign, if necessary.
   sign = 1; // positive!
@@ -2725,18 +2879,22 @@ qioerr qio_channel_scan_int(const int threadsafe, qio_channel_t* restrict ch, vo
   //printf("Scanning int %s in base %i\n", buf, st.gotbase);
 
   // Now read the number.
-  num = strtoull( buf + st.digits_start - start, &end, st.gotbase );
-  if( num == ULLONG_MAX ) {
-    // overflow.
-    err = qio_mkerror_errno();
+  {
+    uint64_t u;
+    end = _qio_parse_uint(digits + st.digits_start - start, digits + amount,
+                          st.gotbase, &u, &overflow);
+    num = u;
+  }
+  if( overflow ) {
+    err = qio_int_to_err(ERANGE);
     goto error;
   }
   if( st.allow_point ) {
     // pass . or .00000
-    if( *end == '.' ) end++;
-    while( *end == '0' ) end++;
+    if( end < digits + amount && *end == '.' ) end++;
+    while( end < digits + amount && *end == '0' ) end++;
   }
-  if( end - buf != st.end - start ) {
+  if( end - digits != st.end - start ) {
     // some kind of format error.
     if( st.allow_point ) {
       QIO_GET_CONSTANT_ERROR(err, ERANGE, "malformed integer with fraction");
@@ -2874,6 +3032,21 @@ qioerr qio_channel_scan_float_or_imag(const int threadsafe, qio_channel_t* restr
   }
   //printf("got amount %lli\n", (long long int) amount);
 
+  start = qio_channel_offset_unlocked(ch);
+
+  // Most decimal numbers can be converted exactly, directly out of
+  // the channel buffer, without copying them and calling strtod.
+  if( st.gotbase == 10 && !st.is_nan && !st.is_inf &&
+      qio_space_in_ptr_diff(amount, ch->cached_end, ch->cached_cur) ) {
+    const char* tok = (const char*) ch->cached_cur;
+    if( _qio_decimal_to_double_fast(tok + st.digits_start - start,
+                                    tok + amount, &st, &num) ) {
+      ch->cached_cur = qio_ptr_add(ch->cached_cur, amount);
+      err = 0;
+      goto error;
+    }
+  }
+
   MAYBE_STACK_ALLOC(char, amount + 4, buf, buf_onstack);
   if( ! buf ) {
     err = QIO_ENOMEM;
@@ -2884,8 +3057,6 @@ qioerr qio_channel_scan_float_or_imag(const int threadsafe, qio_channel_t* restr
   buf[2] = ' ';
   buf[amount+3] = '\0';
 
-  start = qio_channel_offset_unlocked(ch);
-
   err = qio_channel_read_amt(false, ch, buf + 3, amount);
   if( err ) goto error;
 
@@ -3010,6 +3181,28 @@ static inline int _ltoa_convert(char *tmp, int tmplen, uint64_t num, int base, i
   int digit;
   char ch;
   tmp[tmplen-1] = '\0';
+  if( base == 10 ) {
+    // Emit two digits per division to halve the number of
+    // (slow) 64-bit divides in the common decimal case.
+    at = tmplen-1;
+    while( num >= 100 && at >= 2 ) {
+      int pair = (num % 100) * 2;
+      num /= 100;
+      tmp[--at] = _qio_digit_pairs[pair + 1];
+      tmp[--at] = _qio_digit_pairs[pair];
+    }
+    if( num >= 10 && at >= 2 ) {
+      int pair = num * 2;
+      tmp[--at] = _qio_digit_pairs[pair + 1];
+      tmp[--at] = _qio_digit_pairs[pair];
+      return at;
+    }
+    if( at >= 1 && num < 10 ) {
+      tmp[--at] = '0' + num;
+      return at;
+    }
+    return -1;
+  }
   for( at = tmplen-2; at >= 0; at-- ) {
     // Get the remainder mod base
     digit = num % base;
@@ -3212,6 +3405,50 @@ int _ftoa_core(char* buf, size_t buf_sz, double num,
 
   *skip = 0;
 
+  // Fast path: integral values that %g would print without an exponent,
+  // or that %f would print exactly, don't need snprintf (whose
+  // format string interpretation and locale handling dominate the
+  // cost of printing e.g. loop counters stored in reals).
+  if( base == 10 && (realfmt == 0 || realfmt == 1) &&
+      num >= 0.0 && num < 9007199254740992.0 /* 2^53 */ &&
+      num == (double) (uint64_t) num ) {
+    char tmp[24];
+    int tmp_skip;
+    int ndigits;
+    int nzeros = 0;
+    int maxdigits;
+
+    tmp_skip = _ltoa_convert(tmp, sizeof(tmp), (uint64_t) num, 10, 0);
+    ndigits = sizeof(tmp) - 1 - tmp_skip;
+
+    if( realfmt == 0 ) {
+      // %g uses the exponent form once there are more digits
+      // than the precision; above, precision < 0 also prints
+      // 100000-999999 in exponent form.
+      maxdigits = (precision < 0) ? 5 : (precision == 0) ? 1 : precision;
+    } else {
+      // %f prints all the digits, then . and precision zeros.
+      maxdigits = ndigits;
+      nzeros = (precision < 0) ? 6 : precision;
+    }
+
+    if( tmp_skip >= 0 && ndigits <= maxdigits ) {
+      got = ndigits + ((nzeros > 0) ? 1 + nzeros : 0);
+      if( got < buf_sz ) {
+        int i;
+        memcpy(buf, &tmp[tmp_skip], ndigits);
+        if( nzeros > 0 ) {
+          buf[ndigits] = '.';
+          for( i = 0; i < nzeros; i++ ) buf[ndigits + 1 + i] = '0';
+        }
+        buf[got] = '\0';
+      } else if( buf_sz > 0 ) {
+        buf[0] = '\0';
+      }
+      return got;
+    }
+  }
+
   if( base == 16 ) {
     if( precision < 0 ) {
       if( uppercase ) {
@@ -26,6 +26,7 @@
 #include "chpl_rt_utils_static.h"
 #include "chplcgfns.h"
 #include "chpl-arg-bundle.h"
+#include "chpl-atomics.h"
 #include "chpl-comm.h"
 #include "chplexit.h"
 #include "chpl-locale-model.h"
@@ -49,7 +50,19 @@
 
 
 //
-// task pool: linked list of tasks
+// Tasks waiting to run are held in per-thread work-stealing deques.
+// Each thread that runs tasks owns a Chase-Lev deque: it pushes the
+// tasks it creates onto the bottom and pops from the bottom when it
+// needs more work, while idle threads steal from the top of other
+// threads' deques.  Tasks created by threads without a deque (e.g.,
+// the comm thread), and tasks that don't fit in a full deque, go to
+// the global task pool, which is protected by threading_lock.
+//
+// A task in a cobegin/coforall/sync task list can also be run by the
+// task that owns the list (see chpl_task_executeTasksInList()), so it
+// may be found in two places.  Whoever sets 'claimed' first runs it,
+// and the last of its holders (the deque or pool, and the list) to let
+// go of it frees it.
 //
 typedef struct task_pool_struct* task_pool_p;
 
@@ -58,11 +71,11 @@ typedef struct {
 } chpl_task_prvDataImpl_t;
 
 typedef struct task_pool_struct {
-  task_pool_p*     p_list_head;  // task list we're on, if any
-  task_pool_p      list_next;    // double-link pointers for list
-  task_pool_p      list_prev;
-  task_pool_p      next;         // double-link pointers for pool
-  task_pool_p      prev;
+  task_pool_p      list_next;    // next task on our task list, if any
+  task_pool_p      next;         // next task in the global pool
+
+  atomic_bool      claimed;      // has some thread started this task?
+  atomic_int_least32_t holders;  // references from deque/pool and list
 
   chpl_task_prvDataImpl_t chpl_data;
 
@@ -80,10 +93,29 @@ typedef struct lockReport {
 } lockReport_t;
 
 
+//
+// Work-stealing deque (Chase and Lev, "Dynamic Circular Work-Stealing
+// Deque", SPAA 2005, with the C11 memory orders from Le et al., "Correct
+// and Efficient Work-Stealing for Weak Memory Models", PPoPP 2013).
+// The array has a fixed size; the owner spills to the global pool when
+// it is full.
+//
+#define WS_DEQUE_SIZE 1024  // must be a power of 2
+#define WS_MAX_DEQUES 1024  // threads beyond this use the global pool
+
+typedef struct {
+  atomic_int_least64_t top;     // thieves take from here
+  atomic_int_least64_t bottom;  // the owner pushes and pops here
+  atomic_uintptr_t     tasks[WS_DEQUE_SIZE];
+} ws_deque_t;
+
+
 // This is the data that is private to each thread.
 typedef struct {
   task_pool_p   ptask;
   lockReport_t* lockRprt;
+  ws_deque_t*   deque;         // NULL if this thread has no deque
+  uint32_t      steal_seed;    // for choosing steal victims
 } thread_private_data_t;
 
 
@@ -98,12 +130,19 @@ static volatile task_pool_p
 static volatile task_pool_p
                            task_pool_tail;     // tail of task pool
 
-static int                 queued_task_cnt;    // number of tasks in task pool
+static ws_deque_t*         ws_deques[WS_MAX_DEQUES]; // per-thread deques
+static atomic_int_least32_t
+                           ws_num_deques;      // number of deques in use
+
+static atomic_int_least32_t
+                           queued_task_cnt;    // number of tasks waiting
+                                               //   to be started
 static int64_t             extra_task_cnt;     // number of tasks being run by
                                                //   threads occupied already
 static int                 blocked_thread_cnt; // number of threads that
                                                //   cannot make progress
-static int                 idle_thread_cnt;    // number of threads looking
+static atomic_int_least32_t
+                           idle_thread_cnt;    // number of threads looking
                                                //   for work
 static uint64_t            progress_cnt;       // number of unblock operations,
                                                //   as a proxy for progress
@@ -120,8 +159,17 @@ static chpl_fn_p comm_task_fn;
 //
 // Internal functions.
 //
-static void                    enqueue_task(task_pool_p, task_pool_p*);
-static void                    dequeue_task(task_pool_p);
+static void                    enqueue_task(task_pool_p);
+static task_pool_p             dequeue_task(void);
+static void                    ws_deque_create(thread_private_data_t*);
+static chpl_bool               ws_push(ws_deque_t*, task_pool_p);
+static task_pool_p             ws_pop(ws_deque_t*);
+static task_pool_p             ws_steal(ws_deque_t*);
+static void                    ws_trim(ws_deque_t*);
+static chpl_bool               claim_task(task_pool_p);
+static void                    release_task(task_pool_p);
+static task_pool_p             take_task(thread_private_data_t*);
+static chpl_bool               tasks_available(void);
 static void                    comm_task_wrapper(void*);
 static void                    taskCallBody(chpl_fn_int_t, chpl_fn_p,
                                             void*, size_t,
@@ -343,11 +391,12 @@ void chpl_task_init(void) {
   chpl_thread_mutexInit(&extra_task_lock);
   chpl_thread_mutexInit(&task_id_lock);
   chpl_thread_mutexInit(&task_list_lock);
-  queued_task_cnt = 0;
+  atomic_init_int_least32_t(&queued_task_cnt, 0);
   blocked_thread_cnt = 0;
-  idle_thread_cnt = 0;
+  atomic_init_int_least32_t(&idle_thread_cnt, 0);
   extra_task_cnt = 0;
   task_pool_head = task_pool_tail = NULL;
+  atomic_init_int_least32_t(&ws_num_deques, 0);
 
   chpl_thread_init(thread_begin, thread_end);
 
@@ -377,10 +426,17 @@ void chpl_task_init(void) {
 
 
 void chpl_task_exit(void) {
+  int32_t i;
+
   if (!initialized)
     return;
 
   chpl_thread_exit();
+
+  // All the threads are gone now, so nobody can be stealing.
+  for (i = 0; i < atomic_load_int_least32_t(&ws_num_deques); i++)
+    chpl_mem_free(ws_deques[i], 0, 0);
+  atomic_store_int_least32_t(&ws_num_deques, 0);
 }
 
 
@@ -391,6 +447,9 @@ static void* do_callMain(void* arg) {
   // make sure this thread has thread-private data.
   setup_main_thread_private_data();
 
+  // The main task's children go on its deque, for other threads to steal.
+  ws_deque_create(get_thread_private_data());
+
   // make sure that the lock report is set up.
   if (blockreport)
     initializeLockReportForThread();
@@ -534,71 +593,257 @@ static void comm_task_wrapper(void* arg) {
 
 
 //
-// Enqueue and dequeue tasks from the pool.
+// Enqueue and dequeue tasks from the global pool.
+// These assume threading_lock has already been acquired.
 //
 static inline
-void enqueue_task(task_pool_p ptask, task_pool_p* p_task_list_head) {
-  queued_task_cnt++;
-
-  //
-  // Add to pool.
-  //
+void enqueue_task(task_pool_p ptask) {
+  ptask->next = NULL;
   if (task_pool_tail)
     task_pool_tail->next = ptask;
   else
     task_pool_head = ptask;
-  ptask->prev = task_pool_tail;
   task_pool_tail = ptask;
+}
 
-  //
-  // Add to list, if any.
-  //
-  if (p_task_list_head == NULL) {
-    ptask->p_list_head = NULL;
+
+static inline
+task_pool_p dequeue_task(void) {
+  task_pool_p ptask = task_pool_head;
+
+  if (ptask != NULL) {
+    if ((task_pool_head = ptask->next) == NULL)
+      task_pool_tail = NULL;
   }
-  else {
-    ptask->p_list_head = p_task_list_head;
-    ptask->list_next = *p_task_list_head;
-    if (*p_task_list_head != NULL)
-      (*p_task_list_head)->list_prev = ptask;
-    ptask->list_prev = NULL;
-    *p_task_list_head = ptask;
+  return ptask;
+}
+
+
+//
+// Work-stealing deque operations.
+//
+
+//
+// Give this thread a deque, if there is room for one.  Deques are
+// never freed while the program is running, so thieves can look at
+// any of the first ws_num_deques of them at any time.
+//
+static void ws_deque_create(thread_private_data_t* tp) {
+  ws_deque_t* dq;
+  int32_t n;
+  int i;
+
+  // begin critical section
+  chpl_thread_mutexLock(&threading_lock);
+
+  n = atomic_load_int_least32_t(&ws_num_deques);
+  if (n < WS_MAX_DEQUES) {
+    dq = (ws_deque_t*) chpl_mem_alloc(sizeof(ws_deque_t),
+                                      CHPL_RT_MD_THREAD_PRV_DATA, 0, 0);
+    atomic_init_int_least64_t(&dq->top, 0);
+    atomic_init_int_least64_t(&dq->bottom, 0);
+    for (i = 0; i < WS_DEQUE_SIZE; i++)
+      atomic_init_uintptr_t(&dq->tasks[i], 0);
+
+    ws_deques[n] = dq;
+    atomic_store_explicit_int_least32_t(&ws_num_deques, n + 1,
+                                        memory_order_release);
+    tp->deque = dq;
   }
+  tp->steal_seed = (uint32_t) n + 1;
+
+  // end critical section
+  chpl_thread_mutexUnlock(&threading_lock);
 }
 
 
+//
+// Push a task on the bottom of the deque.  Only the owner may call
+// this.  Returns false if the deque is full.
+//
 static inline
-void dequeue_task(task_pool_p ptask) {
-  assert(queued_task_cnt > 0);
-  queued_task_cnt--;
+chpl_bool ws_push(ws_deque_t* dq, task_pool_p ptask) {
+  int64_t b = atomic_load_explicit_int_least64_t(&dq->bottom,
+                                                 memory_order_relaxed);
+  int64_t t = atomic_load_explicit_int_least64_t(&dq->top,
+                                                 memory_order_acquire);
+  if (b - t >= WS_DEQUE_SIZE)
+    return false;
 
-  //
-  // Remove from pool.
-  //
-  if (ptask == task_pool_head) {
-    if ((task_pool_head = task_pool_head->next) == NULL)
-      task_pool_tail = NULL;
-    else
-      task_pool_head->prev = NULL;
+  atomic_store_explicit_uintptr_t(&dq->tasks[b & (WS_DEQUE_SIZE - 1)],
+                                  (uintptr_t) ptask, memory_order_relaxed);
+  chpl_atomic_thread_fence(memory_order_release);
+  atomic_store_explicit_int_least64_t(&dq->bottom, b + 1,
+                                      memory_order_relaxed);
+  return true;
+}
+
+
+//
+// Pop a task from the bottom of the deque.  Only the owner may call
+// this.  Returns NULL if the deque is empty.
+//
+static inline
+task_pool_p ws_pop(ws_deque_t* dq) {
+  int64_t b = atomic_load_explicit_int_least64_t(&dq->bottom,
+                                                 memory_order_relaxed) - 1;
+  int64_t t;
+  task_pool_p ptask = NULL;
+
+  atomic_store_explicit_int_least64_t(&dq->bottom, b, memory_order_relaxed);
+  chpl_atomic_thread_fence(memory_order_seq_cst);
+  t = atomic_load_explicit_int_least64_t(&dq->top, memory_order_relaxed);
+
+  if (t <= b) {
+    ptask = (task_pool_p)
+            atomic_load_explicit_uintptr_t(&dq->tasks[b & (WS_DEQUE_SIZE - 1)],
+                                           memory_order_relaxed);
+    if (t == b) {
+      // Last task: race any thieves for it.
+      if (!atomic_compare_exchange_strong_explicit_int_least64_t(
+             &dq->top, &t, t + 1,
+             memory_order_seq_cst, memory_order_relaxed))
+        ptask = NULL;
+      atomic_store_explicit_int_least64_t(&dq->bottom, b + 1,
+                                          memory_order_relaxed);
+    }
   }
   else {
-    if ((ptask->prev->next = ptask->next) == NULL)
-      task_pool_tail = ptask->prev;
-    else
-      ptask->next->prev = ptask->prev;
+    atomic_store_explicit_int_least64_t(&dq->bottom, b + 1,
+                                        memory_order_relaxed);
   }
+  return ptask;
+}
 
-  //
-  // Remove from list, if on one.
-  //
-  if (ptask->p_list_head != NULL) {
-    if (ptask == *(ptask->p_list_head))
-      *(ptask->p_list_head) = ptask->list_next;
-    else
-      ptask->list_prev->list_next = ptask->list_next;
-    if (ptask->list_next != NULL)
-      ptask->list_next->list_prev = ptask->list_prev;
+
+//
+// Steal a task from the top of someone else's deque.  Returns NULL if
+// the deque is empty or another thread got there first.
+//
+static inline
+task_pool_p ws_steal(ws_deque_t* dq) {
+  int64_t t = atomic_load_explicit_int_least64_t(&dq->top,
+                                                 memory_order_acquire);
+  int64_t b;
+  task_pool_p ptask;
+
+  chpl_atomic_thread_fence(memory_order_seq_cst);
+  b = atomic_load_explicit_int_least64_t(&dq->bottom, memory_order_acquire);
+  if (t >= b)
+    return NULL;
+
+  ptask = (task_pool_p)
+          atomic_load_explicit_uintptr_t(&dq->tasks[t & (WS_DEQUE_SIZE - 1)],
+                                         memory_order_relaxed);
+  if (!atomic_compare_exchange_strong_explicit_int_least64_t(
+         &dq->top, &t, t + 1, memory_order_seq_cst, memory_order_relaxed))
+    return NULL;
+  return ptask;
+}
+
+
+//
+// Try to become the thread that runs this task.
+//
+static inline
+chpl_bool claim_task(task_pool_p ptask) {
+  if (atomic_exchange_bool(&ptask->claimed, true))
+    return false;
+  (void) atomic_fetch_sub_int_least32_t(&queued_task_cnt, 1);
+  return true;
+}
+
+
+//
+// Drop one reference to a task, freeing it if that was the last one.
+//
+static inline
+void release_task(task_pool_p ptask) {
+  if (atomic_fetch_sub_int_least32_t(&ptask->holders, 1) == 1) {
+    atomic_destroy_bool(&ptask->claimed);
+    atomic_destroy_int_least32_t(&ptask->holders);
+    chpl_mem_free(ptask, 0, 0);
+  }
+}
+
+
+//
+// Drop tasks from the bottom of our deque that have already been run
+// from a task list.  Nobody else would otherwise remove them until
+// there was other work to look for.
+//
+static void ws_trim(ws_deque_t* dq) {
+  task_pool_p ptask;
+
+  while ((ptask = ws_pop(dq)) != NULL) {
+    if (!atomic_load_bool(&ptask->claimed)) {
+      (void) ws_push(dq, ptask);
+      return;
+    }
+    release_task(ptask);
+  }
+}
+
+
+static inline
+chpl_bool tasks_available(void) {
+  return atomic_load_explicit_int_least32_t(&queued_task_cnt,
+                                            memory_order_relaxed) > 0;
+}
+
+
+//
+// Find and claim a task to run: first from our own deque, then from the
+// global pool, then by stealing from a randomly chosen deque (trying
+// each one in turn).  Returns NULL if we didn't find one.
+//
+static task_pool_p take_task(thread_private_data_t* tp) {
+  task_pool_p ptask;
+  int32_t n, i, victim;
+
+  if (tp->deque != NULL) {
+    while ((ptask = ws_pop(tp->deque)) != NULL) {
+      if (claim_task(ptask))
+        return ptask;
+      release_task(ptask);
+    }
   }
+
+  if (task_pool_head != NULL) {
+    while (true) {
+      // begin critical section
+      chpl_thread_mutexLock(&threading_lock);
+      ptask = dequeue_task();
+      // end critical section
+      chpl_thread_mutexUnlock(&threading_lock);
+
+      if (ptask == NULL)
+        break;
+      if (claim_task(ptask))
+        return ptask;
+      release_task(ptask);
+    }
+  }
+
+  n = atomic_load_explicit_int_least32_t(&ws_num_deques, memory_order_acquire);
+  if (n > 0) {
+    // xorshift32
+    tp->steal_seed ^= tp->steal_seed << 13;
+    tp->steal_seed ^= tp->steal_seed >> 17;
+    tp->steal_seed ^= tp->steal_seed << 5;
+    victim = tp->steal_seed % n;
+    for (i = 0; i < n; i++, victim = (victim + 1) % n) {
+      if (ws_deques[victim] == tp->deque)
+        continue;
+      while ((ptask = ws_steal(ws_deques[victim])) != NULL) {
+        if (claim_task(ptask))
+          return ptask;
+        release_task(ptask);
+      }
+    }
+  }
+
+  return NULL;
 }
 
 
@@ -614,9 +859,6 @@ void chpl_task_addToTaskList(chpl_fn_int_t fid,
 
   arg->kind = CHPL_ARG_BUNDLE_KIND_TASK;
 
-  // begin critical section
-  chpl_thread_mutexLock(&threading_lock);
-
   if (task_list_locale == chpl_nodeID) {
     (void) add_to_task_pool(fid, chpl_ftable[fid], arg, arg_size,
                             false, (task_pool_p*) p_task_list_void,
@@ -633,9 +875,43 @@ void chpl_task_addToTaskList(chpl_fn_int_t fid,
     (void) add_to_task_pool(fid, chpl_ftable[fid], arg, arg_size,
                             false, NULL, true, 0, CHPL_FILE_IDX_UNKNOWN);
   }
+}
+
+
+//
+// Tasks are pushed onto the head of a task list, and the owner takes
+// the whole list at once.  The list head is a plain pointer in the
+// module code, so these are protected by task_list_lock.  The critical
+// sections are only a few instructions long, and the owner takes the
+// lock once per list rather than once per task.
+//
+static inline
+void task_list_push(task_pool_p* p_task_list_head, task_pool_p ptask) {
+  // begin critical section
+  chpl_thread_mutexLock(&task_list_lock);
+
+  ptask->list_next = *p_task_list_head;
+  *p_task_list_head = ptask;
 
   // end critical section
-  chpl_thread_mutexUnlock(&threading_lock);
+  chpl_thread_mutexUnlock(&task_list_lock);
+}
+
+
+static inline
+task_pool_p task_list_take(task_pool_p* p_task_list_head) {
+  task_pool_p head;
+
+  // begin critical section
+  chpl_thread_mutexLock(&task_list_lock);
+
+  head = *p_task_list_head;
+  *p_task_list_head = NULL;
+
+  // end critical section
+  chpl_thread_mutexUnlock(&task_list_lock);
+
+  return head;
 }
 
 
@@ -643,28 +919,28 @@ void chpl_task_executeTasksInList(void** p_task_list_void) {
   task_pool_p* p_task_list_head = (task_pool_p*) p_task_list_void;
   task_pool_p curr_ptask;
   task_pool_p child_ptask;
+  task_pool_p next_ptask;
 
   // Note: this function needs to tolerate an empty task
   // list. That will happen for coforalls inside a serial block, say.
 
   curr_ptask = get_current_ptask(true /*must_be_task*/);
 
-  while (*p_task_list_head != NULL) {
-    chpl_fn_p task_to_run_fun = NULL;
+  next_ptask = NULL;
+  while (next_ptask != NULL ||
+         (next_ptask = task_list_take(p_task_list_head)) != NULL) {
+    chpl_fn_p task_to_run_fun;
 
-    // begin critical section
-    chpl_thread_mutexLock(&threading_lock);
+    child_ptask = next_ptask;
+    next_ptask = child_ptask->list_next;
 
-    if ((child_ptask = *p_task_list_head) != NULL) {
-      task_to_run_fun = child_ptask->taskBundle->requested_fn;
-      dequeue_task(child_ptask);
+    // If another thread already started this task, we're done with it.
+    if (!claim_task(child_ptask)) {
+      release_task(child_ptask);
+      continue;
     }
 
-    // end critical section
-    chpl_thread_mutexUnlock(&threading_lock);
-
-    if (task_to_run_fun == NULL)
-      continue;
+    task_to_run_fun = child_ptask->taskBundle->requested_fn;
 
     set_current_ptask(child_ptask);
 
@@ -718,8 +994,14 @@ void chpl_task_executeTasksInList(void** p_task_list_void) {
     chpl_thread_mutexUnlock(&extra_task_lock);
 
     set_current_ptask(curr_ptask);
-    chpl_mem_free(child_ptask, 0, 0);
+    release_task(child_ptask);
+
+  }
 
+  {
+    thread_private_data_t* tp = get_thread_private_data();
+    if (tp->deque != NULL)
+      ws_trim(tp->deque);
   }
 }
 
@@ -737,14 +1019,8 @@ void taskCallBody(chpl_fn_int_t fid, chpl_fn_p fp,
                   void* arg, size_t arg_size,
                   c_sublocid_t subloc,
                   int lineno, int32_t filename) {
-  // begin critical section
-  chpl_thread_mutexLock(&threading_lock);
-
   (void) add_to_task_pool(fid, fp, arg, arg_size, true,
                           NULL, false, lineno, filename);
-
-  // end critical section
-  chpl_thread_mutexUnlock(&threading_lock);
 }
 
 
@@ -864,7 +1140,7 @@ chpl_bool chpl_task_guardPagesInUse(void) {
 }
 
 uint32_t chpl_task_getNumQueuedTasks(void) {
-  return queued_task_cnt;
+  return atomic_load_int_least32_t(&queued_task_cnt);
 }
 
 int32_t chpl_task_getNumBlockedTasks(void) {
@@ -872,14 +1148,13 @@ int32_t chpl_task_getNumBlockedTasks(void) {
     int numBlockedTasks;
 
     // begin critical section
-    chpl_thread_mutexLock(&threading_lock);
     chpl_thread_mutexLock(&block_report_lock);
 
-    numBlockedTasks = blocked_thread_cnt - idle_thread_cnt;
+    numBlockedTasks = blocked_thread_cnt
+                      - atomic_load_int_least32_t(&idle_thread_cnt);
 
     // end critical section
     chpl_thread_mutexUnlock(&block_report_lock);
-    chpl_thread_mutexUnlock(&threading_lock);
 
     assert(numBlockedTasks >= 0);
     return numBlockedTasks;
@@ -977,8 +1252,16 @@ static void report_locked_threads(void) {
 // This signal handler prints an overall task report, containing
 // pending tasks and those that are running.
 //
+static void report_pending_task(task_pool_p pendingTask) {
+  if (!atomic_load_bool(&pendingTask->claimed))
+    printf("- %s:%d\n", chpl_lookupFilename(pendingTask->taskBundle->filename),
+           pendingTask->taskBundle->lineno);
+}
+
 static void report_all_tasks(void) {
   task_pool_p pendingTask = task_pool_head;
+  int32_t i;
+  int64_t j;
 
   printf("Task report\n");
   printf("--------------------------------\n");
@@ -986,10 +1269,19 @@ static void report_all_tasks(void) {
   // print out pending tasks
   printf("Pending tasks:\n");
   while (pendingTask != NULL) {
-    printf("- %s:%d\n", chpl_lookupFilename(pendingTask->taskBundle->filename),
-           pendingTask->taskBundle->lineno);
+    report_pending_task(pendingTask);
     pendingTask = pendingTask->next;
   }
+  for (i = 0; i < atomic_load_int_least32_t(&ws_num_deques); i++) {
+    ws_deque_t* dq = ws_deques[i];
+    for (j = atomic_load_int_least64_t(&dq->top);
+         j < atomic_load_int_least64_t(&dq->bottom);
+         j++) {
+      report_pending_task((task_pool_p)
+                          atomic_load_uintptr_t(&dq->tasks[j & (WS_DEQUE_SIZE
+                                                                - 1)]));
+    }
+  }
   printf("\n");
 
   // print out running tasks
@@ -1151,9 +1443,12 @@ thread_begin(void* ptask_void) {
 
   tp->ptask = NULL;
   tp->lockRprt = NULL;
+  tp->deque = NULL;
   if (blockreport)
     initializeLockReportForThread();
 
+  ws_deque_create(tp);
+
   while (true) {
     //
     // wait for a task to be present in the task pool
@@ -1169,7 +1464,7 @@ thread_begin(void* ptask_void) {
     // that were waiting on the signal, but since there was a performance
     // impact from keeping it as a hybrid as opposed to merely yielding,
     // it was decided that we would return to the simple yield case.
-    while (!task_pool_head) {
+    while (!tasks_available()) {
       if (set_block_loc(0, CHPL_FILE_IDX_IDLE_TASK)) {
         // all other tasks appear to be blocked
         struct timeval deadline, now;
@@ -1177,32 +1472,31 @@ thread_begin(void* ptask_void) {
         deadline.tv_sec += 1;
         do {
           chpl_thread_yield();
-          if (!task_pool_head)
+          if (!tasks_available())
             gettimeofday(&now, NULL);
-        } while (!task_pool_head
+        } while (!tasks_available()
                  && (now.tv_sec < deadline.tv_sec
                      || (now.tv_sec == deadline.tv_sec
                          && now.tv_usec < deadline.tv_usec)));
-        if (!task_pool_head) {
+        if (!tasks_available()) {
           check_for_deadlock();
         }
       }
       else {
         do {
           chpl_thread_yield();
-        } while (!task_pool_head);
+        } while (!tasks_available());
       }
 
       unset_block_loc();
     }
 
     //
-    // Just now the pool had at least one task in it.  Lock and see if
-    // there's something still there.
+    // Just now there was at least one task waiting to be started.
+    // See if we can get one.
     //
-    chpl_thread_mutexLock(&threading_lock);
-    if (!task_pool_head) {
-      chpl_thread_mutexUnlock(&threading_lock);
+    if ((ptask = take_task(tp)) == NULL) {
+      chpl_thread_yield();
       continue;
     }
 
@@ -1210,21 +1504,22 @@ thread_begin(void* ptask_void) {
     // We've found a task to run.
     //
 
-    if (blockreport)
+    if (blockreport) {
+      // begin critical section
+      chpl_thread_mutexLock(&threading_lock);
+
       progress_cnt++;
 
+      // end critical section
+      chpl_thread_mutexUnlock(&threading_lock);
+    }
+
     //
-    // start new task; remove task from pool also add to task to task-table
-    // (structure in ChapelRuntime that keeps track of currently running tasks
-    // for task-reports on deadlock or Ctrl+C).
+    // start new task; also add to task to task-table (structure in
+    // ChapelRuntime that keeps track of currently running tasks for
+    // task-reports on deadlock or Ctrl+C).
     //
-    ptask = task_pool_head;
-    idle_thread_cnt--;
-
-    dequeue_task(ptask);
-
-    // end critical section
-    chpl_thread_mutexUnlock(&threading_lock);
+    (void) atomic_fetch_sub_int_least32_t(&idle_thread_cnt, 1);
 
     tp->ptask = ptask;
 
@@ -1257,18 +1552,12 @@ thread_begin(void* ptask_void) {
     }
 
     tp->ptask = NULL;
-    chpl_mem_free(ptask, 0, 0);
-
-    // begin critical section
-    chpl_thread_mutexLock(&threading_lock);
+    release_task(ptask);
 
     //
     // finished task; increment idle count
     //
-    idle_thread_cnt++;
-
-    // end critical section
-    chpl_thread_mutexUnlock(&threading_lock);
+    (void) atomic_fetch_add_int_least32_t(&idle_thread_cnt, 1);
   }
 }
 
@@ -1294,13 +1583,14 @@ static void thread_end(void)
 
 //
 // Launch another thread, if it seems useful to do so and we can.
+// Assumes threading_lock has already been acquired.
 //
 static void maybe_add_thread(void) {
   static chpl_bool warning_issued = false;
 
   if (!warning_issued && chpl_thread_canCreate()) {
     if (chpl_thread_create(NULL) == 0) {
-      idle_thread_cnt++;
+      (void) atomic_fetch_add_int_least32_t(&idle_thread_cnt, 1);
     }
     else {
       int32_t max_threads = chpl_thread_getMaxThreads();
@@ -1324,8 +1614,8 @@ static void maybe_add_thread(void) {
 
 
 // create a task from the given function pointer and arguments
-// and append it to the end of the task pool
-// assumes threading_lock has already been acquired!
+// and push it on this thread's deque (or, failing that, append it
+// to the end of the global task pool)
 static inline
 task_pool_p add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
                              void* a, size_t a_size,
@@ -1337,6 +1627,7 @@ task_pool_p add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
 
   task_pool_p ptask;
   chpl_task_prvDataImpl_t pv;
+  thread_private_data_t* tp;
 
   memset(&pv, 0, sizeof(pv));
 
@@ -1352,12 +1643,12 @@ task_pool_p add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
   memcpy(&ptask->bundle, a, a_size);
   ptask->taskBundle = chpl_argBundleTaskArgBundle(&ptask->bundle);
 
-  ptask->p_list_head            = NULL;
   ptask->list_next              = NULL;
-  ptask->list_prev              = NULL;
   ptask->next                   = NULL;
-  ptask->prev                   = NULL;
   ptask->chpl_data              = pv;
+  atomic_init_bool(&ptask->claimed, false);
+  atomic_init_int_least32_t(&ptask->holders,
+                            (p_task_list_head == NULL) ? 1 : 2);
 
   *ptask->taskBundle =
     (chpl_task_bundle_t)
@@ -1371,8 +1662,6 @@ task_pool_p add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
       .infoChapel      = ptask->taskBundle->infoChapel,// retain; set by caller
     };
 
-  enqueue_task(ptask, p_task_list_head);
-
   chpl_task_do_callbacks(chpl_task_cb_event_kind_create,
                          ptask->taskBundle->requested_fid,
                          ptask->taskBundle->filename,
@@ -1389,10 +1678,40 @@ task_pool_p add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
     chpl_thread_mutexUnlock(&taskTable_lock);
   }
 
+  //
+  // Now make it available to run.  Once it is on our deque or in the
+  // pool, another thread may start (and even finish) it at any time.
+  //
+  (void) atomic_fetch_add_int_least32_t(&queued_task_cnt, 1);
+
+  if (p_task_list_head != NULL)
+    task_list_push(p_task_list_head, ptask);
+
+  tp = (thread_private_data_t*) chpl_thread_getPrivateData();
+  if (tp == NULL || tp->deque == NULL || !ws_push(tp->deque, ptask)) {
+    // begin critical section
+    chpl_thread_mutexLock(&threading_lock);
+
+    enqueue_task(ptask);
+
+    // end critical section
+    chpl_thread_mutexUnlock(&threading_lock);
+  }
+
   // If we now have more tasks than threads to run them on, try to start
   // another thread
-  if (queued_task_cnt > idle_thread_cnt) {
-    maybe_add_thread();
+  if (atomic_load_int_least32_t(&queued_task_cnt)
+      > atomic_load_int_least32_t(&idle_thread_cnt)) {
+    // begin critical section
+    chpl_thread_mutexLock(&threading_lock);
+
+    if (atomic_load_int_least32_t(&queued_task_cnt)
+        > atomic_load_int_least32_t(&idle_thread_cnt)) {
+      maybe_add_thread();
+    }
+
+    // end critical section
+    chpl_thread_mutexUnlock(&threading_lock);
   }
 
   return ptask;
@@ -1406,5 +1725,5 @@ uint32_t chpl_task_getNumThreads(void) {
 }
 
 uint32_t chpl_task_getNumIdleThreads(void) {
-  return idle_thread_cnt;
+  return atomic_load_int_least32_t(&idle_thread_cnt);
 }
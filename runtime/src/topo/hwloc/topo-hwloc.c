@@ -24,6 +24,7 @@
 #include "chplrt.h"
 
 #include "chpl-align.h"
+#include "chpl-atomics.h"
 #include "chpl-env.h"
 #include "chpl-env-gen.h"
 #include "chplcgfns.h"
@@ -64,6 +65,15 @@ static int topoDepth;
 static int numaLevel;
 static int numNumaDomains;
 
+//
+// NUMA locality diagnostics state.  Sampling is bounded per call so
+// that diagnosing a big array costs about the same as a small one.
+//
+#define NUMA_DIAGS_MAX_SAMPLES 64
+static atomic_bool numaDiagsEnabled;
+static atomic_uint_least64_t numaDiagsLocal;
+static atomic_uint_least64_t numaDiagsRemote;
+
 
 static hwloc_obj_t getNumaObj(c_sublocid_t);
 static void alignAddrSize(void*, size_t, chpl_bool,
@@ -91,6 +101,10 @@ static void chk_err_errno_fn(const char*, int, const char*);
 
 
 void chpl_topo_init(void) {
+  atomic_init_bool(&numaDiagsEnabled, false);
+  atomic_init_uint_least64_t(&numaDiagsLocal, 0);
+  atomic_init_uint_least64_t(&numaDiagsRemote, 0);
+
   //
   // We only load hwloc topology information in configurations where
   // the locale model is other than "flat" or the tasking is based on
@@ -360,7 +374,10 @@ c_sublocid_t chpl_topo_getThreadLocality(void) {
 
   hwloc_cpuset_to_nodeset(topology, cpuset, nodeset);
 
-  node = hwloc_bitmap_first(nodeset);
+  // a thread that may run in more than one NUMA domain has no locality
+  node = (hwloc_bitmap_weight(nodeset) == 1)
+         ? hwloc_bitmap_first(nodeset)
+         : c_sublocid_any;
 
   hwloc_bitmap_free(nodeset);
   hwloc_bitmap_free(cpuset);
@@ -424,6 +441,13 @@ void chpl_topo_setMemSubchunkLocality(void* p, size_t size,
       pgNext = nPages;
     else
       pgNext = 1 + (nPages * (i + 1) - 1) / numNumaDomains;
+    if (pgNext == pg) {
+      // fewer pages than NUMA domains; nothing for this one
+      if (subchunkSizes != NULL) {
+        subchunkSizes[i] = 0;
+      }
+      continue;
+    }
     chpl_topo_setMemLocalityByPages(pPgLo + pg * pgSize,
                                     (pgNext - pg) * pgSize, getNumaObj(i));
     if (subchunkSizes != NULL) {
@@ -578,6 +602,103 @@ c_sublocid_t chpl_topo_getMemLocality(void* p) {
 }
 
 
+void chpl_topo_numaDiagsStart(void) {
+  atomic_store_bool(&numaDiagsEnabled, true);
+}
+
+
+void chpl_topo_numaDiagsStop(void) {
+  atomic_store_bool(&numaDiagsEnabled, false);
+}
+
+
+void chpl_topo_numaDiagsReset(void) {
+  atomic_store_uint_least64_t(&numaDiagsLocal, 0);
+  atomic_store_uint_least64_t(&numaDiagsRemote, 0);
+}
+
+
+chpl_bool chpl_topo_numaDiagsEnabled(void) {
+  return atomic_load_explicit_bool(&numaDiagsEnabled, memory_order_relaxed);
+}
+
+
+void chpl_topo_numaDiagsSample(void* p, size_t size, c_sublocid_t subloc) {
+  size_t pgSize;
+  unsigned char* pPgLo;
+  size_t nPages;
+  size_t nSamples;
+  size_t i;
+  hwloc_nodeset_t nodeset;
+  uint64_t nLocal = 0;
+  uint64_t nRemote = 0;
+
+  if (!chpl_topo_numaDiagsEnabled()
+      || !haveTopology
+      || !topoSupport->membind->get_area_memlocation
+      || p == NULL || size == 0) {
+    return;
+  }
+
+  if (!isActualSublocID(subloc)) {
+    subloc = chpl_topo_getThreadLocality();
+    if (!isActualSublocID(subloc)) {
+      return;
+    }
+  }
+
+  //
+  // Only sample pages wholly inside the range.  A page at either end may
+  // be shared with a neighboring chunk that belongs to another sublocale,
+  // so where it lives says nothing about this chunk's locality.
+  //
+  alignAddrSize(p, size, true, &pgSize, &pPgLo, &nPages);
+  if (nPages == 0) {
+    return;
+  }
+  nSamples = (nPages < NUMA_DIAGS_MAX_SAMPLES)
+             ? nPages : NUMA_DIAGS_MAX_SAMPLES;
+
+  CHK_ERR_ERRNO((nodeset = hwloc_bitmap_alloc()) != NULL);
+
+  for (i = 0; i < nSamples; i++) {
+    unsigned char* pg = pPgLo + (i * nPages / nSamples) * pgSize;
+    int node;
+
+    //
+    // Pages nobody has touched yet have no location; skip them rather
+    // than counting them either way.
+    //
+    if (hwloc_get_area_memlocation(topology, pg, 1, nodeset,
+                                   HWLOC_MEMBIND_BYNODESET) != 0
+        || (node = hwloc_bitmap_first(nodeset)) < 0) {
+      continue;
+    }
+
+    if (node == subloc) {
+      nLocal++;
+    } else {
+      nRemote++;
+    }
+  }
+
+  hwloc_bitmap_free(nodeset);
+
+  if (nLocal > 0) {
+    atomic_fetch_add_uint_least64_t(&numaDiagsLocal, nLocal);
+  }
+  if (nRemote > 0) {
+    atomic_fetch_add_uint_least64_t(&numaDiagsRemote, nRemote);
+  }
+}
+
+
+void chpl_topo_numaDiagsGet(uint64_t* p_local, uint64_t* p_remote) {
+  *p_local = atomic_load_uint_least64_t(&numaDiagsLocal);
+  *p_remote = atomic_load_uint_least64_t(&numaDiagsRemote);
+}
+
+
 static
 void chk_err_fn(const char* file, int lineno, const char* what) {
   chpl_internal_error_v("%s: %d: !(%s)", file, lineno, what);
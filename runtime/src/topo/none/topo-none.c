@@ -81,3 +81,26 @@ void chpl_topo_touchMemFromSubloc(void* p, size_t size, chpl_bool onlyInside,
 c_sublocid_t chpl_topo_getMemLocality(void* p) {
   return c_sublocid_any;
 }
+
+
+void chpl_topo_numaDiagsStart(void) { }
+
+
+void chpl_topo_numaDiagsStop(void) { }
+
+
+void chpl_topo_numaDiagsReset(void) { }
+
+
+chpl_bool chpl_topo_numaDiagsEnabled(void) {
+  return false;
+}
+
+
+void chpl_topo_numaDiagsSample(void* p, size_t size, c_sublocid_t subloc) { }
+
+
+void chpl_topo_numaDiagsGet(uint64_t* p_local, uint64_t* p_remote) {
+  *p_local = 0;
+  *p_remote = 0;
+}
@@ -0,0 +1,35 @@
+// Checks adding arrays of indices to associative domains, including
+// arrays large enough to be inserted and rehashed in parallel.
+config const n = 50000;
+
+proc check(type t, param parSafe: bool) {
+  var D: domain(t, parSafe=parSafe);
+  var A: [D] int;
+
+  D += [1:t, 2:t, 2:t];
+  A = 1;
+  writeln(D.sorted());
+
+  // overlaps the existing indices and contains duplicates
+  var inds = [i in 0..<2*n] (i % n):t;
+  var numAdded = D.bulkAdd(inds);
+  writeln(numAdded == n - 2, " ", D.size == n);
+  writeln(&& reduce [i in 0..<n] D.contains(i:t));
+  writeln(&& reduce [i in D] A[i] == (if i == 1:t || i == 2:t then 1 else 0));
+
+  // grows the table again while the array holds values
+  forall i in D do A[i] = i:int;
+  D += [i in n..<3*n] i:t;
+  writeln(D.size == 3*n);
+  writeln(&& reduce [i in D] A[i] == (if i:int < n then i:int else 0));
+
+  const E = {inds};
+  writeln(E.size == n, " ", && reduce [i in E] D.contains(i));
+
+  var empty: [1..0] t;
+  writeln(D.bulkAdd(empty));
+}
+
+check(int, true);
+check(int, false);
+check(string, true);
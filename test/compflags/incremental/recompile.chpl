@@ -0,0 +1,9 @@
+// Built incrementally (see recompile.precomp) after Helper changes, so
+// this checks that the rebuilt program uses the new Helper.
+// recompile.prediff then checks that only Helper's object was rebuilt.
+use Helper, Other;
+
+writeln("main");
+writeln(helperVersion());
+writeln(scale(21));
+writeln(otherValue());
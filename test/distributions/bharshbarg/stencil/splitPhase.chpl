@@ -0,0 +1,76 @@
+use StencilDist;
+use util;
+
+config const debug = false;
+
+proc test(dom : domain) {
+  param rank = dom.rank;
+
+  for i in 1..2 {
+    var halo : rank*int;
+    for j in 0..rank-1 do halo(j) = i;
+    if debug then writeln("Testing domain ", dom, " with halo ", halo);
+
+    var Space = dom dmapped Stencil(dom, fluff=halo, periodic=true);
+    var A : [Space] int;
+    const n = dom.dim(0).size;
+
+    // Update more than once to make sure the flags are reset
+    for iteration in 1..3 {
+      forall idx in Space {
+        var val = iteration;
+        for i in 0..rank-1 do val += n*idx(i)*(10**i);
+        A[idx] = val;
+      }
+
+      A.startFluffUpdate();
+      A.finishFluffUpdate();
+      verifyStencil(A, debug);
+    }
+  }
+}
+
+test({1..10, 1..10});
+test({-3..11, -3..11});
+test({1..10, 1..10, 1..10});
+test({-10..#30, -10..#30, -10..#30} by 3);
+test({-10..1, 5..24, 0..10} by 2);
+
+// Overlap the computation on the interior of each locale's block with the
+// update, and compare against a non-distributed computation.
+{
+  const Dom = {1..32, 1..32};
+  const Space = Dom dmapped Stencil(Dom, fluff=(1,1), periodic=true);
+  var A, B : [Space] real;
+  forall (i, j) in Space do A[i,j] = i * 100 + j;
+
+  var C : [0..33, 0..33] real;
+  forall (i, j) in Dom do C[i,j] = i * 100 + j;
+
+  for 1..3 {
+    A.startFluffUpdate();
+    forall (i, j) in Space {
+      if Space.localSubdomain().expand(-1, -1).contains((i, j)) then
+        B[i,j] = (A[i-1,j] + A[i+1,j] + A[i,j-1] + A[i,j+1]) / 4;
+    }
+    A.finishFluffUpdate();
+    forall (i, j) in Space {
+      if !Space.localSubdomain().expand(-1, -1).contains((i, j)) then
+        B[i,j] = (A[i-1,j] + A[i+1,j] + A[i,j-1] + A[i,j+1]) / 4;
+    }
+    A = B;
+
+    C[0, 1..32] = C[32, 1..32];
+    C[33, 1..32] = C[1, 1..32];
+    C[1..32, 0] = C[1..32, 32];
+    C[1..32, 33] = C[1..32, 1];
+    var D : [Dom] real;
+    forall (i, j) in Dom do D[i,j] = (C[i-1,j] + C[i+1,j] + C[i,j-1] + C[i,j+1]) / 4;
+    C[Dom] = D;
+  }
+
+  if || reduce [(i, j) in Dom] (A[i,j] != C[i,j]) then
+    halt("Mismatch between overlapped and non-distributed stencil");
+}
+
+writeln("Success!");
@@ -0,0 +1,54 @@
+// Edge cases of the number conversions done when reading and writing:
+// the limits of the exact fast paths and what happens just past them.
+use IO, Math;
+
+proc readAs(type t, s: string) throws {
+  var f = openmem();
+  f.writer().write(s);
+  var x: t;
+  f.reader().read(x);
+  return x;
+}
+
+proc checkUint(s: string) {
+  try {
+    writeln(s, ": ", readAs(uint, s));
+  } catch {
+    writeln(s, ": error");
+  }
+}
+
+proc checkReal(s: string, expected: real) {
+  try {
+    const x = readAs(real, s);
+    writeln(s, ": ", x == expected && signbit(x) == signbit(expected));
+  } catch {
+    writeln(s, ": error");
+  }
+}
+
+checkUint("18446744073709551615");
+checkUint("18446744073709551616");
+checkUint("99999999999999999999999");
+checkUint("0");
+
+checkReal("9007199254740992", 9007199254740992.0);    // 2^53
+checkReal("9007199254740993", 9007199254740993.0);    // 2^53+1 rounds
+checkReal("1e22", 1e22);
+checkReal("1e23", 1e23);
+checkReal("1e30", 1e30);
+checkReal("0e-400", 0.0);
+checkReal("-0.0", -0.0);
+checkReal("1234567890123456789", 1234567890123456789.0);
+checkReal("12345678901234567890", 12345678901234567890.0);
+checkReal("0.1234567890123456789", 0.1234567890123456789);
+checkReal("1.2345678901234567890e-5", 1.2345678901234567890e-5);
+checkReal("123.456e-22", 123.456e-22);
+checkReal("4.9e-324", 4.9e-324);
+
+writeln(99999.0, " ", 100000.0, " ", -0.0, " ", 5.0);
+writef("%r %r %r\n", 99999.0, 100000.0, 5.0);
+writef("%dr %dr\n", 99999.0, 100000.0);
+writef("%.0dr %.0dr %.2dr\n", 99999.0, 100000.0, 5.0);
+writef("%.0r %.0r %.0r\n", 99999.0, 100000.0, 5.0);
+writef("%.3r %.5r %.6r\n", 99999.0, 99999.0, 123456.0);
@@ -0,0 +1,41 @@
+use AllLocalesCollectives;
+
+const n = numLocales;
+var ok: [LocaleSpace] bool;
+
+coforall loc in Locales with (ref ok) do on loc {
+  const me = here.id;
+  var good = true;
+
+  // reductions of scalars and arrays
+  good &&= allLocalesReduce(me, ReduceOp.Sum) == n * (n - 1) / 2;
+  good &&= allLocalesReduce(me: real, ReduceOp.Max) == (n - 1): real;
+  good &&= allLocalesReduce((1 << me): uint(32), ReduceOp.BitOr)
+           == ((1 << n) - 1): uint(32);
+
+  var A: [1..5] int = [i in 1..5] i * me;
+  allLocalesReduce(A, ReduceOp.Sum);
+  for i in 1..5 do good &&= A[i] == i * n * (n - 1) / 2;
+
+  // broadcasts from the first and last locales
+  var x = if me == 0 then 42 else -1;
+  allLocalesBroadcast(x);
+  good &&= x == 42;
+
+  var B: [0..3] real;
+  if me == n - 1 then B = [1.5, 2.5, 3.5, 4.5];
+  allLocalesBroadcast(B, root=n - 1);
+  good &&= B.equals([1.5, 2.5, 3.5, 4.5]);
+
+  // gather and all-to-all
+  const G = allLocalesGather((me, me * me));
+  for i in 0..#n do good &&= G[i] == (i, i * i);
+
+  const src = [j in 0..#n] 100 * me + j;
+  const dst = allLocalesAlltoall(src);
+  for i in 0..#n do good &&= dst[i] == 100 * i + me;
+
+  ok[me] = good;
+}
+
+writeln(&& reduce ok);
@@ -0,0 +1,45 @@
+// Collectives moving more data than fits in one exchange step, on a
+// number of locales that is not a power of 2.
+use AllLocalesCollectives;
+
+config const m = 10000;   // elements; much larger than one exchange step
+param k = 3000;           // tuple elements gathered from each locale
+
+const n = numLocales;
+var ok: [LocaleSpace] bool;
+
+coforall loc in Locales with (ref ok) do on loc {
+  const me = here.id;
+  var good = true;
+
+  // broadcast of a large array from a locale past the largest power of 2
+  var B: [1..m] int;
+  if me == n - 1 then B = [i in 1..m] i * 3;
+  allLocalesBroadcast(B, root=n - 1);
+  for i in 1..m do good &&= B[i] == i * 3;
+
+  // elementwise reduction of a large array
+  var A: [1..m] int = [i in 1..m] i + me;
+  allLocalesReduce(A, ReduceOp.Sum);
+  for i in 1..m do good &&= A[i] == i * n + n * (n - 1) / 2;
+
+  var R: [1..m] real = [i in 1..m] (i % (me + 2)): real;
+  allLocalesReduce(R, ReduceOp.Max);
+  for i in 1..m do
+    good &&= R[i] == (max reduce [l in 0..#n] i % (l + 2)): real;
+
+  // gather of a value that is larger than one exchange step by itself
+  var t: k*int;
+  for j in 0..#k do t(j) = me * k + j;
+  const G = allLocalesGather(t);
+  for i in 0..#n do
+    for j in 0..#k do good &&= G[i](j) == i * k + j;
+
+  // scalars still work after the large exchanges
+  good &&= allLocalesReduce(me, ReduceOp.Sum) == n * (n - 1) / 2;
+  good &&= allLocalesReduce(1 << me, ReduceOp.BitXor) == (1 << n) - 1;
+
+  ok[me] = good;
+}
+
+writeln(&& reduce ok);
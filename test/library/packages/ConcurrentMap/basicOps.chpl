@@ -0,0 +1,26 @@
+use ConcurrentMap;
+
+record setTo {
+  var x: int;
+  proc this(k, ref v) { v = x; return k; }
+}
+
+var m = new ConcurrentMap(string, int);
+
+writeln(m.isEmpty());
+writeln(m.add("one", 1));
+writeln(m.add("one", 10));
+writeln(m.getValue("one"));
+writeln(m.set("two", 2));
+m.addOrSet("two", 2);
+writeln(m.set("two", 20));
+writeln(m.getValue("two"));
+writeln(m.update("two", new setTo(22)));
+writeln(m.getValue("two"));
+writeln(m.tryGetValue("three"));
+writeln(m.contains("two"), " ", m.contains("three"));
+writeln(m.size);
+writeln(m.remove("one"), " ", m.remove("one"));
+writeln(m);
+m.clearAll();
+writeln(m.size, " ", m);
@@ -0,0 +1,34 @@
+use ConcurrentMap;
+
+config const n = 100000;
+config const numBins = 1000;
+
+record inc {
+  proc this(k, ref v) { v += 1; }
+}
+
+// histogram built from a forall
+var hist = new ConcurrentMap(int, int);
+forall i in 1..n do
+  hist.addOrUpdate(i % numBins, 1, new inc());
+
+writeln(hist.size == numBins);
+writeln(+ reduce hist.values() == n);
+writeln(&& reduce [b in 0..#numBins] hist.getValue(b) == n / numBins);
+
+// bulk insertion, including keys that are already present
+var squares = new ConcurrentMap(int, int, numSegments=3);
+var sq: [1..n] int = [i in 1..n] i*i;
+var pairs: [1..2*n] (int, int) = [i in 1..2*n] (i, -1);
+writeln(squares.addAll(1..n, sq) == n);
+writeln(squares.addAll(pairs) == n);
+writeln(squares.size == 2*n);
+writeln(&& reduce [(k, v) in squares.items()] (if k <= n then v == k*k
+                                               else v == -1));
+
+// concurrent removal and lookup
+forall i in 1..2*n by 2 do
+  squares.remove(i);
+writeln(squares.size == n);
+writeln((+ reduce [k in squares] k % 2) == 0);
+writeln(&& reduce [i in 1..2*n] squares.contains(i) == (i % 2 == 0));
@@ -17,11 +17,15 @@ use DistributedIters;
 
   - ``guided``
     The distributed guided load-balancing iterator.
+
+  - ``adaptive``
+    The distributed adaptive work-stealing iterator.
 */
 enum iterator
 {
   dynamic,
-  guided
+  guided,
+  adaptive
 };
 
 /*
@@ -95,6 +99,8 @@ proc testIteratorSerial(c)
                              do array[i] = (array[i] + 1);
     when iterator.guided do for i in distributedGuided(c)
                             do array[i] = (array[i] + 1);
+    when iterator.adaptive do for i in distributedAdaptive(c)
+                              do array[i] = (array[i] + 1);
   }
   checkCorrectness(array, c);
 }
@@ -123,6 +129,14 @@ proc testIteratorZippered(array,
                           base # target.size)
       do array[i,j] = (array[i,j] + 1);
     }
+    when iterator.adaptive
+    {
+      // There is no coordinating locale to exclude from the work.
+      forall (i,j) in zip(distributedAdaptive(target,
+                                              workerLocales=workerLocales),
+                          base # target.size)
+      do array[i,j] = (array[i,j] + 1);
+    }
   }
   checkCorrectnessZippered(array, target, base);
 }
@@ -0,0 +1,50 @@
+use Sort, BlockDist, CyclicDist, Random;
+
+config const n = 10000;
+
+record Pair {
+  var key: int;
+  var name: string;
+}
+
+record PairComparator {
+  proc key(p: Pair) return p.key;
+}
+
+// Sorts a distributed copy and a local copy of 'Input', and checks that
+// they match.
+proc check(Input: [] ?t, D, comparator, desc: string) {
+  var A: [D] t = Input;
+  var B: [0..#Input.size] t = Input;
+  sort(A, comparator);
+  sort(B, comparator);
+  var matches = true;
+  forall (a, b) in zip(A, B) with (&& reduce matches) do
+    matches &&= chpl_compare(a, b, comparator) == 0;
+  writeln(desc, ": ", matches && isSorted(A, comparator));
+}
+
+var Ints: [0..#n] int;
+fillRandom(Ints, 17);
+
+const BlockD = newBlockDom({0..#n});
+const CyclicD = newCyclicDom({1..n});
+
+check(Ints, BlockD, defaultComparator, "block ints");
+check(Ints, CyclicD, defaultComparator, "cyclic ints");
+check(Ints, BlockD, reverseComparator, "block ints reversed");
+
+var Few: [0..#n] int = Ints % 3;
+check(Few, BlockD, defaultComparator, "block duplicates");
+
+var Same: [0..#n] int = 42;
+check(Same, CyclicD, defaultComparator, "cyclic all equal");
+
+var Strs = [i in Ints] (i % 1000):string;
+check(Strs, BlockD, defaultComparator, "block strings");
+
+var Pairs = [(i, j) in zip(Ints, 0..)] new Pair(i % 100, j:string);
+check(Pairs, CyclicD, new PairComparator(), "cyclic records");
+
+var Small: [0..#3] int = [3, 1, 2];
+check(Small, newBlockDom({0..#3}), defaultComparator, "block small");
@@ -0,0 +1,44 @@
+use Sort, Random;
+
+config const n = 100000;
+
+// Sorts with lsbRadixSort and with quickSort, and checks that the results
+// match if lsbRadixSort sorted the keys. Keys are limited to a small
+// range so that it does. Real keys span many exponents and both signs, but
+// only use the top bits of the mantissa.
+proc check(type t, comparator, mask: int, desc: string) {
+  var Keys: [0..#n] int;
+  fillRandom(Keys, 11);
+
+  var A: [0..#n] t;
+  forall (a, k) in zip(A, Keys) {
+    const v = k & mask;
+    if isTupleType(t) then
+      a = (v % 7, v - mask/2):t;
+    else if isRealType(t) then
+      a = (v - mask/2):t / 8.0;
+    else if isIntType(t) then
+      a = (v - mask/2):t;
+    else
+      a = v:t;
+  }
+
+  var B = A;
+  const used = LSBRadixSort.lsbRadixSort(A, comparator);
+  QuickSort.quickSort(B, comparator=comparator);
+  writeln(desc, ": ", used, " ", !used || && reduce (A == B));
+}
+
+check(int, defaultComparator, 0xfffff, "int");
+check(int, reverseComparator, 0xfffff, "int reversed");
+check(uint, defaultComparator, 0xffff, "uint");
+check(int(32), defaultComparator, max(int(32)), "int(32)");
+check(uint(8), defaultComparator, 0xff, "uint(8)");
+check(real, defaultComparator, 0xfff, "real");
+check(real, reverseComparator, 0xfff, "real reversed");
+check(2*int, defaultComparator, 0xff, "2*int");
+
+// Keys that vary in every digit are left to msbRadixSort
+var Random64: [0..#n] int;
+fillRandom(Random64, 13);
+writeln("random int: ", LSBRadixSort.lsbRadixSort(Random64, defaultComparator));
@@ -0,0 +1,21 @@
+use Memory.Arenas;
+
+// Assigning one arena to another releases the target's own arena and
+// makes it refer to (but not own) the source's, so each arena is
+// destroyed exactly once.
+for trial in 1..3 {
+  var a = new arena();
+  var b = new arena();
+  b = a;
+  const p = b.alloc(int, 10);
+  for i in 0..#10 do p[i] = i * trial;
+  writeln(+ reduce [i in 0..#10] p[i]);
+}
+
+// Arenas created after those are gone are independent of each other.
+var c = new arena(), d = new arena();
+const x = c.alloc(int, 1), y = d.alloc(int, 1);
+x[0] = 1;
+y[0] = 2;
+d.reset();
+writeln(x[0]);
@@ -0,0 +1,41 @@
+use Memory.Arenas, CPtr, SysCTypes;
+
+config const n = 1000;
+
+var a = new arena();
+
+// allocations of different types and alignments stay usable together
+const ints = a.alloc(int, n);
+const reals = a.alloc(real, n, alignment=64);
+for i in 0..#n {
+  ints[i] = i;
+  reals[i] = i / 2.0;
+}
+writeln(+ reduce [i in 0..#n] ints[i]);
+writef("%.1dr\n", + reduce [i in 0..#n] reals[i]);
+writeln((reals: c_uintptr) % 64 == 0);
+
+// tasks may allocate from the same arena at once
+var total: atomic int;
+coforall tid in 0..#4 with (ref a) {
+  const p = a.alloc(int, n);
+  for i in 0..#n do p[i] = tid;
+  var sum = 0;
+  for i in 0..#n do sum += p[i];
+  total.add(sum);
+}
+writeln(total.read());
+
+// the arena can be reused after a reset
+for phase in 1..3 {
+  const p = a.alloc(uint(8), 1 << 21);
+  p[(1 << 21) - 1] = phase: uint(8);
+  writeln(p[(1 << 21) - 1]);
+  a.reset();
+}
+
+// a copy refers to the same arena
+var b = a;
+const q = b.alloc(int, 1);
+q[0] = 42;
+writeln(q[0]);
@@ -0,0 +1,88 @@
+// Checks for the Philox4x32-10 counter-based RNG.
+use Random, BlockDist;
+
+config const n = 1000;
+
+// Random123 known-answer test: counter 0, key 0
+{
+  var rs = createRandomStream(seed=0, parSafe=false, eltType=uint(32),
+                              algorithm=RNG.Philox);
+  const expect = [0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8]:uint(32);
+  for e in expect do
+    assert(rs.getNext() == e);
+  writeln("known answer: ok");
+
+  // the second block of a stream seeded with 42
+  rs = createRandomStream(seed=42, parSafe=false, eltType=uint(32),
+                          algorithm=RNG.Philox);
+  const expect42 = [0xfcdb2127, 0x53ba6cfd, 0x838f5a6e, 0x744e06fb]:uint(32);
+  for (e, i) in zip(expect42, 4..) do
+    assert(rs.getNth(i) == e);
+  writeln("skip ahead: ok");
+}
+
+// Random access and parallel fills match the serial stream
+proc check(type t, D) {
+  var rs = createRandomStream(seed=17, parSafe=false, eltType=t,
+                              algorithm=RNG.Philox);
+  var expected: [0..#D.size] t;
+  for s in expected do s = rs.getNext();
+
+  for i in 0..#D.size by -7 do
+    assert(rs.getNth(i) == expected[i]);
+
+  var A: [D] t;
+  fillRandom(A, seed=17, algorithm=RNG.Philox);
+  for (a, s) in zip(A, expected) do
+    assert(a == s);
+
+  writeln(t:string, " ", D.rank, "D fill: ok");
+}
+
+proc checkAll(type t) {
+  check(t, {1..n});
+  check(t, {1..n by 3});
+  check(t, {1..37, 1..23});
+  check(t, {1..n} dmapped Block({1..n}));
+}
+
+checkAll(uint(8));
+checkAll(int(32));
+checkAll(int);
+checkAll(real(32));
+checkAll(real);
+checkAll(complex);
+
+// Bounded values are in range and only depend on their position
+{
+  var rs = createRandomStream(seed=5, parSafe=false, eltType=int,
+                              algorithm=RNG.Philox);
+  var vals: [0..#n] int;
+  for v in vals {
+    v = rs.getNext(-3, 11);
+    assert(-3 <= v && v <= 11);
+  }
+  rs.skipToNth(n/2);
+  for i in n/2..#10 do
+    assert(rs.getNext(-3, 11) == vals[i]);
+
+  var r = rs.getNext(resultType=real, 2.0, 4.0);
+  assert(2.0 <= r && r <= 4.0);
+  writeln("bounded: ok");
+}
+
+// Shuffles and permutations
+{
+  var A: [1..n] int = 1..n;
+  shuffle(A, seed=3, algorithm=RNG.Philox);
+  var P: [1..n] int;
+  permutation(P, seed=3, algorithm=RNG.Philox);
+  var seenA, seenP: [1..n] int;
+  for (a, p) in zip(A, P) {
+    seenA[a] += 1;
+    seenP[p] += 1;
+  }
+  assert(&& reduce (seenA == 1));
+  assert(&& reduce (seenP == 1));
+  writeln("shuffle and permutation: ok");
+}
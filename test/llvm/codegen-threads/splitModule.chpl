@@ -0,0 +1,54 @@
+// A program with enough functions, globals, and generic instantiations
+// that splitting it into several partitions puts callers and callees,
+// and globals and their users, in different object files. The output
+// must be the same however many threads generate the code.
+config const n = 1000;
+
+var counter = 0;
+const table = [i in 1..16] i * i;
+
+class Shape {
+  proc area(): real { return 0.0; }
+  proc name(): string { return "shape"; }
+}
+class Square: Shape {
+  var side: real;
+  override proc area(): real { return side * side; }
+  override proc name(): string { return "square"; }
+}
+class Circle: Shape {
+  var r: real;
+  override proc area(): real { return 3.0 * r * r; }
+  override proc name(): string { return "circle"; }
+}
+
+record Pair {
+  type t;
+  var a, b: t;
+  proc sum() { counter += 1; return a + b; }
+}
+
+proc fib(k: int): int {
+  return if k < 2 then k else fib(k-1) + fib(k-2);
+}
+
+proc reduceWith(type t, x: t) {
+  var p = new Pair(t, x, x);
+  var s: t;
+  for i in 1..n do s += p.sum() / (2: t);
+  return s;
+}
+
+var shapes: [1..4] owned Shape?;
+shapes[1] = new Square(2.0);
+shapes[2] = new Circle(1.0);
+shapes[3] = new Square(0.5);
+shapes[4] = new Circle(3.0);
+for s in shapes do writeln(s!.name(), " ", s!.area());
+
+writeln(fib(20));
+writeln(reduceWith(int, 3));
+writeln(reduceWith(real, 1.5));
+writeln(reduceWith(uint(8), 1));
+writeln(+ reduce table, " ", counter);
+writeln(+ reduce [i in 1..n] (i % 7) * table[i % 16 + 1]);
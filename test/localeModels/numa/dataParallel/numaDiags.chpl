@@ -0,0 +1,25 @@
+use Memory.Diagnostics;
+
+config const n = 1 << 22;
+
+const numSublocs = here.getChildCount();
+
+var A: [1..n] real;
+
+// Each sublocale's forall chunk covers the part of the array whose pages
+// were placed on that sublocale, so every sampled access is local.
+resetNumaDiagnostics();
+startNumaDiagnostics();
+forall a in A do a += 1.0;
+stopNumaDiagnostics();
+writeln(numaRemoteFraction() == 0.0);
+
+// Running the whole forall from one sublocale makes the accesses to the
+// other sublocales' parts remote.  This also shows samples were taken.
+resetNumaDiagnostics();
+startNumaDiagnostics();
+on here.getChild(0) do forall a in A do a += 1.0;
+stopNumaDiagnostics();
+writeln(numSublocs < 2 || numaRemoteFraction() > 0.0);
+
+writeln(+ reduce A == 2 * n);
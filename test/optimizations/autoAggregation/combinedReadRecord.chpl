@@ -0,0 +1,39 @@
+use BlockDist;
+
+var copies, deinits: atomic int;
+
+record R {
+  var x: int;
+  proc init() { }
+  proc init(x: int) { this.x = x; }
+  proc init=(other: R) {
+    this.x = other.x;
+    copies.add(1);
+  }
+  proc deinit() {
+    deinits.add(1);
+  }
+}
+
+proc =(ref lhs: R, rhs: R) {
+  lhs.x = rhs.x;
+}
+
+var dom = newBlockDom(0..10);
+var a: [dom] R;
+var b: [dom] R;
+
+for i in dom do b[i] = new R(i);
+
+copies.write(0);
+deinits.write(0);
+
+writeln("Loop 1 -- expecting no aggregation for a read of a record");
+forall i in dom {
+  var x = b[10-i];
+  a[i] = x;
+}
+writeln("End Loop 1");
+
+writeln(a.x);
+writeln("copies: ", copies.read(), " deinits: ", deinits.read());
@@ -0,0 +1,63 @@
+writeln();
+
+use BlockDist;
+
+var dom = newBlockDom(0..10);
+var a: [dom] int;
+var b: [dom] int;
+var c: [dom] int;
+
+for i in dom do a[i] = i;
+
+writeln("Loop 1 -- expecting source aggregation in a non-final statement");
+forall i in dom {
+  b[i] = a[10-i];
+  c[i] = i;
+}
+writeln("End Loop 1");
+
+writeln(b);
+writeln(c);
+writeln();
+
+writeln("Loop 2 -- expecting destination aggregation in a non-final statement");
+forall i in dom {
+  b[10-i] = a[i];
+  c[i] = 2*i;
+}
+writeln("End Loop 2");
+
+writeln(b);
+writeln(c);
+writeln();
+
+writeln("Loop 3 -- expecting source aggregation only in the final statement");
+forall i in dom {
+  b[10-i] = a[i];  // the next statement reads b, so this can't be deferred
+  c[i] = b[10-i];
+}
+writeln("End Loop 3");
+
+writeln(b);
+writeln(c);
+writeln();
+
+writeln("Loop 4 -- expecting destination aggregation for the update");
+c = 0;
+forall i in dom {
+  c[10-i] += a[i];  // each element is updated once, by one task
+}
+writeln("End Loop 4");
+
+writeln(c);
+writeln();
+
+writeln("Loop 5 -- expecting source aggregation after combining the read");
+forall i in dom {
+  const x = a[10-i];
+  b[i] = x;
+}
+writeln("End Loop 5");
+
+writeln(b);
+writeln();
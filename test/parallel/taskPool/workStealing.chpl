@@ -0,0 +1,53 @@
+// Exercise the ways tasks can be created and started: begins that go on
+// the creating thread's queue, coforall tasks that their parent may run
+// itself or that other threads may take, nested task creation, and more
+// tasks than fit on one thread's queue.
+config const n = 5000;
+
+var count: atomic int;
+
+coforall i in 1..n do count.add(1);
+writeln(count.read());
+
+count.write(0);
+sync {
+  for i in 1..n do begin {
+    count.add(1);
+    begin count.add(1);
+  }
+}
+writeln(count.read());
+
+count.write(0);
+coforall i in 1..8 {
+  coforall j in 1..n/8 do count.add(1);
+  forall k in 1..n do count.add(1);
+}
+writeln(count.read());
+
+var s$: sync int;
+begin s$.writeEF(42);
+writeln(s$.readFE());
+
+// Every task runs exactly once, even though coforall tasks can be
+// taken both from their creator's queue and from the task list.
+var ran: [1..n] atomic int;
+coforall i in 1..n do ran[i].add(1);
+sync {
+  for i in 1..n do begin ran[i].add(1);
+}
+writeln(&& reduce [r in ran] r.read() == 2);
+
+// Tasks begun by a task go on its thread's queue.  Make them wait for
+// each other, so they can only all finish if other threads steal them.
+const k = min(here.maxTaskPar, 4);
+var started: atomic int;
+if k >= 2 {
+  sync begin {
+    for 1..k do begin {
+      started.add(1);
+      started.waitFor(k);
+    }
+  }
+}
+writeln(k < 2 || started.read() == k);
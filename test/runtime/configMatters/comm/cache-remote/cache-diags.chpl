@@ -0,0 +1,26 @@
+// Check that the remote cache's detailed comm diagnostics are consistent:
+// readahead that is used must have been issued, write-behind puts carry
+// bytes, and acquire fences at the start of 'on' bodies are counted.
+use CommDiagnostics;
+
+config const n = 100000;
+
+var A: [1..n] int;
+
+startCommDiagnostics();
+on Locales[1] {
+  var sum = 0;
+  for i in 1..n do sum += A[i];
+  for i in 1..n do A[i] = i;
+  assert(sum == 0);
+}
+stopCommDiagnostics();
+
+const d = getCommDiagnostics()[1];
+assert(d.cache_readahead_issued > 0);
+assert(d.cache_readahead_used > 0);
+assert(d.cache_readahead_used <= d.cache_readahead_issued);
+assert(d.cache_write_behind_puts > 0);
+assert(d.cache_write_behind_bytes >= n * numBytes(int));
+assert(d.cache_start_invalidations > 0);
+writeln("OK");
@@ -0,0 +1,41 @@
+// Exercise the shared per-locale cache (CHPL_RT_CACHE_SHARED=true):
+// many tasks on one locale read and write the same remote pages,
+// and acquire/release fences still order them correctly.
+config const n = 100000;
+
+proc doit(memory:locale, running:locale) {
+  on memory {
+    var A:[1..n] int;
+    var go: atomic int;
+    on running {
+      forall i in 1..n {
+        A[i] = i;
+      }
+      // every task reads every element; each page should be
+      // fetched through the same shard
+      coforall tid in 0..#here.maxTaskPar {
+        var sum = 0;
+        for i in 1..n do sum += A[i];
+        assert(sum == n*(n+1)/2);
+      }
+      // release from one task, acquire in the others
+      cobegin {
+        {
+          for i in 1..n do A[i] = -i;
+          go.write(1, memoryOrder.release);
+        }
+        {
+          go.waitFor(1, memoryOrder.acquire);
+          for i in 1..n do assert(A[i] == -i);
+        }
+      }
+    }
+    for i in 1..n {
+      assert(A[i] == -i);
+    }
+  }
+}
+
+doit(Locales[1], Locales[0]);
+doit(Locales[0], Locales[1]);
+writeln("OK");
@@ -0,0 +1,39 @@
+// Column sweeps over a remote 2D array (forward and backward) are
+// strided streams for the remote cache; check that the values read
+// through the stride prefetcher are correct, including after a remote
+// update that is published with a release/acquire pair.
+config const n = 200;
+
+on Locales[1] {
+  var A: [1..n, 1..n] int;
+  var flag: atomic int;
+
+  forall (i, j) in A.domain do A[i, j] = i*n + j;
+
+  on Locales[0] {
+    for j in 1..n {
+      for i in 1..n do assert(A[i, j] == i*n + j);
+      for i in 1..n by -1 do assert(A[i, j] == i*n + j);
+    }
+  }
+
+  // interleave two streams with different strides
+  on Locales[0] {
+    for i in 1..n {
+      assert(A[i, 1] == i*n + 1);
+      assert(A[n-i+1, n] == (n-i+1)*n + n);
+    }
+  }
+
+  // read column 1 ahead, update it remotely, then re-read it
+  on Locales[0] {
+    for i in 1..n/2 do assert(A[i, 1] == i*n + 1);
+    on Locales[1] {
+      for i in 1..n do A[i, 1] = -i;
+      flag.write(1, memoryOrder.release);
+    }
+    flag.waitFor(1, memoryOrder.acquire);
+    for i in 1..n do assert(A[i, 1] == -i);
+  }
+}
+writeln("OK");
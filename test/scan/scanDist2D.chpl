@@ -0,0 +1,40 @@
+// Multi-locale scans of multidimensional Block and Cyclic arrays give the
+// serial result, and a Block scan moves its elements in bulk rather than
+// one at a time.
+use BlockDist, CyclicDist, CommDiagnostics;
+
+config const n = 200, m = 150;
+
+proc test(name, D) {
+  var A: [D] int;
+  var expected: [0..#D.size] int, k = 0, sum = 0;
+  for (a, e) in zip(A, expected) {
+    a = (k * 7919) % 11 - 5;
+    k += 1;
+    sum += a;
+    e = sum;
+  }
+
+  resetCommDiagnostics();
+  startCommDiagnostics();
+  const S = + scan A;
+  stopCommDiagnostics();
+
+  var ok = S.domain == D;
+  for (s, e) in zip(S, expected) do
+    if s != e then ok = false;
+  writeln(name, ": ", ok);
+
+  var numComms: uint;
+  for c in getCommDiagnostics() do
+    numComms += c.get + c.get_nb + c.put + c.put_nb;
+  return numComms;
+}
+
+const BD = {1..n, 1..m} dmapped Block({1..n, 1..m});
+const blockComms = test("Block 2D", BD);
+writeln("Block 2D bulk: ", blockComms < (BD.size / 10): uint);
+
+test("Block 2D strided", {1..n by 3, 1..m by -2} dmapped Block({1..n, 1..m}));
+test("Cyclic 2D", {1..n, 1..m} dmapped Cyclic(startIdx=(1,1)));
+test("Block 3D", {1..20, 1..30, 1..7} dmapped Block({1..20, 1..30, 1..7}));
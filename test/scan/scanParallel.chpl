@@ -0,0 +1,62 @@
+// Scans that used to be serialized: promoted expressions, zippered
+// operands, ranges, domains, multidimensional arrays and Cyclic arrays.
+use BlockDist, CyclicDist;
+
+config const n = 1000;
+
+proc check(msg, X, Y) {
+  const FX = for x in X do x, FY = for y in Y do y;
+  if FX.size != FY.size then
+    halt(msg, ": size mismatch");
+  for (x, y) in zip(FX, FY) do
+    if x != y then
+      halt(msg, ": ", x, " != ", y);
+  writeln(msg, ": ok");
+}
+
+// the serial definition of a scan, for comparison
+proc serialSum(X) {
+  const FX = for x in X do x;
+  var R: [FX.domain] int, sum = 0;
+  for (x, r) in zip(FX, R) {
+    sum += x;
+    r = sum;
+  }
+  return R;
+}
+
+proc test(name, D) {
+  var A: [D] int;
+  var i = 0;
+  for a in A { a = (i * 7919) % 13 - 6; i += 1; }
+
+  const S = + scan (A > 0);
+  check(name + " promoted", S, serialSum(A > 0:int));
+  if S.domain != D then halt("result domain mismatch");
+
+  check(name + " array", + scan A, serialSum(A));
+
+  const Z = + scan zip(A, A);
+  check(name + " zippered", [z in Z] z(0) + z(1), serialSum(2 * A));
+
+  const M = maxloc scan zip(A, A.domain);
+  var mx = min(int);
+  for (m, a) in zip(M, A) {
+    mx = max(mx, a);
+    if m(0) != mx || A[m(1)] != mx then halt("maxloc scan mismatch");
+  }
+  writeln(name + " maxloc: ok");
+}
+
+test("1D", {1..n});
+test("1D negative stride", {1..n by -3});
+test("2D", {1..37, 1..23});
+test("3D strided", {1..37 by 2, 1..23 by -3, 0..3});
+test("Block 1D", {1..n} dmapped Block({1..n}));
+test("Block 2D", {1..37, 1..23} dmapped Block({1..37, 1..23}));
+test("Cyclic 1D", {1..n} dmapped Cyclic(startIdx=1));
+test("Cyclic 1D negative stride", {1..n by -3} dmapped Cyclic(startIdx=1));
+test("Cyclic 2D", {1..37, 1..23} dmapped Cyclic(startIdx=(1,1)));
+
+check("range", + scan (1..n), serialSum(1..n));
+check("domain", + scan {1..n}, serialSum(1..n));
@@ -0,0 +1,45 @@
+use ChapelHashtable;
+
+// Slide a window of keys through a table. Removing keys should not make
+// the table grow or fill up with deleted slots.
+
+config const window = 1000, steps = 100000;
+
+var ht = new chpl__hashtable(int, int);
+
+proc add(k: int) {
+  var (found, slot) = ht.findAvailableSlot(k);
+  assert(!found);
+  ht.fillSlot(slot, k, -k);
+}
+
+proc remove(k: int) {
+  var (found, slot) = ht.findFullSlot(k);
+  assert(found);
+  var key, val: int;
+  ht.clearSlot(slot, key, val);
+  assert(key == k && val == -k);
+}
+
+for k in 0..#window do add(k);
+const initialSize = ht.tableSize;
+
+var maxDeleted = 0;
+for k in window..#steps {
+  remove(k - window);
+  add(k);
+  maxDeleted = max(maxDeleted, ht.tableNumDeletedSlots);
+}
+
+writeln(ht.tableNumFullSlots);
+writeln(ht.tableSize == initialSize);
+writeln(maxDeleted < ht.tableSize / 2);
+
+for k in steps..#window {
+  var (found, slot) = ht.findFullSlot(k);
+  assert(found && ht.table[slot].val == -k);
+}
+for k in 0..#steps {
+  var (found, _) = ht.findFullSlot(k);
+  assert(!found);
+}
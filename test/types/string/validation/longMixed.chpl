@@ -0,0 +1,37 @@
+// Checks validation and codepoint counts for non-ASCII and invalid bytes at
+// every position in strings long enough to cross the vectorized ASCII scan.
+
+proc validate(b: bytes) throws {
+  return createStringWithBorrowedBuffer(b.c_str(), b.numBytes);
+}
+
+for len in 1..70 {
+  for pos in 0..<len {
+    var asciiPart = "a" * pos;
+    var rest = "b" * (len - pos - 1);
+
+    // valid: a 2-byte codepoint in the middle of ASCII
+    var valid = (asciiPart + "é" + rest):bytes;
+    var s = validate(valid);
+    if s.size != len || s.numBytes != len + 1 then
+      writeln("wrong count for len ", len, " pos ", pos, ": ", s.size);
+
+    // invalid: a lone continuation byte in the middle of ASCII
+    var invalid = asciiPart:bytes + b"\x80" + rest:bytes;
+    try {
+      validate(invalid);
+      writeln("no error for len ", len, " pos ", pos);
+    } catch e: DecodeError {
+    } catch {
+      writeln("unexpected error for len ", len, " pos ", pos);
+    }
+
+    // escaped: the invalid byte survives as an escaped codepoint
+    var escaped = invalid.decode(policy=decodePolicy.escape);
+    var roundTrip = createStringWithBorrowedBuffer(escaped.c_str(),
+                                                   escaped.numBytes);
+    if roundTrip.size != len then
+      writeln("wrong escaped count for len ", len, " pos ", pos);
+  }
+}
+writeln("done");
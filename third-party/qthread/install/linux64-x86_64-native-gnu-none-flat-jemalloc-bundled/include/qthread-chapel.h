@@ -0,0 +1,3 @@
+#define CHPL_QTHREAD_SCHEDULER_ONE_WORKER_PER_SHEPHERD 1
+#define CHPL_QTHREAD_TASKS_CAN_MIGRATE_THREADS 0
+#define CHPL_QTHREAD_HAVE_GUARD_PAGES 1
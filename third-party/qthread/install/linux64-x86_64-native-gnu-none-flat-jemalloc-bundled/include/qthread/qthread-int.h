@@ -0,0 +1,9 @@
+#ifndef _QTHREAD_INCLUDE_QTHREAD_QTHREAD_INT_H
+#define _QTHREAD_INCLUDE_QTHREAD_QTHREAD_INT_H 1
+#ifndef _GENERATED_STDINT_H
+#define _GENERATED_STDINT_H "qthread 1.15"
+/* generated using gnu compiler gcc (Debian 12.2.0-14+deb12u1) 12.2.0 */
+#define _STDINT_HAVE_STDINT_H 1
+#include <stdint.h>
+#endif
+#endif